@@ -27,8 +27,13 @@ AChatCommandSubsystem* AChatCommandSubsystem::Get(UObject* WorldContext) {
 }
 
 AChatCommandInstance* AChatCommandSubsystem::FindCommandByName(const FString& Name) {
-	AChatCommandInstance** ChatCommandInstance = CommandByNameMap.Find(Name);
-	return ChatCommandInstance ? *ChatCommandInstance : NULL;
+	return CommandNameTrie.Find(Name);
+}
+
+TArray<FString> AChatCommandSubsystem::GetCommandCompletions(const FString& Prefix, int32 MaxResults) const {
+	TArray<FString> Completions;
+	CommandNameTrie.FindCompletions(Prefix, MaxResults, Completions);
+	return Completions;
 }
 
 TArray<AChatCommandInstance*> AChatCommandSubsystem::GetRegisteredCommands() const {
@@ -76,7 +81,7 @@ void AChatCommandSubsystem::RegisterCommand(const FString& ModReference, TSubcla
 	AChatCommandInstance* CommandCDO = CommandClass->GetDefaultObject<AChatCommandInstance>();
 	const FString FqCommandName = MakeFQCommandName(ModReference, CommandCDO->CommandName);
 	//Only register command if it's not already registered
-	if (!CommandByNameMap.Contains(FqCommandName)) {
+	if (CommandNameTrie.Find(FqCommandName) == nullptr) {
 		const FString ActorName = FString::Printf(TEXT("ChatCommand_%s_%s"), *ModReference, *CommandCDO->CommandName);
 		//Spawn command actor with predefined name
 		FActorSpawnParameters SpawnParams;
@@ -86,15 +91,14 @@ void AChatCommandSubsystem::RegisterCommand(const FString& ModReference, TSubcla
 		//Make sure ModReference is set for spawned command actor
 		Command->ModReference = *ModReference;
 
-		//register all command aliases
-		TArray<FString> AllCommandNames;
-		AllCommandNames.Add(Command->CommandName);
-		AllCommandNames.Append(Command->Aliases);
-	
-		for (const FString& CommandAlias : AllCommandNames) {
-			const FString FqCommandAlias = MakeFQCommandName(ModReference, CommandAlias);
-			CommandByNameMap.Add(CommandAlias.ToLower(), Command);
-			CommandByNameMap.Add(FqCommandAlias.ToLower(), Command);
+		//register command name and all command aliases, ranking them for completion
+		CommandNameTrie.Add(Command->CommandName, Command, 0);
+		for (const FString& CommandAlias : Command->Aliases) {
+			CommandNameTrie.Add(CommandAlias, Command, 1);
+		}
+		CommandNameTrie.Add(FqCommandName, Command, 2);
+		for (const FString& CommandAlias : Command->Aliases) {
+			CommandNameTrie.Add(MakeFQCommandName(ModReference, CommandAlias), Command, 3);
 		}
 		//Add command actor to the registered actor list
 		RegisteredCommands.Add(Command);
@@ -0,0 +1,103 @@
+#include "Command/ChatCommandNameTrie.h"
+
+FChatCommandNameTrie::FChatCommandNameTrie() {
+	Empty();
+}
+
+void FChatCommandNameTrie::Empty() {
+	Nodes.Reset();
+	Entries.Reset();
+	Nodes.Add(FNode{{}, INDEX_NONE});
+}
+
+int32 FChatCommandNameTrie::FindChild(int32 NodeIndex, TCHAR Character, int32& OutInsertIndex) const {
+	const TArray<TPair<TCHAR, int32>>& Children = Nodes[NodeIndex].Children;
+	//Binary search for the first child with the character not less than the requested one
+	int32 Low = 0;
+	int32 High = Children.Num();
+	while (Low < High) {
+		const int32 Middle = (Low + High) / 2;
+		if (Children[Middle].Key < Character) {
+			Low = Middle + 1;
+		} else {
+			High = Middle;
+		}
+	}
+	OutInsertIndex = Low;
+	return Children.IsValidIndex(Low) && Children[Low].Key == Character ? Children[Low].Value : INDEX_NONE;
+}
+
+int32 FChatCommandNameTrie::FindNode(const FString& Name) const {
+	int32 NodeIndex = 0;
+	int32 InsertIndex;
+	for (const TCHAR Character : Name) {
+		NodeIndex = FindChild(NodeIndex, FChar::ToLower(Character), InsertIndex);
+		if (NodeIndex == INDEX_NONE) {
+			break;
+		}
+	}
+	return NodeIndex;
+}
+
+void FChatCommandNameTrie::Add(const FString& Name, AChatCommandInstance* Command, int32 Rank) {
+	int32 NodeIndex = 0;
+	for (const TCHAR Character : Name) {
+		const TCHAR FoldedCharacter = FChar::ToLower(Character);
+		int32 InsertIndex;
+		int32 ChildIndex = FindChild(NodeIndex, FoldedCharacter, InsertIndex);
+		if (ChildIndex == INDEX_NONE) {
+			ChildIndex = Nodes.Add(FNode{{}, INDEX_NONE});
+			Nodes[NodeIndex].Children.Insert(TPair<TCHAR, int32>(FoldedCharacter, ChildIndex), InsertIndex);
+		}
+		NodeIndex = ChildIndex;
+	}
+	FNode& Node = Nodes[NodeIndex];
+	if (Node.EntryIndex == INDEX_NONE) {
+		Node.EntryIndex = Entries.Add(FNameEntry{Name, Command, Rank});
+	} else {
+		Entries[Node.EntryIndex] = FNameEntry{Name, Command, Rank};
+	}
+}
+
+AChatCommandInstance* FChatCommandNameTrie::Find(const FString& Name) const {
+	const int32 NodeIndex = FindNode(Name);
+	if (NodeIndex == INDEX_NONE || Nodes[NodeIndex].EntryIndex == INDEX_NONE) {
+		return nullptr;
+	}
+	return Entries[Nodes[NodeIndex].EntryIndex].Command;
+}
+
+void FChatCommandNameTrie::FindCompletions(const FString& Prefix, int32 MaxResults, TArray<FString>& OutNames) const {
+	const int32 PrefixNodeIndex = FindNode(Prefix);
+	if (PrefixNodeIndex == INDEX_NONE || MaxResults <= 0) {
+		return;
+	}
+	//Collect all names in the subtree of the prefix node
+	TArray<int32> MatchedEntries;
+	TArray<int32> NodeStack;
+	NodeStack.Add(PrefixNodeIndex);
+	while (NodeStack.Num() > 0) {
+		const FNode& Node = Nodes[NodeStack.Pop(false)];
+		if (Node.EntryIndex != INDEX_NONE) {
+			MatchedEntries.Add(Node.EntryIndex);
+		}
+		for (const TPair<TCHAR, int32>& Child : Node.Children) {
+			NodeStack.Add(Child.Value);
+		}
+	}
+	MatchedEntries.Sort([this](int32 A, int32 B) {
+		const FNameEntry& EntryA = Entries[A];
+		const FNameEntry& EntryB = Entries[B];
+		if (EntryA.Rank != EntryB.Rank) {
+			return EntryA.Rank < EntryB.Rank;
+		}
+		if (EntryA.Name.Len() != EntryB.Name.Len()) {
+			return EntryA.Name.Len() < EntryB.Name.Len();
+		}
+		return EntryA.Name.Compare(EntryB.Name, ESearchCase::IgnoreCase) < 0;
+	});
+	const int32 NumResults = FMath::Min(MaxResults, MatchedEntries.Num());
+	for (int32 i = 0; i < NumResults; i++) {
+		OutNames.Add(Entries[MatchedEntries[i]].Name);
+	}
+}
@@ -15,8 +15,8 @@ EExecutionStatus AInfoCommandInstance::ExecuteCommand_Implementation(UCommandSen
 	Sender->SendChatMessage(FString::Printf(TEXT("Running SML v.%s"), *Version.ToString()));
 
  	UModLoadingLibrary* ModLoadingLibrary = GEngine->GetEngineSubsystem<UModLoadingLibrary>();
-	const TArray<FModInfo> LoadedMods = ModLoadingLibrary->GetLoadedMods();
- 	const FString ModListString = FString::JoinBy(LoadedMods, TEXT(", "), [](const FModInfo& ModInfo) { return ModInfo.FriendlyName; });
+	const TSharedRef<const FLoadedModList, ESPMode::ThreadSafe> LoadedModList = ModLoadingLibrary->GetLoadedModList();
+ 	const FString ModListString = FString::JoinBy(LoadedModList->Mods, TEXT(", "), [](const FModInfo& ModInfo) { return ModInfo.FriendlyName; });
  	Sender->SendChatMessage(FString::Printf(TEXT("Loaded Mods: %s"), *ModListString));
  	
 	return EExecutionStatus::COMPLETED;
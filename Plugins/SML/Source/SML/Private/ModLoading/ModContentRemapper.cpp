@@ -2,23 +2,72 @@
 
 #include "SatisfactoryModLoader.h"
 #include "Interfaces/IPluginManager.h"
-#include "UObject/CoreRedirects.h"
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+#include "Misc/PackageName.h"
+
+UModContentRemapper::UModContentRemapper() : RedirectBatchDepth(0) {
+}
 
 void UModContentRemapper::RegisterPackageRedirect(const FString& OriginalPackage, const FString& NewPackage, bool bMatchSubstring) {
 	ECoreRedirectFlags Flags = ECoreRedirectFlags::Type_Package;
 	if (bMatchSubstring) {
 		Flags |= ECoreRedirectFlags::Option_MatchSubstring;
 	}
-
-	TArray<FCoreRedirect> RedirectList;
-	RedirectList.Add(FCoreRedirect(Flags, OriginalPackage, NewPackage));
-	FCoreRedirects::AddRedirectList(RedirectList, TEXT("ModContentRemapper::RegisterPackageRedirect"));
+	AddRedirect(FCoreRedirect(Flags, OriginalPackage, NewPackage), TEXT("ModContentRemapper::RegisterPackageRedirect"));
 }
 
 void UModContentRemapper::RegisterClassRedirect(const FString& OldClassName, const FString& NewClassName) {
-	TArray<FCoreRedirect> RedirectList;
-	RedirectList.Add(FCoreRedirect(ECoreRedirectFlags::Type_Class, OldClassName, NewClassName));
-	FCoreRedirects::AddRedirectList(RedirectList, TEXT("ModContentRemapper::RegisterClassRedirect"));
+	AddRedirect(FCoreRedirect(ECoreRedirectFlags::Type_Class, OldClassName, NewClassName), TEXT("ModContentRemapper::RegisterClassRedirect"));
+}
+
+void UModContentRemapper::BeginRedirectBatch() {
+	this->RedirectBatchDepth++;
+}
+
+void UModContentRemapper::EndRedirectBatch() {
+	checkf(RedirectBatchDepth > 0, TEXT("EndRedirectBatch called without matching BeginRedirectBatch"));
+	this->RedirectBatchDepth--;
+	
+	if (RedirectBatchDepth == 0 && PendingRedirects.Num()) {
+		const TArray<FCoreRedirect> RedirectList = MoveTemp(PendingRedirects);
+		PendingRedirects.Reset();
+		
+		FCoreRedirects::AddRedirectList(RedirectList, TEXT("ModContentRemapper::EndRedirectBatch"));
+		UE_LOG(LogSatisfactoryModLoader, Log, TEXT("Registered %d batched content redirects"), RedirectList.Num());
+		ValidateRedirectTargetsAsync(RedirectList);
+	}
+}
+
+void UModContentRemapper::AddRedirect(const FCoreRedirect& Redirect, const TCHAR* SourceString) {
+	if (RedirectBatchDepth > 0) {
+		PendingRedirects.Add(Redirect);
+		return;
+	}
+	const TArray<FCoreRedirect> RedirectList{Redirect};
+	FCoreRedirects::AddRedirectList(RedirectList, SourceString);
+	ValidateRedirectTargetsAsync(RedirectList);
+}
+
+void UModContentRemapper::ValidateRedirectTargetsAsync(const TArray<FCoreRedirect>& Redirects) {
+	//Only exact package redirects point to a concrete package, substring ones redirect whole paths
+	TArray<FString> TargetPackageNames;
+	for (const FCoreRedirect& Redirect : Redirects) {
+		if (EnumHasAnyFlags(Redirect.RedirectFlags, ECoreRedirectFlags::Type_Package) && !Redirect.IsSubstringMatch() && Redirect.NewName.PackageName != NAME_None) {
+			TargetPackageNames.Add(Redirect.NewName.PackageName.ToString());
+		}
+	}
+	if (TargetPackageNames.Num() == 0) {
+		return;
+	}
+	//Checking package existence hits the file system, so it should not delay loading
+	Async(EAsyncExecution::ThreadPool, [TargetPackageNames]() {
+		for (const FString& PackageName : TargetPackageNames) {
+			if (!FPackageName::DoesPackageExist(PackageName)) {
+				UE_LOG(LogSatisfactoryModLoader, Warning, TEXT("Content redirect target package %s does not exist"), *PackageName);
+			}
+		}
+	});
 }
 
 bool UModContentRemapper::ShouldCreateSubsystem(UObject* Outer) const {
@@ -54,9 +103,24 @@ void UModContentRemapper::OnNewPluginMounted(IPlugin& Plugin) {
 	if (Plugin.IsEnabled() && Plugin.GetType() == EPluginType::Mod && Plugin.CanContainContent()) {
 		const FString PluginName = Plugin.GetName();
 		if (!PluginsAlreadyHandled.Contains(PluginName)) {
-			const FCoreRedirect PluginRedirect = MakeRedirectForPlugin(Plugin);
-			FCoreRedirects::AddRedirectList({PluginRedirect}, TEXT("UModContentRemapper::OnNewPluginMounted"));
+			AddRedirect(MakeRedirectForPlugin(Plugin), TEXT("UModContentRemapper::OnNewPluginMounted"));
 			this->PluginsAlreadyHandled.Add(PluginName);
 		}
 	}
 }
+
+FScopedContentRedirectBatch::FScopedContentRedirectBatch() : ContentRemapper(NULL) {
+	//Content remapper only exists in cooked builds
+	if (GEngine != NULL) {
+		ContentRemapper = GEngine->GetEngineSubsystem<UModContentRemapper>();
+	}
+	if (ContentRemapper != NULL) {
+		ContentRemapper->BeginRedirectBatch();
+	}
+}
+
+FScopedContentRedirectBatch::~FScopedContentRedirectBatch() {
+	if (ContentRemapper != NULL) {
+		ContentRemapper->EndRedirectBatch();
+	}
+}
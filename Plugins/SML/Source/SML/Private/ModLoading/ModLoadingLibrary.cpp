@@ -5,17 +5,23 @@
 #include "Module/WorldModuleManager.h"
 #include "Util/ImageLoadingUtil.h"
 #include "Json.h"
+#include "HAL/FileManager.h"
+#include "ModLoading/PluginMetadataCache.h"
 
 //We only want to enforce plugin dependency versions outside of the editor
 #define ENFORCE_PLUGIN_DEPENDENCY_VERSIONS !WITH_EDITOR
 
+//Plugin descriptors are edited all the time in the editor, and saving cache there would only create extra files
+#define ENABLE_PLUGIN_METADATA_CACHE !WITH_EDITOR
+
 void FSMLPluginDescriptorMetadata::SetupDefaults(const FPluginDescriptor& PluginDescriptor) {
     this->Version = FVersion(PluginDescriptor.Version, 0, 0);
     this->bAcceptsAnyRemoteVersion = false;
     this->RemoteVersionRange = FVersionRange::CreateRangeWithMinVersion(Version);
 }
 
-void FSMLPluginDescriptorMetadata::Load(const FString& PluginName, const TSharedPtr<FJsonObject> Source) {
+bool FSMLPluginDescriptorMetadata::Load(const FString& PluginName, const TSharedPtr<FJsonObject> Source) {
+    bool bParsedWithoutErrors = true;
 
     //Try to parse SemVersion metadata to get proper semantic version of the plugin
     FString SemanticVersion;
@@ -32,6 +38,7 @@ void FSMLPluginDescriptorMetadata::Load(const FString& PluginName, const TShared
             
         } else {
             UE_LOG(LogSatisfactoryModLoader, Error, TEXT("Plugin/Mod %s has invalid Semantic Version value: '%s': %s"), *PluginName, *SemanticVersion, *VersionParseError);
+            bParsedWithoutErrors = false;
         }
     } else {
         UE_LOG(LogSatisfactoryModLoader, Warning, TEXT("Plugin/Mod %s does not specify 'SemVersion' field, falling back to UE Version"), *PluginName);
@@ -51,6 +58,7 @@ void FSMLPluginDescriptorMetadata::Load(const FString& PluginName, const TShared
             this->RemoteVersionRange = VersionRange;
         } else {
             UE_LOG(LogSatisfactoryModLoader, Error, TEXT("Plugin %s has invalid Remote Version Range value: %s: %s"), *PluginName, *RemoteVersionRangeString, *VersionRangeError);
+            bParsedWithoutErrors = false;
         }
         if (bAcceptsAnyRemoteVersion) {
             UE_LOG(LogSatisfactoryModLoader, Warning, TEXT("Plugin %s specifies remote version range while also having acceptAnyRemoteVersion set"), *PluginName);
@@ -75,12 +83,14 @@ void FSMLPluginDescriptorMetadata::Load(const FString& PluginName, const TShared
                     } else {
                         UE_LOG(LogSatisfactoryModLoader, Error, TEXT("Plugin %s has invalid dependency '%s' version range '%s': %s"),
                             *PluginName, *DependencyName, *DependencyVersionRangeString, *DependencyErrorMessage);
+                        bParsedWithoutErrors = false;
                     }
                 }
             }
             
         }
     }
+    return bParsedWithoutErrors;
 }
 
 UModLoadingLibrary::UModLoadingLibrary() {
@@ -88,35 +98,53 @@ UModLoadingLibrary::UModLoadingLibrary() {
 }
 
 bool UModLoadingLibrary::IsModLoaded(const FString& Name) {
-    FModInfo LoadedModInfo;
-    return GetLoadedModInfo(Name, LoadedModInfo);
+    return GetLoadedModList()->FindMod(Name) != NULL;
 }
 
 TArray<FModInfo> UModLoadingLibrary::GetLoadedMods() {
-    TArray<FModInfo> OutModInfoList;
-    OutModInfoList.Add(CreateFactoryGameModInfo());
+    return GetLoadedModList()->Mods;
+}
+
+bool UModLoadingLibrary::GetLoadedModInfo(const FString& Name, FModInfo& OutModInfo) {
+    const TSharedRef<const FLoadedModList, ESPMode::ThreadSafe> ModList = GetLoadedModList();
+    if (const FModInfo* ModInfo = ModList->FindMod(Name)) {
+        OutModInfo = *ModInfo;
+        return true;
+    }
+    return false;
+}
+
+TSharedRef<const FLoadedModList, ESPMode::ThreadSafe> UModLoadingLibrary::GetLoadedModList() {
+    FScopeLock ScopeLock(&LoadedModListCriticalSection);
+    //Mod list can be requested by other subsystems before this one has been initialized, so build it on demand
+    if (!LoadedModList.IsValid()) {
+        this->LoadedModList = BuildLoadedModList();
+    }
+    return LoadedModList.ToSharedRef();
+}
+
+void UModLoadingLibrary::RebuildLoadedModList() {
+    //Callers still holding the previous snapshot will keep it alive until they are done with it
+    FScopeLock ScopeLock(&LoadedModListCriticalSection);
+    this->LoadedModList = BuildLoadedModList();
+}
+
+TSharedRef<const FLoadedModList, ESPMode::ThreadSafe> UModLoadingLibrary::BuildLoadedModList() {
+    const TSharedRef<FLoadedModList, ESPMode::ThreadSafe> NewModList = MakeShared<FLoadedModList, ESPMode::ThreadSafe>();
+    NewModList->Mods.Add(CreateFactoryGameModInfo());
     
     const TArray<TSharedRef<IPlugin>> EnabledPlugins = IPluginManager::Get().GetEnabledPlugins();
     for (const TSharedRef<IPlugin>& Plugin : EnabledPlugins) {
         if (IsPluginAMod(Plugin.Get())) {
-            PopulatePluginModInfo(Plugin.Get(), OutModInfoList.AddDefaulted_GetRef());
+            PopulatePluginModInfo(Plugin.Get(), NewModList->Mods.AddDefaulted_GetRef());
         }
     }
     
-    return OutModInfoList;
-}
-
-bool UModLoadingLibrary::GetLoadedModInfo(const FString& Name, FModInfo& OutModInfo) {
-    if (Name == FACTORYGAME_MOD_NAME) {
-        OutModInfo = CreateFactoryGameModInfo();
-    }
-    const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(Name);
-
-    if (Plugin.IsValid() && Plugin->IsEnabled() && IsPluginAMod(*Plugin)) {
-        PopulatePluginModInfo(*Plugin.Get(), OutModInfo);
-        return true;
+    NewModList->ModIndicesByName.Reserve(NewModList->Mods.Num());
+    for (int32 i = 0; i < NewModList->Mods.Num(); i++) {
+        NewModList->ModIndicesByName.Add(NewModList->Mods[i].Name, i);
     }
-    return false;
+    return NewModList;
 }
 
 void UModLoadingLibrary::Initialize(FSubsystemCollectionBase& Collection) {
@@ -124,6 +152,12 @@ void UModLoadingLibrary::Initialize(FSubsystemCollectionBase& Collection) {
     IPluginManager::Get().OnNewPluginCreated().AddUObject(this, &UModLoadingLibrary::OnNewPluginCreated);
     IPluginManager::Get().OnNewPluginMounted().AddUObject(this, &UModLoadingLibrary::OnNewPluginCreated);
 
+#if ENABLE_PLUGIN_METADATA_CACHE
+    //Load metadata parsed during previous launches, so only changed plugin descriptors have to be parsed again
+    this->MetadataCache = MakeShareable(new FPluginMetadataCache());
+    this->MetadataCache->LoadFromFile(FPluginMetadataCache::GetDefaultCacheFilePath());
+#endif
+
     //Initialize metadata and check dependencies for plugins that have already been loaded
     ReloadPluginMetadata();
     VerifyPluginDependencies();
@@ -258,7 +292,9 @@ void UModLoadingLibrary::OnNewPluginCreated(IPlugin& Plugin) {
         //Only perform metadata loading and dependencies verification if plugin hasn't been checked before
         if (!PluginMetadata.Contains(Plugin.GetName())) {
             LoadMetadataForPlugin(Plugin);
+            SaveMetadataCache();
             VerifySinglePluginDependencies(Plugin);
+            RebuildLoadedModList();
         }
     }
 }
@@ -270,21 +306,18 @@ void UModLoadingLibrary::ReloadPluginMetadata() {
             LoadMetadataForPlugin(Plugin.Get());
         }
     }
+    SaveMetadataCache();
+    RebuildLoadedModList();
 }
 
-TSharedPtr<FJsonObject> ParsePluginDescriptorFile(IPlugin& Plugin) {
-    const FString PluginDescriptorFilePath = Plugin.GetDescriptorFileName();
-    
-    FString FileContents;
-    if (!FFileHelper::LoadFileToString(FileContents, *PluginDescriptorFilePath)) {
-        UE_LOG(LogSatisfactoryModLoader, Error, TEXT("Failed to open descriptor file %s for plugin %s"), *PluginDescriptorFilePath, *Plugin.GetName());
-        return NULL;
-    }
+TSharedPtr<FJsonObject> ParsePluginDescriptorFile(IPlugin& Plugin, const TArray<uint8>& FileContents) {
+    FString FileContentsString;
+    FFileHelper::BufferToString(FileContentsString, FileContents.GetData(), FileContents.Num());
 
-    const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(FileContents);
+    const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(FileContentsString);
     TSharedPtr<FJsonObject> OutObject;
     if (!FJsonSerializer::Deserialize(JsonReader, OutObject)) {
-        UE_LOG(LogSatisfactoryModLoader, Error, TEXT("Failed to parse descriptor file %s for plugin %s, invalid json"), *PluginDescriptorFilePath, *Plugin.GetName());
+        UE_LOG(LogSatisfactoryModLoader, Error, TEXT("Failed to parse descriptor file %s for plugin %s, invalid json"), *Plugin.GetDescriptorFileName(), *Plugin.GetName());
         return NULL;
     }
     
@@ -292,18 +325,58 @@ TSharedPtr<FJsonObject> ParsePluginDescriptorFile(IPlugin& Plugin) {
 }
 
 void UModLoadingLibrary::LoadMetadataForPlugin(IPlugin& Plugin) {
+    //Metadata can be loaded by the mod list built on demand on another thread
+    FScopeLock ScopeLock(&LoadedModListCriticalSection);
     if (Plugin.IsEnabled() && IsPluginAMod(Plugin) && !PluginMetadata.Contains(Plugin.GetName())) {
+        const FString PluginDescriptorFilePath = Plugin.GetDescriptorFileName();
+        const FFileStatData DescriptorStat = IFileManager::Get().GetStatData(*PluginDescriptorFilePath);
+
+        //Descriptor file has not been modified since it has been parsed last time, so we can skip reading it
+        if (MetadataCache.IsValid()) {
+            if (const FSMLPluginDescriptorMetadata* CachedMetadata = MetadataCache->FindMetadata(PluginDescriptorFilePath, DescriptorStat)) {
+                this->PluginMetadata.Add(Plugin.GetName(), *CachedMetadata);
+                return;
+            }
+        }
         
         const FPluginDescriptor& PluginDescriptor = Plugin.GetDescriptor();    
         FSMLPluginDescriptorMetadata PluginDescriptorMetadata{};
         PluginDescriptorMetadata.SetupDefaults(PluginDescriptor);
 
-        const TSharedPtr<FJsonObject> PluginDescriptorObject = ParsePluginDescriptorFile(Plugin);
+        TArray<uint8> FileContents;
+        if (!FFileHelper::LoadFileToArray(FileContents, *PluginDescriptorFilePath)) {
+            UE_LOG(LogSatisfactoryModLoader, Error, TEXT("Failed to open descriptor file %s for plugin %s"), *PluginDescriptorFilePath, *Plugin.GetName());
+            this->PluginMetadata.Add(Plugin.GetName(), PluginDescriptorMetadata);
+            return;
+        }
+
+        //Descriptor file has been touched, but it's contents are still the same
+        const uint64 ContentHash = FPluginMetadataCache::ComputeContentHash(FileContents);
+        if (MetadataCache.IsValid()) {
+            if (const FSMLPluginDescriptorMetadata* CachedMetadata = MetadataCache->FindMetadataByHash(PluginDescriptorFilePath, DescriptorStat, ContentHash)) {
+                this->PluginMetadata.Add(Plugin.GetName(), *CachedMetadata);
+                return;
+            }
+        }
+
+        const TSharedPtr<FJsonObject> PluginDescriptorObject = ParsePluginDescriptorFile(Plugin, FileContents);
+        bool bParsedWithoutErrors = false;
         if (PluginDescriptorObject.IsValid()) {
-            PluginDescriptorMetadata.Load(Plugin.GetName(), PluginDescriptorObject);
+            bParsedWithoutErrors = PluginDescriptorMetadata.Load(Plugin.GetName(), PluginDescriptorObject);
         }
     
         this->PluginMetadata.Add(Plugin.GetName(), PluginDescriptorMetadata);
+
+        //Descriptors with errors are not cached, so they are parsed again and their errors are reported on every launch
+        if (bParsedWithoutErrors && MetadataCache.IsValid()) {
+            MetadataCache->AddMetadata(PluginDescriptorFilePath, DescriptorStat, ContentHash, PluginDescriptorMetadata);
+        }
+    }
+}
+
+void UModLoadingLibrary::SaveMetadataCache() {
+    if (MetadataCache.IsValid()) {
+        MetadataCache->SaveToFile(FPluginMetadataCache::GetDefaultCacheFilePath());
     }
 }
 
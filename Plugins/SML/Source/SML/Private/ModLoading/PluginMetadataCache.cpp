@@ -0,0 +1,207 @@
+#include "ModLoading/PluginMetadataCache.h"
+#include "SatisfactoryModLoader.h"
+#include "Hash/CityHash.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static void SerializeVersion(FArchive& Ar, FVersion& Version) {
+	Ar << Version.Major;
+	Ar << Version.Minor;
+	Ar << Version.Patch;
+	Ar << Version.Type;
+	Ar << Version.BuildInfo;
+}
+
+static void SerializeVersionRange(FArchive& Ar, FVersionRange& VersionRange) {
+	TArray<FVersionComparatorCollection>& Collections = VersionRange.GetMutableCollections();
+	int32 NumCollections = Collections.Num();
+	Ar << NumCollections;
+	if (Ar.IsLoading()) {
+		Collections.SetNum(FMath::Max(NumCollections, 0));
+	}
+	for (FVersionComparatorCollection& Collection : Collections) {
+		int32 NumComparators = Collection.Comparators.Num();
+		Ar << NumComparators;
+		if (Ar.IsLoading()) {
+			Collection.Comparators.SetNum(FMath::Max(NumComparators, 0));
+		}
+		for (FVersionComparator& Comparator : Collection.Comparators) {
+			uint8 ComparisonOp = static_cast<uint8>(Comparator.Op);
+			Ar << ComparisonOp;
+			Comparator.Op = static_cast<EVersionComparisonOp>(ComparisonOp);
+			SerializeVersion(Ar, Comparator.MyVersion);
+		}
+	}
+	//Compiled form is not stored, it is cheap to rebuild from the comparators
+	VersionRange.UpdateCompiledRange();
+}
+
+static void SerializeMetadata(FArchive& Ar, FSMLPluginDescriptorMetadata& Metadata) {
+	SerializeVersion(Ar, Metadata.Version);
+	Ar << Metadata.bAcceptsAnyRemoteVersion;
+	SerializeVersionRange(Ar, Metadata.RemoteVersionRange);
+
+	int32 NumDependencies = Metadata.DependenciesVersions.Num();
+	Ar << NumDependencies;
+	if (Ar.IsLoading()) {
+		Metadata.DependenciesVersions.Empty(FMath::Max(NumDependencies, 0));
+		for (int32 i = 0; i < NumDependencies && !Ar.IsError(); i++) {
+			FString DependencyName;
+			FVersionRange DependencyVersionRange;
+			Ar << DependencyName;
+			SerializeVersionRange(Ar, DependencyVersionRange);
+			Metadata.DependenciesVersions.Add(DependencyName, DependencyVersionRange);
+		}
+	} else {
+		for (TPair<FString, FVersionRange>& Pair : Metadata.DependenciesVersions) {
+			Ar << Pair.Key;
+			SerializeVersionRange(Ar, Pair.Value);
+		}
+	}
+}
+
+FPluginMetadataCache::FPluginMetadataCache() : bIsDirty(false) {
+}
+
+FString FPluginMetadataCache::GetDefaultCacheFilePath() {
+	return FPaths::ProjectSavedDir() + TEXT("SML/PluginMetadataCache.bin");
+}
+
+void FPluginMetadataCache::SerializeEntry(FArchive& Ar, FString& DescriptorPath, FCacheEntry& Entry) {
+	Ar << DescriptorPath;
+	Ar << Entry.FileSize;
+	Ar << Entry.ModificationTime;
+	Ar << Entry.ContentHash;
+	SerializeMetadata(Ar, Entry.Metadata);
+}
+
+bool FPluginMetadataCache::LoadFromFile(const FString& CacheFilePath) {
+	Entries.Empty();
+	bIsDirty = false;
+
+	TArray<uint8> FileContents;
+	if (!FFileHelper::LoadFileToArray(FileContents, *CacheFilePath, FILEREAD_Silent)) {
+		return false;
+	}
+	FMemoryReader CacheReader(FileContents);
+	uint32 FileMagic = 0;
+	int32 SchemaVersion = 0;
+	uint32 PayloadCrc = 0;
+	CacheReader << FileMagic;
+	CacheReader << SchemaVersion;
+	CacheReader << PayloadCrc;
+
+	if (CacheReader.IsError() || FileMagic != CacheFileMagic || SchemaVersion != CacheSchemaVersion) {
+		UE_LOG(LogSatisfactoryModLoader, Display, TEXT("Discarding outdated plugin metadata cache %s"), *CacheFilePath);
+		return false;
+	}
+	//Make sure payload is intact before reading counts and strings from it
+	const int64 PayloadOffset = CacheReader.Tell();
+	const uint8* PayloadData = FileContents.GetData() + PayloadOffset;
+	const int32 PayloadSize = FileContents.Num() - PayloadOffset;
+	if (FCrc::MemCrc32(PayloadData, PayloadSize) != PayloadCrc) {
+		UE_LOG(LogSatisfactoryModLoader, Warning, TEXT("Discarding corrupted plugin metadata cache %s"), *CacheFilePath);
+		return false;
+	}
+
+	CacheReader.Seek(PayloadOffset);
+	int32 NumEntries = 0;
+	CacheReader << NumEntries;
+	Entries.Reserve(FMath::Max(NumEntries, 0));
+
+	for (int32 i = 0; i < NumEntries && !CacheReader.IsError(); i++) {
+		FString DescriptorPath;
+		FCacheEntry Entry{};
+		SerializeEntry(CacheReader, DescriptorPath, Entry);
+		Entry.bUsedThisSession = false;
+		Entries.Add(DescriptorPath, MoveTemp(Entry));
+	}
+	if (CacheReader.IsError()) {
+		UE_LOG(LogSatisfactoryModLoader, Warning, TEXT("Discarding corrupted plugin metadata cache %s"), *CacheFilePath);
+		Entries.Empty();
+		return false;
+	}
+	return true;
+}
+
+bool FPluginMetadataCache::SaveToFile(const FString& CacheFilePath) {
+	int32 NumEntries = 0;
+	for (const TPair<FString, FCacheEntry>& Pair : Entries) {
+		NumEntries += Pair.Value.bUsedThisSession ? 1 : 0;
+	}
+	//Entries of removed plugins have to be dropped from the file even if all other entries were hits
+	if (!bIsDirty && NumEntries == Entries.Num()) {
+		return true;
+	}
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	PayloadWriter << NumEntries;
+	for (TPair<FString, FCacheEntry>& Pair : Entries) {
+		if (Pair.Value.bUsedThisSession) {
+			SerializeEntry(PayloadWriter, Pair.Key, Pair.Value);
+		}
+	}
+
+	TArray<uint8> FileContents;
+	FMemoryWriter FileWriter(FileContents);
+	uint32 FileMagic = CacheFileMagic;
+	int32 SchemaVersion = CacheSchemaVersion;
+	uint32 PayloadCrc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+	FileWriter << FileMagic;
+	FileWriter << SchemaVersion;
+	FileWriter << PayloadCrc;
+	FileWriter.Serialize(Payload.GetData(), Payload.Num());
+
+	if (!FFileHelper::SaveArrayToFile(FileContents, *CacheFilePath)) {
+		UE_LOG(LogSatisfactoryModLoader, Warning, TEXT("Failed to save plugin metadata cache to %s"), *CacheFilePath);
+		return false;
+	}
+	//Keep entries in sync with the file, so unused entries do not make every following save write it again
+	for (auto It = Entries.CreateIterator(); It; ++It) {
+		if (!It->Value.bUsedThisSession) {
+			It.RemoveCurrent();
+		}
+	}
+	bIsDirty = false;
+	return true;
+}
+
+const FSMLPluginDescriptorMetadata* FPluginMetadataCache::FindMetadata(const FString& DescriptorPath, const FFileStatData& DescriptorStat) {
+	FCacheEntry* Entry = Entries.Find(DescriptorPath);
+	if (Entry == NULL || !DescriptorStat.bIsValid || Entry->FileSize != DescriptorStat.FileSize || Entry->ModificationTime != DescriptorStat.ModificationTime) {
+		return NULL;
+	}
+	Entry->bUsedThisSession = true;
+	return &Entry->Metadata;
+}
+
+const FSMLPluginDescriptorMetadata* FPluginMetadataCache::FindMetadataByHash(const FString& DescriptorPath, const FFileStatData& DescriptorStat, uint64 ContentHash) {
+	FCacheEntry* Entry = Entries.Find(DescriptorPath);
+	if (Entry == NULL || Entry->ContentHash != ContentHash) {
+		return NULL;
+	}
+	//Descriptor has been touched without changing it's contents, refresh stats so next lookup does not need to read it
+	Entry->FileSize = DescriptorStat.FileSize;
+	Entry->ModificationTime = DescriptorStat.ModificationTime;
+	Entry->bUsedThisSession = true;
+	bIsDirty = true;
+	return &Entry->Metadata;
+}
+
+void FPluginMetadataCache::AddMetadata(const FString& DescriptorPath, const FFileStatData& DescriptorStat, uint64 ContentHash, const FSMLPluginDescriptorMetadata& Metadata) {
+	FCacheEntry Entry{};
+	Entry.FileSize = DescriptorStat.FileSize;
+	Entry.ModificationTime = DescriptorStat.ModificationTime;
+	Entry.ContentHash = ContentHash;
+	Entry.Metadata = Metadata;
+	Entry.bUsedThisSession = true;
+	Entries.Add(DescriptorPath, MoveTemp(Entry));
+	bIsDirty = true;
+}
+
+uint64 FPluginMetadataCache::ComputeContentHash(const TArray<uint8>& FileContents) {
+	return CityHash64(reinterpret_cast<const char*>(FileContents.GetData()), FileContents.Num());
+}
@@ -3,6 +3,8 @@
 #include "IPlatformFilePak.h"
 #include "Util/BlueprintAssetHelperLibrary.h"
 #include "SatisfactoryModLoader.h"
+#include "Interfaces/IPluginManager.h"
+#include "Util/TopologicalSort/TopologicalSort.h"
 
 //Switch to enable mod loading in editor. Currently it's disabled because we don't have proper FactoryGame editor build
 #ifndef ENABLE_MOD_LOADING_IN_EDITOR
@@ -79,4 +81,66 @@ bool FPluginModuleLoader::ShouldLoadModulesForWorld(UWorld* World) {
 #endif
 }
 
+void FPluginModuleLoader::SortModulesByDependencyLevel(TArray<FDiscoveredModule>& Modules, TArray<int32>& OutLevelOffsets) {
+	IPluginManager& PluginManager = IPluginManager::Get();
+	SortModulesByDependencyLevel(Modules, OutLevelOffsets, [&](const FString& PluginName) {
+		TArray<FString> Dependencies;
+		const TSharedPtr<IPlugin> Plugin = PluginManager.FindPlugin(PluginName);
+		//Plugin can only be missing if it was an optional dependency
+		if (Plugin.IsValid()) {
+			for (const FPluginReferenceDescriptor& PluginDependency : Plugin->GetDescriptor().Plugins) {
+				Dependencies.Add(PluginDependency.Name);
+			}
+		}
+		return Dependencies;
+	});
+}
+
+void FPluginModuleLoader::SortModulesByDependencyLevel(TArray<FDiscoveredModule>& Modules, TArray<int32>& OutLevelOffsets, TFunctionRef<TArray<FString>(const FString& PluginName)> GetPluginDependencies) {
+	//Modules are added to the graph in discovery order, which is preserved inside of each level
+	TDirectedGraph<FString> DependencyGraph;
+	TMap<FString, int32> ModuleIndices;
+	for (int32 ModuleIndex = 0; ModuleIndex < Modules.Num(); ModuleIndex++) {
+		DependencyGraph.AddNode(Modules[ModuleIndex].OwnerPluginName);
+		ModuleIndices.Add(Modules[ModuleIndex].OwnerPluginName, ModuleIndex);
+	}
+
+	//Walk plugin dependencies transitively, because plugins in between might not have any modules of this type
+	TSet<FString> VisitedPlugins;
+	TArray<FString> PluginsToVisit;
+	
+	for (const FDiscoveredModule& Module : Modules) {
+		VisitedPlugins.Reset();
+		PluginsToVisit.Reset();
+		PluginsToVisit.Add(Module.OwnerPluginName);
+		
+		while (PluginsToVisit.Num()) {
+			for (const FString& PluginDependency : GetPluginDependencies(PluginsToVisit.Pop(false))) {
+				bool bIsAlreadyVisited = false;
+				VisitedPlugins.Add(PluginDependency, &bIsAlreadyVisited);
+				if (bIsAlreadyVisited) {
+					continue;
+				}
+				//Dependency has to be processed before the module depending on it
+				if (ModuleIndices.Contains(PluginDependency)) {
+					DependencyGraph.AddEdge(PluginDependency, Module.OwnerPluginName);
+				}
+				PluginsToVisit.Add(PluginDependency);
+			}
+		}
+	}
+
+	TArray<FString> SortedPluginNames;
+	if (!FTopologicalSort::ComputeDependencyLevels(DependencyGraph, SortedPluginNames, OutLevelOffsets)) {
+		UE_LOG(LogSatisfactoryModLoader, Error, TEXT("Plugin dependency graph contains cycles, modules of the cyclic plugins will be processed last"));
+	}
+
+	TArray<FDiscoveredModule> SortedModules;
+	SortedModules.Reserve(Modules.Num());
+	for (const FString& PluginName : SortedPluginNames) {
+		SortedModules.Add(Modules[ModuleIndices.FindChecked(PluginName)]);
+	}
+	Modules = MoveTemp(SortedModules);
+}
+
 static FStaticSelfRegisteringExec PluginModuleLoaderExecRegistration(&PluginModuleLoaderExec);
@@ -27,6 +27,7 @@ void UGameInstanceModuleManager::Initialize(FSubsystemCollectionBase& Collection
     const TArray<FDiscoveredModule> DiscoveredModules = FPluginModuleLoader::FindRootModulesOfType(UGameInstanceModule::StaticClass());
 
     TMap<FString, FString> AlreadyLoadedMods;
+    TArray<FDiscoveredModule> UniqueModules;
     for (const FDiscoveredModule& Module : DiscoveredModules) {
         
         //Make sure we are not trying to register a single plugin twice
@@ -38,9 +39,14 @@ void UGameInstanceModuleManager::Initialize(FSubsystemCollectionBase& Collection
             continue;
         }
 
-        //Register module in the game instance module manager now
-        const TSubclassOf<UGameInstanceModule> GameInstanceModule = Module.ModuleClass.Get();
         AlreadyLoadedMods.Add(Module.OwnerPluginName, Module.ModuleClass->GetPathName());
+        UniqueModules.Add(Module);
+    }
+
+    //Register modules in the order of their dependencies, so dependencies always receive lifecycle events first
+    FPluginModuleLoader::SortModulesByDependencyLevel(UniqueModules, RootModuleLevelOffsets);
+    for (const FDiscoveredModule& Module : UniqueModules) {
+        const TSubclassOf<UGameInstanceModule> GameInstanceModule = Module.ModuleClass.Get();
         CreateRootModule(*Module.OwnerPluginName, GameInstanceModule);
     }
 
@@ -89,8 +95,7 @@ void UGameInstanceModuleManager::DispatchLifecycleEvent(ELifecyclePhase Phase) {
     UE_LOG(LogSatisfactoryModLoader, Log, TEXT("Dispatching lifecycle event %s to game instance modules"),
         *UModModule::LifecyclePhaseToString(Phase));
 
-    //Iterate modules in their order of registration and dispatch lifecycle event to them
-    for (UGameInstanceModule* RootModule : RootModuleList) {
-        RootModule->DispatchLifecycleEvent(Phase);
-    }
+    //Dispatch lifecycle event one dependency level at a time, in the order of registration inside of the level
+    //Content redirects registered by the modules are batched per level, so they are active before dependent modules process the event
+    FPluginModuleLoader::DispatchLifecycleEventByLevel(RootModuleList, RootModuleLevelOffsets, Phase);
 }
@@ -66,6 +66,7 @@ void AWorldModuleManager::Initialize() {
     const TArray<FDiscoveredModule> DiscoveredModules = FPluginModuleLoader::FindRootModulesOfType(ModuleTypeClass);
 
     TMap<FString, FString> AlreadyLoadedMods;
+    TArray<FDiscoveredModule> UniqueModules;
     for (const FDiscoveredModule& Module : DiscoveredModules) {
         
         //Make sure we are not trying to register a single plugin twice
@@ -77,9 +78,14 @@ void AWorldModuleManager::Initialize() {
             continue;
         }
 
-        //Register module in the game instance module manager now
-        const TSubclassOf<UWorldModule> WorldModule = Module.ModuleClass.Get();
         AlreadyLoadedMods.Add(Module.OwnerPluginName, Module.ModuleClass->GetPathName());
+        UniqueModules.Add(Module);
+    }
+
+    //Register modules in the order of their dependencies, so dependencies always receive lifecycle events first
+    FPluginModuleLoader::SortModulesByDependencyLevel(UniqueModules, RootModuleLevelOffsets);
+    for (const FDiscoveredModule& Module : UniqueModules) {
+        const TSubclassOf<UWorldModule> WorldModule = Module.ModuleClass.Get();
         CreateRootModule(*Module.OwnerPluginName, WorldModule);
     }
     
@@ -111,10 +117,9 @@ void AWorldModuleManager::DispatchLifecycleEvent(ELifecyclePhase Phase) {
     UE_LOG(LogSatisfactoryModLoader, Log, TEXT("Dispatching lifecycle event %s to world %s modules"), 
         *UModModule::LifecyclePhaseToString(Phase), *GetWorld()->GetMapName());
     
-    //Iterate modules in their order of registration and dispatch lifecycle event to them
-    for (UWorldModule* RootModule : RootModuleList) {
-        RootModule->DispatchLifecycleEvent(Phase);
-    }
+    //Dispatch lifecycle event one dependency level at a time, in the order of registration inside of the level
+    //Content redirects registered by the modules are batched per level, so they are active before dependent modules process the event
+    FPluginModuleLoader::DispatchLifecycleEventByLevel(RootModuleList, RootModuleLevelOffsets, Phase);
 }
 
 void UWorldModuleManagerComponent::SpawnModuleManager() {
@@ -1,15 +1,37 @@
 #include "Network/NetworkHandler.h"
 #include "Net/DataChannel.h"
+#include "Net/DataBunch.h"
 #include "FGGameInstance.h"
 #include "FGGameMode.h"
 #include "Patching/NativeHookManager.h"
 #include "Engine/Engine.h"
 #include "Engine/NetConnection.h"
+#include "Engine/Channel.h"
 #include "Util/ObjectMetadata.h"
+#include "Containers/Ticker.h"
 
 DEFINE_LOG_CATEGORY(LogModNetworkHandler);
 DEFINE_CONTROL_CHANNEL_MESSAGE_THREEPARAM(ModMessage, 40, FString, int32, FString);
 IMPLEMENT_CONTROL_CHANNEL_MESSAGE(ModMessage);
+DEFINE_CONTROL_CHANNEL_MESSAGE_TWOPARAM(ModMessageId, 41, uint16, FString);
+IMPLEMENT_CONTROL_CHANNEL_MESSAGE(ModMessageId);
+DEFINE_CONTROL_CHANNEL_MESSAGE_THREEPARAM(ModBinaryMessage, 42, uint16, int32, TArray<uint8>);
+IMPLEMENT_CONTROL_CHANNEL_MESSAGE(ModBinaryMessage);
+DEFINE_CONTROL_CHANNEL_MESSAGE_FOURPARAM(ModTransferStart, 43, int32, uint16, int32, int32);
+IMPLEMENT_CONTROL_CHANNEL_MESSAGE(ModTransferStart);
+DEFINE_CONTROL_CHANNEL_MESSAGE_TWOPARAM(ModTransferChunk, 44, int32, TArray<uint8>);
+IMPLEMENT_CONTROL_CHANNEL_MESSAGE(ModTransferChunk);
+DEFINE_CONTROL_CHANNEL_MESSAGE_ONEPARAM(ModTransferCancel, 45, int32);
+IMPLEMENT_CONTROL_CHANNEL_MESSAGE(ModTransferCancel);
+
+void UModNetworkHandler::Initialize(FSubsystemCollectionBase& Collection) {
+    //Flush connections at most once per tick instead of after every single message
+    this->FlushTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UModNetworkHandler::FlushPendingConnections));
+}
+
+void UModNetworkHandler::Deinitialize() {
+    FTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+}
 
 FMessageEntry& UModNetworkHandler::RegisterMessageType(const FMessageType& MessageType) {
     UE_LOG(LogModNetworkHandler, Display, TEXT("Registering message type %s:%d"), *MessageType.ModReference, MessageType.MessageId);
@@ -29,10 +51,171 @@ void UModNetworkHandler::CloseWithFailureMessage(UNetConnection* Connection, con
 
 void UModNetworkHandler::SendMessage(UNetConnection* Connection, FMessageType MessageType, FString Data) {
     FNetControlMessage<NMT_ModMessage>::Send(Connection, MessageType.ModReference, MessageType.MessageId, Data);
-    Connection->FlushNet(true);
+    UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+    NetworkHandler->QueueConnectionFlush(Connection);
 }
 
-void UModNetworkHandler::ReceiveMessage(UNetConnection* Connection, const FString& ModId, int32 MessageId, const FString& Content) const {
+bool UModNetworkHandler::SendBinaryMessage(UNetConnection* Connection, const FMessageType& MessageType, const TArray<uint8>& Data) {
+    //Remote side rejects oversized payloads, so there is no point in sending them
+    if (Data.Num() > MaxBinaryMessageSize) {
+        UE_LOG(LogModNetworkHandler, Error, TEXT("Binary message %s:%d is too large (%d bytes), it will not be sent"), *MessageType.ModReference, MessageType.MessageId, Data.Num());
+        return false;
+    }
+    UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+
+    uint16 ModIdIndex;
+    if (!NetworkHandler->GetOrAssignModIdIndex(Connection, MessageType.ModReference, ModIdIndex)) {
+        return false;
+    }
+    int32 MessageId = MessageType.MessageId;
+    //Control message Send takes parameters by reference, but never modifies them when writing
+    FNetControlMessage<NMT_ModBinaryMessage>::Send(Connection, ModIdIndex, MessageId, const_cast<TArray<uint8>&>(Data));
+    NetworkHandler->QueueConnectionFlush(Connection);
+    return true;
+}
+
+bool UModNetworkHandler::GetOrAssignModIdIndex(UNetConnection* Connection, const FString& ModId, uint16& OutModIdIndex) {
+    FModConnectionState& ConnectionState = ConnectionStates.FindOrAdd(Connection);
+    const uint16* ExistingIndex = ConnectionState.OutgoingModIdIndices.Find(ModId);
+    if (ExistingIndex != nullptr) {
+        OutModIdIndex = *ExistingIndex;
+        return true;
+    }
+    if (ConnectionState.OutgoingModIdIndices.Num() >= MAX_uint16) {
+        UE_LOG(LogModNetworkHandler, Error, TEXT("Too many mod IDs used by binary messages on a single connection, cannot send messages of %s"), *ModId);
+        return false;
+    }
+    const uint16 NewIndex = static_cast<uint16>(ConnectionState.OutgoingModIdIndices.Num());
+    ConnectionState.OutgoingModIdIndices.Add(ModId, NewIndex);
+
+    //Control channel is reliable and ordered, so assignment always arrives before messages using it
+    FString MutableModId = ModId;
+    FNetControlMessage<NMT_ModMessageId>::Send(Connection, NewIndex, MutableModId);
+    OutModIdIndex = NewIndex;
+    return true;
+}
+
+void UModNetworkHandler::QueueConnectionFlush(UNetConnection* Connection) {
+    ConnectionsPendingFlush.Add(Connection);
+}
+
+bool UModNetworkHandler::FlushPendingConnections(float DeltaTime) {
+    SendPendingTransferChunks();
+    for (const TWeakObjectPtr<UNetConnection>& Connection : ConnectionsPendingFlush) {
+        UNetConnection* NetConnection = Connection.Get();
+        if (NetConnection != nullptr && NetConnection->State != USOCK_Closed) {
+            NetConnection->FlushNet(true);
+        }
+    }
+    ConnectionsPendingFlush.Reset();
+    return true;
+}
+
+int32 UModNetworkHandler::StartTransfer(UNetConnection* Connection, const FMessageType& MessageType, TArray<uint8> Data) {
+    //Remote side rejects oversized transfers, so there is no point in sending them
+    if (Data.Num() > MaxIncomingTransferSize) {
+        UE_LOG(LogModNetworkHandler, Error, TEXT("Transfer %s:%d is too large (%d bytes), it will not be sent"), *MessageType.ModReference, MessageType.MessageId, Data.Num());
+        return INDEX_NONE;
+    }
+    FModConnectionState& ConnectionState = ConnectionStates.FindOrAdd(Connection);
+
+    FOutgoingModTransfer& Transfer = ConnectionState.OutgoingTransfers.AddDefaulted_GetRef();
+    Transfer.TransferId = ConnectionState.NextTransferId++;
+    Transfer.MessageType = MessageType;
+    Transfer.Data = MoveTemp(Data);
+    Transfer.BytesSent = 0;
+    Transfer.bStarted = false;
+    return Transfer.TransferId;
+}
+
+void UModNetworkHandler::CancelTransfer(UNetConnection* Connection, int32 TransferId) {
+    FModConnectionState* ConnectionState = ConnectionStates.Find(Connection);
+    if (ConnectionState == nullptr) {
+        return;
+    }
+    const int32 TransferIndex = ConnectionState->OutgoingTransfers.IndexOfByPredicate([&](const FOutgoingModTransfer& Transfer) {
+        return Transfer.TransferId == TransferId;
+    });
+    if (TransferIndex == INDEX_NONE) {
+        return;
+    }
+    //Remote side only needs to know about transfers it has already seen
+    if (ConnectionState->OutgoingTransfers[TransferIndex].bStarted) {
+        FNetControlMessage<NMT_ModTransferCancel>::Send(Connection, TransferId);
+        QueueConnectionFlush(Connection);
+    }
+    ConnectionState->OutgoingTransfers.RemoveAt(TransferIndex);
+}
+
+bool UModNetworkHandler::IsTransferInProgress(UNetConnection* Connection, int32 TransferId) const {
+    const FModConnectionState* ConnectionState = ConnectionStates.Find(Connection);
+    return ConnectionState != nullptr && ConnectionState->OutgoingTransfers.ContainsByPredicate([&](const FOutgoingModTransfer& Transfer) {
+        return Transfer.TransferId == TransferId;
+    });
+}
+
+int32 FModConnectionState::SendOutgoingTransferChunks(int32 MaxBytes, int32 ChunkSize, TFunctionRef<bool()> CanSend,
+    TFunctionRef<bool(const FOutgoingModTransfer& Transfer)> SendTransferStart,
+    TFunctionRef<void(int32 TransferId, const TArray<uint8>& Chunk)> SendTransferChunk) {
+    int32 BytesSent = 0;
+    while (OutgoingTransfers.Num() > 0 && BytesSent < MaxBytes && CanSend()) {
+        FOutgoingModTransfer& Transfer = OutgoingTransfers[0];
+        if (!Transfer.bStarted) {
+            if (!SendTransferStart(Transfer)) {
+                OutgoingTransfers.RemoveAt(0);
+                continue;
+            }
+            Transfer.bStarted = true;
+        }
+        //Last chunk of the tick is trimmed, so the limit is never exceeded
+        const int32 CurrentChunkSize = FMath::Min3(ChunkSize, MaxBytes - BytesSent, Transfer.Data.Num() - Transfer.BytesSent);
+        if (CurrentChunkSize > 0) {
+            const TArray<uint8> Chunk(Transfer.Data.GetData() + Transfer.BytesSent, CurrentChunkSize);
+            SendTransferChunk(Transfer.TransferId, Chunk);
+            Transfer.BytesSent += CurrentChunkSize;
+            BytesSent += CurrentChunkSize;
+        }
+        if (Transfer.BytesSent == Transfer.Data.Num()) {
+            OutgoingTransfers.RemoveAt(0);
+        }
+    }
+    return BytesSent;
+}
+
+void UModNetworkHandler::SendPendingTransferChunks() {
+    for (TPair<TWeakObjectPtr<UNetConnection>, FModConnectionState>& Pair : ConnectionStates) {
+        UNetConnection* Connection = Pair.Key.Get();
+        FModConnectionState& ConnectionState = Pair.Value;
+        if (Connection == nullptr || Connection->State == USOCK_Closed || ConnectionState.OutgoingTransfers.Num() == 0) {
+            continue;
+        }
+        UChannel* ControlChannel = Connection->Channels[0];
+
+        const int32 BytesSentThisTick = ConnectionState.SendOutgoingTransferChunks(MaxTransferBytesPerTick, TransferChunkSize, [&]() {
+            //Leave space for other control messages, overflowing reliable buffer would close the connection
+            return ControlChannel != nullptr && ControlChannel->NumOutRec < RELIABLE_BUFFER / 2 && Connection->IsNetReady(false);
+        }, [&](const FOutgoingModTransfer& Transfer) {
+            uint16 ModIdIndex;
+            if (!GetOrAssignModIdIndex(Connection, Transfer.MessageType.ModReference, ModIdIndex)) {
+                UE_LOG(LogModNetworkHandler, Error, TEXT("Dropping transfer %d of %s:%d"), Transfer.TransferId, *Transfer.MessageType.ModReference, Transfer.MessageType.MessageId);
+                return false;
+            }
+            int32 TransferId = Transfer.TransferId;
+            int32 MessageId = Transfer.MessageType.MessageId;
+            int32 TotalSize = Transfer.Data.Num();
+            FNetControlMessage<NMT_ModTransferStart>::Send(Connection, TransferId, ModIdIndex, MessageId, TotalSize);
+            return true;
+        }, [&](int32 TransferId, const TArray<uint8>& Chunk) {
+            //Control message Send takes parameters by reference, but never modifies them when writing
+            FNetControlMessage<NMT_ModTransferChunk>::Send(Connection, TransferId, const_cast<TArray<uint8>&>(Chunk));
+        });
+        if (BytesSentThisTick > 0) {
+            QueueConnectionFlush(Connection);
+        }
+    }
+}
+
+const FMessageEntry* UModNetworkHandler::FindMessageEntry(UNetConnection* Connection, const FString& ModId, int32 MessageId) const {
     const TMap<int32, FMessageEntry>* Result = MessageHandlers.Find(ModId);
     if (Result != nullptr) {
         const FMessageEntry* MessageEntry = Result->Find(MessageId);
@@ -40,10 +223,113 @@ void UModNetworkHandler::ReceiveMessage(UNetConnection* Connection, const FStrin
             const bool bIsClientSide = Connection->ClientLoginState == EClientLoginState::Invalid;
             const bool bCanBeHandled = (bIsClientSide && MessageEntry->bClientHandled) || (!bIsClientSide && MessageEntry->bServerHandled);
             if (bCanBeHandled) {
-                MessageEntry->MessageReceived.ExecuteIfBound(Connection, Content);
+                return MessageEntry;
             }
         }
     }
+    return nullptr;
+}
+
+void UModNetworkHandler::ReceiveMessage(UNetConnection* Connection, const FString& ModId, int32 MessageId, const FString& Content) const {
+    const FMessageEntry* MessageEntry = FindMessageEntry(Connection, ModId, MessageId);
+    if (MessageEntry != nullptr) {
+        MessageEntry->MessageReceived.ExecuteIfBound(Connection, Content);
+    }
+}
+
+void UModNetworkHandler::ReceiveBinaryMessage(UNetConnection* Connection, uint16 ModIdIndex, int32 MessageId, const TArray<uint8>& Content) {
+    if (Content.Num() > MaxBinaryMessageSize) {
+        UE_LOG(LogModNetworkHandler, Warning, TEXT("Received binary message of %d bytes, which exceeds the size limit"), Content.Num());
+        return;
+    }
+    const FModConnectionState* ConnectionState = ConnectionStates.Find(Connection);
+    if (ConnectionState == nullptr || !ConnectionState->IncomingModIds.IsValidIndex(ModIdIndex)) {
+        UE_LOG(LogModNetworkHandler, Warning, TEXT("Received binary message with unknown mod ID index %d"), ModIdIndex);
+        return;
+    }
+    const FMessageEntry* MessageEntry = FindMessageEntry(Connection, ConnectionState->IncomingModIds[ModIdIndex], MessageId);
+    if (MessageEntry != nullptr) {
+        MessageEntry->BinaryMessageReceived.ExecuteIfBound(Connection, Content);
+    }
+}
+
+void UModNetworkHandler::ReceiveModIdAssignment(UNetConnection* Connection, uint16 ModIdIndex, const FString& ModId) {
+    FModConnectionState& ConnectionState = ConnectionStates.FindOrAdd(Connection);
+    //Indices are assigned sequentially by the remote side, so anything else is a malformed message
+    if (ModIdIndex != ConnectionState.IncomingModIds.Num()) {
+        UE_LOG(LogModNetworkHandler, Warning, TEXT("Received out of order mod ID assignment %d for %s"), ModIdIndex, *ModId);
+        return;
+    }
+    ConnectionState.IncomingModIds.Add(ModId);
+}
+
+void UModNetworkHandler::ReceiveTransferStart(UNetConnection* Connection, int32 TransferId, uint16 ModIdIndex, int32 MessageId, int32 TotalSize) {
+    FModConnectionState& ConnectionState = ConnectionStates.FindOrAdd(Connection);
+    if (!ConnectionState.IncomingModIds.IsValidIndex(ModIdIndex) || TotalSize < 0 || TotalSize > MaxIncomingTransferSize) {
+        UE_LOG(LogModNetworkHandler, Warning, TEXT("Rejecting transfer %d with mod ID index %d and size %d"), TransferId, ModIdIndex, TotalSize);
+        return;
+    }
+    //Transfer IDs are assigned sequentially by the remote side, so duplicate ID means a malformed message
+    if (ConnectionState.IncomingTransfers.Contains(TransferId)) {
+        UE_LOG(LogModNetworkHandler, Warning, TEXT("Rejecting transfer %d, transfer with the same ID is already in progress"), TransferId);
+        return;
+    }
+    //Control messages are accepted before login, so limit the memory a single connection can make us buffer
+    if (ConnectionState.IncomingTransfers.Num() >= MaxConcurrentIncomingTransfers ||
+        ConnectionState.IncomingTransferBytes + TotalSize > MaxIncomingTransferBytesPerConnection) {
+        UE_LOG(LogModNetworkHandler, Warning, TEXT("Rejecting transfer %d of size %d, connection has too many transfers in progress"), TransferId, TotalSize);
+        return;
+    }
+    ConnectionState.IncomingTransferBytes += TotalSize;
+    FIncomingModTransfer& Transfer = ConnectionState.IncomingTransfers.Add(TransferId);
+    Transfer.ModId = ConnectionState.IncomingModIds[ModIdIndex];
+    Transfer.MessageId = MessageId;
+    Transfer.TotalSize = TotalSize;
+    //Memory is reserved as chunks arrive, so announced size alone cannot make us allocate a lot
+    Transfer.Data.Reserve(FMath::Min(TotalSize, MaxTransferBytesPerTick));
+
+    if (TotalSize == 0) {
+        ReceiveTransferChunk(Connection, TransferId, TArray<uint8>());
+    }
+}
+
+void UModNetworkHandler::ReceiveTransferChunk(UNetConnection* Connection, int32 TransferId, const TArray<uint8>& Chunk) {
+    FModConnectionState* ConnectionState = ConnectionStates.Find(Connection);
+    FIncomingModTransfer* Transfer = ConnectionState ? ConnectionState->IncomingTransfers.Find(TransferId) : nullptr;
+    if (Transfer == nullptr) {
+        //Chunks of rejected transfers are silently dropped
+        return;
+    }
+    if (Transfer->Data.Num() + Chunk.Num() > Transfer->TotalSize) {
+        UE_LOG(LogModNetworkHandler, Warning, TEXT("Transfer %d received more data than announced, dropping it"), TransferId);
+        RemoveIncomingTransfer(*ConnectionState, TransferId);
+        return;
+    }
+    Transfer->Data.Append(Chunk);
+
+    if (Transfer->Data.Num() == Transfer->TotalSize) {
+        const FIncomingModTransfer CompletedTransfer = MoveTemp(*Transfer);
+        RemoveIncomingTransfer(*ConnectionState, TransferId);
+        const FMessageEntry* MessageEntry = FindMessageEntry(Connection, CompletedTransfer.ModId, CompletedTransfer.MessageId);
+        if (MessageEntry != nullptr) {
+            MessageEntry->BinaryMessageReceived.ExecuteIfBound(Connection, CompletedTransfer.Data);
+        }
+    }
+}
+
+void UModNetworkHandler::ReceiveTransferCancel(UNetConnection* Connection, int32 TransferId) {
+    FModConnectionState* ConnectionState = ConnectionStates.Find(Connection);
+    if (ConnectionState != nullptr) {
+        RemoveIncomingTransfer(*ConnectionState, TransferId);
+    }
+}
+
+void UModNetworkHandler::RemoveIncomingTransfer(FModConnectionState& ConnectionState, int32 TransferId) {
+    const FIncomingModTransfer* Transfer = ConnectionState.IncomingTransfers.Find(TransferId);
+    if (Transfer != nullptr) {
+        ConnectionState.IncomingTransferBytes -= Transfer->TotalSize;
+        ConnectionState.IncomingTransfers.Remove(TransferId);
+    }
 }
 
 UObjectMetadata* UModNetworkHandler::GetMetadataForConnection(UNetConnection* Connection) {
@@ -57,11 +343,25 @@ UObjectMetadata* UModNetworkHandler::GetMetadataForConnection(UNetConnection* Co
     return *ObjectMetadata;
 }
 
+bool UModNetworkHandler::ReceiveBinaryPayload(FBitReader& Reader, int32 MaxPayloadSize, TArray<uint8>& OutPayload) {
+    int32 PayloadSize = 0;
+    Reader << PayloadSize;
+    if (Reader.IsError() || PayloadSize < 0 || PayloadSize > MaxPayloadSize || PayloadSize > Reader.GetBytesLeft()) {
+        Reader.SetError();
+        return false;
+    }
+    OutPayload.SetNumUninitialized(PayloadSize);
+    Reader.Serialize(OutPayload.GetData(), PayloadSize);
+    return !Reader.IsError();
+}
+
 void UModNetworkHandler::InitializePatches() {
     UNetConnection* NetConnectionInstance = GetMutableDefault<UNetConnection>();
     SUBSCRIBE_METHOD_VIRTUAL_AFTER(UNetConnection::CleanUp, NetConnectionInstance, [=](UNetConnection* Connection) {
         UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
         NetworkHandler->Metadata.Remove(Connection);
+        NetworkHandler->ConnectionStates.Remove(Connection);
+        NetworkHandler->ConnectionsPendingFlush.Remove(Connection);
     });
     UWorld* WorldObjectInstance = GetMutableDefault<UWorld>();
     SUBSCRIBE_METHOD_VIRTUAL_AFTER(UWorld::WelcomePlayer, WorldObjectInstance, [=](UWorld* ServerWorld, UNetConnection* Connection) {
@@ -78,13 +378,62 @@ void UModNetworkHandler::InitializePatches() {
         }
     });
     auto MessageHandler = [=](auto& Call, void*, UNetConnection* Connection, uint8 MessageType, class FInBunch& Bunch) {
-        if (MessageType == NMT_ModMessage) {
+        if (MessageType == NMT_Hello) {
+            //Not cancelled, engine still handles the message and replies with the challenge after the messages sent by delegates
+            UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+            NetworkHandler->OnClientHelloReceived().Broadcast(Connection);
+        } else if (MessageType == NMT_Challenge) {
+            UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+            NetworkHandler->OnServerChallengeReceived().Broadcast(Connection);
+        } else if (MessageType == NMT_ModMessage) {
             FString ModId; int32 MessageId; FString Content;
             if (FNetControlMessage<NMT_ModMessage>::Receive(Bunch, ModId, MessageId, Content)) {
                 UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
                 NetworkHandler->ReceiveMessage(Connection, ModId, MessageId, Content);
                 Call.Cancel();
             }
+        } else if (MessageType == NMT_ModMessageId) {
+            uint16 ModIdIndex; FString ModId;
+            if (FNetControlMessage<NMT_ModMessageId>::Receive(Bunch, ModIdIndex, ModId)) {
+                UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+                NetworkHandler->ReceiveModIdAssignment(Connection, ModIdIndex, ModId);
+                Call.Cancel();
+            }
+        } else if (MessageType == NMT_ModBinaryMessage) {
+            uint16 ModIdIndex; int32 MessageId; TArray<uint8> Content;
+            //Payload is read manually instead of through FNetControlMessage::Receive to reject oversized payloads before allocating them
+            Bunch << ModIdIndex << MessageId;
+            if (!Bunch.IsError() && UModNetworkHandler::ReceiveBinaryPayload(Bunch, UModNetworkHandler::MaxBinaryMessageSize, Content)) {
+                UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+                NetworkHandler->ReceiveBinaryMessage(Connection, ModIdIndex, MessageId, Content);
+            } else {
+                UE_LOG(LogModNetworkHandler, Warning, TEXT("Received malformed or oversized binary message"));
+            }
+            Call.Cancel();
+        } else if (MessageType == NMT_ModTransferStart) {
+            int32 TransferId; uint16 ModIdIndex; int32 MessageId; int32 TotalSize;
+            if (FNetControlMessage<NMT_ModTransferStart>::Receive(Bunch, TransferId, ModIdIndex, MessageId, TotalSize)) {
+                UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+                NetworkHandler->ReceiveTransferStart(Connection, TransferId, ModIdIndex, MessageId, TotalSize);
+                Call.Cancel();
+            }
+        } else if (MessageType == NMT_ModTransferChunk) {
+            int32 TransferId; TArray<uint8> Chunk;
+            Bunch << TransferId;
+            if (!Bunch.IsError() && UModNetworkHandler::ReceiveBinaryPayload(Bunch, UModNetworkHandler::TransferChunkSize, Chunk)) {
+                UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+                NetworkHandler->ReceiveTransferChunk(Connection, TransferId, Chunk);
+            } else {
+                UE_LOG(LogModNetworkHandler, Warning, TEXT("Received malformed or oversized transfer chunk"));
+            }
+            Call.Cancel();
+        } else if (MessageType == NMT_ModTransferCancel) {
+            int32 TransferId;
+            if (FNetControlMessage<NMT_ModTransferCancel>::Receive(Bunch, TransferId)) {
+                UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+                NetworkHandler->ReceiveTransferCancel(Connection, TransferId);
+                Call.Cancel();
+            }
         }
     };
 
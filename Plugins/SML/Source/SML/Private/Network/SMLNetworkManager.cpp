@@ -4,10 +4,20 @@
 #include "Util/ObjectMetadata.h"
 #include "Network/SMLConnection/SMLConnectionMetadata.h"
 #include "Player/SMLRemoteCallObject.h"
+#include "Registry/RemoteCallObjectRegistry.h"
 #include "GameFramework/GameModeBase.h"
 #include "ModLoading/ModLoadingLibrary.h"
+#include "SatisfactoryModLoader.h"
+#include "Hash/CityHash.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 TSharedPtr<FMessageType> FSMLNetworkManager::MessageTypeModInit = NULL;
+TSharedPtr<FMessageType> FSMLNetworkManager::MessageTypeModListHash = NULL;
+TSharedPtr<FMessageType> FSMLNetworkManager::MessageTypeModListRequest = NULL;
+TSharedPtr<FMessageType> FSMLNetworkManager::MessageTypeModListCompressed = NULL;
+TSharedPtr<FMessageType> FSMLNetworkManager::MessageTypeModListHashSupported = NULL;
 
 void FSMLNetworkManager::RegisterMessageTypeAndHandlers() {
     UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
@@ -17,7 +27,31 @@ void FSMLNetworkManager::RegisterMessageTypeAndHandlers() {
     MessageEntry.bServerHandled = true;
     
     MessageEntry.MessageReceived.BindStatic(FSMLNetworkManager::HandleMessageReceived);
-    NetworkHandler->OnClientInitialJoin().AddStatic(FSMLNetworkManager::HandleInitialClientJoin);
+
+    //Hash based handshake, full mod list is only transferred when client mod list differs from the server one
+    MessageTypeModListHash = MakeShareable(new FMessageType{TEXT("SML"), 2});
+    FMessageEntry& HashMessageEntry = NetworkHandler->RegisterMessageType(*MessageTypeModListHash);
+    HashMessageEntry.bServerHandled = true;
+    HashMessageEntry.BinaryMessageReceived.BindStatic(FSMLNetworkManager::HandleModListHashReceived);
+
+    MessageTypeModListRequest = MakeShareable(new FMessageType{TEXT("SML"), 3});
+    FMessageEntry& RequestMessageEntry = NetworkHandler->RegisterMessageType(*MessageTypeModListRequest);
+    RequestMessageEntry.bClientHandled = true;
+    RequestMessageEntry.BinaryMessageReceived.BindStatic(FSMLNetworkManager::HandleModListRequestReceived);
+
+    MessageTypeModListCompressed = MakeShareable(new FMessageType{TEXT("SML"), 4});
+    FMessageEntry& CompressedMessageEntry = NetworkHandler->RegisterMessageType(*MessageTypeModListCompressed);
+    CompressedMessageEntry.bServerHandled = true;
+    CompressedMessageEntry.BinaryMessageReceived.BindStatic(FSMLNetworkManager::HandleCompressedModListReceived);
+
+    //Sent as a plain mod message, so older clients not aware of it silently ignore it and keep sending the json mod list
+    MessageTypeModListHashSupported = MakeShareable(new FMessageType{TEXT("SML"), 5});
+    FMessageEntry& HashSupportedMessageEntry = NetworkHandler->RegisterMessageType(*MessageTypeModListHashSupported);
+    HashSupportedMessageEntry.bClientHandled = true;
+    HashSupportedMessageEntry.MessageReceived.BindStatic(FSMLNetworkManager::HandleModListHashSupportedReceived);
+
+    NetworkHandler->OnClientHelloReceived().AddStatic(FSMLNetworkManager::HandleClientHello);
+    NetworkHandler->OnServerChallengeReceived().AddStatic(FSMLNetworkManager::HandleServerChallenge);
     NetworkHandler->OnWelcomePlayer().AddStatic(FSMLNetworkManager::HandleWelcomePlayer);
     FGameModeEvents::GameModePostLoginEvent.AddStatic(FSMLNetworkManager::HandleGameModePostLogin);
 }
@@ -27,18 +61,101 @@ void FSMLNetworkManager::HandleMessageReceived(UNetConnection* Connection, FStri
     UObjectMetadata* Metadata = NetworkHandler->GetMetadataForConnection(Connection);
     USMLConnectionMetadata* SMLMetadata = Metadata->GetOrCreateSubObject<USMLConnectionMetadata>(TEXT("SML"));
     SMLMetadata->bIsInitialized = true;
-    if (!HandleModListObject(SMLMetadata, Data)) {
+    FinishModListReceived(Connection, SMLMetadata, HandleModListObject(SMLMetadata, Data));
+}
+
+void FSMLNetworkManager::HandleModListHashReceived(UNetConnection* Connection, const TArray<uint8>& Data) {
+    UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+    UObjectMetadata* Metadata = NetworkHandler->GetMetadataForConnection(Connection);
+    USMLConnectionMetadata* SMLMetadata = Metadata->GetOrCreateSubObject<USMLConnectionMetadata>(TEXT("SML"));
+
+    FMemoryReader HashReader(Data);
+    uint64 ClientModListHash = 0;
+    HashReader << ClientModListHash;
+    if (HashReader.IsError()) {
+        Connection->Close();
+        return;
+    }
+    SMLMetadata->bIsInitialized = true;
+    
+    TMap<FString, FVersion> LocalModVersions = GetLocalModVersions();
+    if (ClientModListHash == ComputeModListHash(LocalModVersions)) {
+        //Client has exactly the same mods as we do, so there is no need to transfer the list
+        SMLMetadata->InstalledClientMods = MoveTemp(LocalModVersions);
+        UE_LOG(LogSatisfactoryModLoader, Verbose, TEXT("Client mod list hash matches, handshake took %d bytes"), Data.Num());
+        return;
+    }
+    SMLMetadata->bAwaitingFullModList = true;
+    UModNetworkHandler::SendBinaryMessage(Connection, *MessageTypeModListRequest, TArray<uint8>());
+}
+
+void FSMLNetworkManager::HandleModListRequestReceived(UNetConnection* Connection, const TArray<uint8>& Data) {
+    const TArray<uint8> CompressedModList = SerializeCompressedModList(GetLocalModVersions());
+    if (CompressedModList.Num() <= UModNetworkHandler::MaxBinaryMessageSize) {
+        UModNetworkHandler::SendBinaryMessage(Connection, *MessageTypeModListCompressed, CompressedModList);
+        UE_LOG(LogSatisfactoryModLoader, Verbose, TEXT("Server requested full mod list, sent %d compressed bytes"), CompressedModList.Num());
+    } else {
+        //Mod list does not fit into the single binary message, fall back to the json mod list
+        UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+        NetworkHandler->SendMessage(Connection, *MessageTypeModInit, SerializeLocalModList());
+    }
+}
+
+void FSMLNetworkManager::HandleCompressedModListReceived(UNetConnection* Connection, const TArray<uint8>& Data) {
+    UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+    UObjectMetadata* Metadata = NetworkHandler->GetMetadataForConnection(Connection);
+    USMLConnectionMetadata* SMLMetadata = Metadata->GetOrCreateSubObject<USMLConnectionMetadata>(TEXT("SML"));
+    SMLMetadata->bIsInitialized = true;
+    FinishModListReceived(Connection, SMLMetadata, HandleCompressedModList(SMLMetadata, Data));
+}
+
+void FSMLNetworkManager::FinishModListReceived(UNetConnection* Connection, USMLConnectionMetadata* Metadata, bool bModListValid) {
+    if (!bModListValid) {
         Connection->Close();
+        return;
+    }
+    Metadata->bAwaitingFullModList = false;
+    if (Metadata->bValidationDeferred) {
+        Metadata->bValidationDeferred = false;
+        ValidateSMLConnectionData(Connection);
     }
 }
 
-void FSMLNetworkManager::HandleInitialClientJoin(UNetConnection* Connection) {
+void FSMLNetworkManager::HandleClientHello(UNetConnection* Connection) {
+    //Announced before the challenge, so client knows which handshake to use before it logs in
+    UModNetworkHandler::SendMessage(Connection, *MessageTypeModListHashSupported, FString());
+}
+
+void FSMLNetworkManager::HandleModListHashSupportedReceived(UNetConnection* Connection, FString Data) {
     UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
-    const FString LocalModList = SerializeLocalModList();
-    NetworkHandler->SendMessage(Connection, *MessageTypeModInit, LocalModList);
+    UObjectMetadata* Metadata = NetworkHandler->GetMetadataForConnection(Connection);
+    USMLConnectionMetadata* SMLMetadata = Metadata->GetOrCreateSubObject<USMLConnectionMetadata>(TEXT("SML"));
+    SMLMetadata->bServerSupportsModListHash = true;
+    
+    UModNetworkHandler::SendBinaryMessage(Connection, *MessageTypeModListHash, SerializeModListHash(GetLocalModVersions()));
+}
+
+void FSMLNetworkManager::HandleServerChallenge(UNetConnection* Connection) {
+    UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+    UObjectMetadata* Metadata = NetworkHandler->GetMetadataForConnection(Connection);
+    USMLConnectionMetadata* SMLMetadata = Metadata->GetOrCreateSubObject<USMLConnectionMetadata>(TEXT("SML"));
+
+    //Server has not announced hash handshake support, so it is an older one which only understands the json mod list
+    if (!SMLMetadata->bServerSupportsModListHash) {
+        NetworkHandler->SendMessage(Connection, *MessageTypeModInit, SerializeLocalModList());
+    }
 }
 
 void FSMLNetworkManager::HandleWelcomePlayer(UWorld* World, UNetConnection* Connection) {
+    UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
+    UObjectMetadata* Metadata = NetworkHandler->GetMetadataForConnection(Connection);
+    USMLConnectionMetadata* SMLMetadata = Metadata->GetOrCreateSubObject<USMLConnectionMetadata>(TEXT("SML"));
+    
+    //Full mod list might still be on the way, it is guaranteed to arrive before NMT_Join since client sends it first
+    if (SMLMetadata->bAwaitingFullModList) {
+        SMLMetadata->bValidationDeferred = true;
+        return;
+    }
     ValidateSMLConnectionData(Connection);
 }
 
@@ -46,14 +163,14 @@ void FSMLNetworkManager::HandleGameModePostLogin(AGameModeBase* GameMode, APlaye
     UModNetworkHandler* NetworkHandler = GEngine->GetEngineSubsystem<UModNetworkHandler>();
     AFGPlayerController* CastedPlayerController = Cast<AFGPlayerController>(Controller);
     if (CastedPlayerController) {
-        USMLRemoteCallObject* RemoteCallObject = Cast<USMLRemoteCallObject>(CastedPlayerController->GetRemoteCallObjectOfClass(USMLRemoteCallObject::StaticClass()));
+        USMLRemoteCallObject* RemoteCallObject = URemoteCallObjectRegistry::GetPlayerRemoteCallObject<USMLRemoteCallObject>(CastedPlayerController);
 
         if (CastedPlayerController->IsLocalController()) {
             //This is a local player, so installed mods are our local mod list
             UModLoadingLibrary* ModLoadingLibrary = GEngine->GetEngineSubsystem<UModLoadingLibrary>();
-            const TArray<FModInfo> Mods = ModLoadingLibrary->GetLoadedMods();
+            const TSharedRef<const FLoadedModList, ESPMode::ThreadSafe> ModList = ModLoadingLibrary->GetLoadedModList();
             
-            for (const FModInfo& ModInfo : Mods) {
+            for (const FModInfo& ModInfo : ModList->Mods) {
                 RemoteCallObject->ClientInstalledMods.Add(ModInfo.Name, ModInfo.Version);
             }
         } else {
@@ -61,19 +178,26 @@ void FSMLNetworkManager::HandleGameModePostLogin(AGameModeBase* GameMode, APlaye
             UNetConnection* NetConnection = CastChecked<UNetConnection>(Controller->Player);
             UObjectMetadata* Metadata = NetworkHandler->GetMetadataForConnection(NetConnection);
             USMLConnectionMetadata* SMLMetadata = Metadata->GetOrCreateSubObject<USMLConnectionMetadata>(TEXT("SML"));
+
+            //Client has reported a different mod list hash, but has never sent the full mod list, so it has not been validated
+            if (SMLMetadata->bAwaitingFullModList) {
+                UModNetworkHandler::CloseWithFailureMessage(NetConnection, TEXT("Client has not sent its mod list before joining the game."));
+                return;
+            }
             RemoteCallObject->ClientInstalledMods.Append(SMLMetadata->InstalledClientMods);
         }
     }
 }
 
 FString FSMLNetworkManager::SerializeLocalModList() {
-    TSharedRef<FJsonObject> ModListObject = MakeShareable(new FJsonObject());
+    return SerializeModList(GetLocalModVersions());
+}
 
-    UModLoadingLibrary* ModLoadingLibrary = GEngine->GetEngineSubsystem<UModLoadingLibrary>();
-    const TArray<FModInfo> Mods = ModLoadingLibrary->GetLoadedMods();
+FString FSMLNetworkManager::SerializeModList(const TMap<FString, FVersion>& ModVersions) {
+    TSharedRef<FJsonObject> ModListObject = MakeShareable(new FJsonObject());
     
-    for (const FModInfo& ModInfo : Mods) {
-        ModListObject->SetStringField(ModInfo.Name, ModInfo.Version.ToString());
+    for (const TPair<FString, FVersion>& Pair : ModVersions) {
+        ModListObject->SetStringField(Pair.Key, Pair.Value.ToString());
     }
 
     TSharedRef<FJsonObject> MetadataObject = MakeShareable(new FJsonObject());
@@ -86,6 +210,101 @@ FString FSMLNetworkManager::SerializeLocalModList() {
     return ResultString;
 }
 
+TMap<FString, FVersion> FSMLNetworkManager::GetLocalModVersions() {
+    UModLoadingLibrary* ModLoadingLibrary = GEngine->GetEngineSubsystem<UModLoadingLibrary>();
+    const TSharedRef<const FLoadedModList, ESPMode::ThreadSafe> ModList = ModLoadingLibrary->GetLoadedModList();
+
+    TMap<FString, FVersion> ModVersions;
+    ModVersions.Reserve(ModList->Mods.Num());
+    for (const FModInfo& ModInfo : ModList->Mods) {
+        ModVersions.Add(ModInfo.Name, ModInfo.Version);
+    }
+    return ModVersions;
+}
+
+uint64 FSMLNetworkManager::ComputeModListHash(const TMap<FString, FVersion>& ModVersions) {
+    TArray<FString> ModReferences;
+    ModVersions.GetKeys(ModReferences);
+    ModReferences.Sort([](const FString& A, const FString& B) {
+        return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+    });
+    
+    TArray<uint8> HashData;
+    FMemoryWriter HashWriter(HashData);
+    for (FString& ModReference : ModReferences) {
+        FString VersionString = ModVersions.FindChecked(ModReference).ToString();
+        HashWriter << ModReference;
+        HashWriter << VersionString;
+    }
+    return CityHash64(reinterpret_cast<const char*>(HashData.GetData()), HashData.Num());
+}
+
+TArray<uint8> FSMLNetworkManager::SerializeModListHash(const TMap<FString, FVersion>& ModVersions) {
+    TArray<uint8> ModListHash;
+    FMemoryWriter HashWriter(ModListHash);
+    uint64 ModListHashValue = ComputeModListHash(ModVersions);
+    HashWriter << ModListHashValue;
+    return ModListHash;
+}
+
+TArray<uint8> FSMLNetworkManager::SerializeCompressedModList(const TMap<FString, FVersion>& ModVersions) {
+    TArray<uint8> ModListData;
+    FMemoryWriter ModListWriter(ModListData);
+    int32 NumMods = ModVersions.Num();
+    ModListWriter << NumMods;
+    for (const TPair<FString, FVersion>& Pair : ModVersions) {
+        FString ModReference = Pair.Key;
+        FString VersionString = Pair.Value.ToString();
+        ModListWriter << ModReference;
+        ModListWriter << VersionString;
+    }
+
+    TArray<uint8> Result;
+    FMemoryWriter ResultWriter(Result);
+    int32 UncompressedSize = ModListData.Num();
+    ResultWriter << UncompressedSize;
+    const int32 HeaderSize = Result.Num();
+    
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+    Result.AddUninitialized(CompressedSize);
+    verify(FCompression::CompressMemory(NAME_Zlib, Result.GetData() + HeaderSize, CompressedSize, ModListData.GetData(), UncompressedSize));
+    Result.SetNum(HeaderSize + CompressedSize);
+    return Result;
+}
+
+bool FSMLNetworkManager::HandleCompressedModList(USMLConnectionMetadata* Metadata, const TArray<uint8>& CompressedModList) {
+    FMemoryReader HeaderReader(CompressedModList);
+    int32 UncompressedSize = 0;
+    HeaderReader << UncompressedSize;
+    if (HeaderReader.IsError() || UncompressedSize < 0 || UncompressedSize > MaxUncompressedModListSize) {
+        return false;
+    }
+    const int32 HeaderSize = HeaderReader.Tell();
+    TArray<uint8> ModListData;
+    ModListData.SetNumUninitialized(UncompressedSize);
+    if (!FCompression::UncompressMemory(NAME_Zlib, ModListData.GetData(), UncompressedSize, CompressedModList.GetData() + HeaderSize, CompressedModList.Num() - HeaderSize)) {
+        return false;
+    }
+
+    FMemoryReader ModListReader(ModListData);
+    int32 NumMods = 0;
+    ModListReader << NumMods;
+    for (int32 i = 0; i < NumMods && !ModListReader.IsError(); i++) {
+        FString ModReference;
+        FString VersionString;
+        ModListReader << ModReference;
+        ModListReader << VersionString;
+        
+        FVersion ModVersion = FVersion{};
+        FString ErrorMessage;
+        if (ModListReader.IsError() || !ModVersion.ParseVersion(VersionString, ErrorMessage)) {
+            return false;
+        }
+        Metadata->InstalledClientMods.Add(ModReference, ModVersion);
+    }
+    return !ModListReader.IsError();
+}
+
 bool FSMLNetworkManager::HandleModListObject(USMLConnectionMetadata* Metadata, const FString& ModListString) {
     const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ModListString);
     TSharedPtr<FJsonObject> MetadataObject;
@@ -126,9 +345,9 @@ void FSMLNetworkManager::ValidateSMLConnectionData(UNetConnection* Connection) {
     }
 
     UModLoadingLibrary* ModLoadingLibrary = GEngine->GetEngineSubsystem<UModLoadingLibrary>();
-    const TArray<FModInfo> Mods = ModLoadingLibrary->GetLoadedMods();
+    const TSharedRef<const FLoadedModList, ESPMode::ThreadSafe> ModList = ModLoadingLibrary->GetLoadedModList();
     
-    for (const FModInfo& ModInfo : Mods) {
+    for (const FModInfo& ModInfo : ModList->Mods) {
         if (ModInfo.bAcceptsAnyRemoteVersion) {
             continue; //Server-side only mod
         }
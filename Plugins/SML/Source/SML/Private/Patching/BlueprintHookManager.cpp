@@ -4,6 +4,7 @@
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "Toolkit/KismetBytecodeDisassemblerJson.h"
+#include "Toolkit/KismetBytecodeStatementIndex.h"
 
 //Whenever to debug blueprint hooking. When enabled, JSON files with script bytecode before and after installing hook will be generated
 #define DEBUG_BLUEPRINT_HOOKING 0
@@ -46,7 +47,7 @@ void UBlueprintHookManager::InstallBlueprintHook(UFunction* Function, int32 Hook
 	//Minimum amount of bytes required to insert unconditional jump with code offset
 	const int32 MinBytesRequired = 1 + sizeof(CodeSkipSizeType);
 
-	FKismetBytecodeDisassemblerJson Disassembler;
+	const TSharedRef<const FKismetBytecodeStatementIndex> StatementIndex = FKismetBytecodeStatementIndex::GetStatementIndex(Function);
 	int32 BytesAvailable = 0;
 	
 	//Walk over statements until we collect enough bytes for a replacement
@@ -55,7 +56,7 @@ void UBlueprintHookManager::InstallBlueprintHook(UFunction* Function, int32 Hook
 		const int32 CurrentStatementIndex = HookOffset + BytesAvailable;
 		int32 OutStatementLength;
 		
-		const bool bValid = Disassembler.GetStatementLength(Function, CurrentStatementIndex, OutStatementLength);
+		const bool bValid = StatementIndex->GetStatementLength(CurrentStatementIndex, OutStatementLength);
 		checkf(bValid, TEXT("Provided hook offset is not a valid statement index: %d"), HookOffset);
 		BytesAvailable += OutStatementLength;
 	}
@@ -114,6 +115,9 @@ void UBlueprintHookManager::InstallBlueprintHook(UFunction* Function, int32 Hook
 	OriginalCode[HookOffset] = EX_Jump;
 	FPlatformMemory::WriteUnaligned<CodeSkipSizeType>(&OriginalCode[HookOffset + 1], StartOfAppendedCode);
 
+	//Script has been rewritten, so cached statement index is no longer valid
+	FKismetBytecodeStatementIndex::InvalidateStatementIndex(Function);
+
 #if DEBUG_BLUEPRINT_HOOKING
 	DebugDumpFunctionScriptCode(Function, HookOffset, TEXT("AfterHook"));
 #endif
@@ -124,10 +128,8 @@ int32 UBlueprintHookManager::PreProcessHookOffset(UFunction* Function, int32 Hoo
 		//For now Kismet Compiler will always generate only one Return node, so all
 		//execution paths will end up either with executing it directly or jumping to it
 		//So we need to hook only in one place to handle all possible execution paths
-		FKismetBytecodeDisassemblerJson Disassembler;
-		int32 ReturnOffset;
-		const bool bIsValid = Disassembler.FindFirstStatementOfType(Function, 0, EX_Return, ReturnOffset);
-		checkf(bIsValid, TEXT("EX_Return not found for function %s"), *Function->GetPathName());
+		const int32 ReturnOffset = FKismetBytecodeStatementIndex::GetStatementIndex(Function)->GetFirstReturnStatementOffset();
+		checkf(ReturnOffset != INDEX_NONE, TEXT("EX_Return not found for function %s"), *Function->GetPathName());
 		return ReturnOffset;
 	}
 	return HookOffset;
@@ -142,10 +144,7 @@ void FFunctionHookInfo::InvokeBlueprintHook(FFrame& Frame, int32 HookOffset) {
 }
 
 void FFunctionHookInfo::RecalculateReturnStatementOffset(UFunction* Function) {
-	FKismetBytecodeDisassemblerJson Disassembler;
-	int32 ReturnInstructionOffset;
-	Disassembler.FindFirstStatementOfType(Function, 0, EX_Return, ReturnInstructionOffset);
-	this->ReturnStatementOffset = ReturnInstructionOffset;
+	this->ReturnStatementOffset = FKismetBytecodeStatementIndex::GetStatementIndex(Function)->GetFirstReturnStatementOffset();
 }
 
 void UBlueprintHookManager::HookBlueprintFunction(UFunction* Function, const TFunction<HookFunctionSignature>& Hook, int32 HookOffset) {
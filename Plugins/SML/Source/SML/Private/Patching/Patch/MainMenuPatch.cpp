@@ -25,7 +25,7 @@ UWidget* CreateModSubMenuWidget(UUserWidget* OwningWidget) {
 
 TArray<FString> FMainMenuPatch::CreateMenuInformationText() {
 	UModLoadingLibrary* ModLoadingLibrary = GEngine->GetEngineSubsystem<UModLoadingLibrary>();
-	const int32 ModsLoaded = ModLoadingLibrary->GetLoadedMods().Num();
+	const int32 ModsLoaded = ModLoadingLibrary->GetLoadedModList()->Mods.Num();
 	TArray<FString> ResultText;
 	
 	ResultText.Add(FString::Printf(TEXT("Satisfactory Mod Loader v.%s"), *FSatisfactoryModLoader::GetModLoaderVersion().ToString()));
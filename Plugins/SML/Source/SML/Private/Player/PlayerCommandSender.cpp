@@ -1,6 +1,7 @@
 #include "Player/PlayerCommandSender.h"
 #include "FGPlayerController.h"
 #include "Player/SMLRemoteCallObject.h"
+#include "Registry/RemoteCallObjectRegistry.h"
 
 FString UPlayerCommandSender::GetSenderName() const {
     AFGPlayerController* PlayerController = GetPlayer();
@@ -16,7 +17,7 @@ FString UPlayerCommandSender::GetSenderName() const {
 void UPlayerCommandSender::SendChatMessage(const FString& Message, const FLinearColor PrefixColor) {
     AFGPlayerController* PlayerController = GetPlayer();
     if (PlayerController != NULL) {
-        USMLRemoteCallObject* RemoteCallObject = Cast<USMLRemoteCallObject>(PlayerController->GetRemoteCallObjectOfClass(USMLRemoteCallObject::StaticClass()));
+        USMLRemoteCallObject* RemoteCallObject = URemoteCallObjectRegistry::GetPlayerRemoteCallObject<USMLRemoteCallObject>(PlayerController);
         if (RemoteCallObject != NULL) {
             RemoteCallObject->SendChatMessage(Message, PrefixColor);
         }
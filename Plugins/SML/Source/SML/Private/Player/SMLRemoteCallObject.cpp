@@ -47,7 +47,7 @@ void USMLRemoteCallObject::RegisterChatCommandPatch() {
 	SUBSCRIBE_METHOD(AFGPlayerController::EnterChatMessage, [](auto& Scope, AFGPlayerController* PlayerController, const FString& Message) {
     if (Message.StartsWith(TEXT("/"))) {
         const FString CommandLine = Message.TrimStartAndEnd().RightChop(1);
-        USMLRemoteCallObject* RemoteCallObject = Cast<USMLRemoteCallObject>(PlayerController->GetRemoteCallObjectOfClass(USMLRemoteCallObject::StaticClass()));
+        USMLRemoteCallObject* RemoteCallObject = URemoteCallObjectRegistry::GetPlayerRemoteCallObject<USMLRemoteCallObject>(PlayerController);
         if (RemoteCallObject != NULL) {
             RemoteCallObject->HandleChatCommand(CommandLine);
         }
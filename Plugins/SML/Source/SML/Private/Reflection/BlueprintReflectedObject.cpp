@@ -1,5 +1,8 @@
 #include "Reflection/BlueprintReflectedObject.h"
 #include "UObject/TextProperty.h"
+#include "Reflection/ReflectedPropertyCache.h"
+#include "Reflection/ReflectedFunctionCall.h"
+#include "Serialization/StructuredArchive.h"
 
 EReflectedPropertyType DeterminePropertyType(FProperty* Property);
 
@@ -166,6 +169,78 @@ void FReflectedObjectState_ScriptStruct::AddReferencedObjects(FReferenceCollecto
     }
 }
 
+FReflectedObjectState_FunctionCall::FReflectedObjectState_FunctionCall(UObject* Object, UFunction* Function) {
+    checkf(Object, TEXT("Cannot construct state without valid UObject"));
+    checkf(Function, TEXT("Cannot construct state with NULL function"));
+    this->ReferencedObject = Object;
+    this->Function = Function;
+    this->FunctionCall = MakeUnique<FReflectedFunctionCall>(Function);
+}
+
+FReflectedObjectState_FunctionCall::~FReflectedObjectState_FunctionCall() {
+}
+
+TArray<FReflectedPropertyInfo> FReflectedObjectState_FunctionCall::GetAllProperties() const {
+    TArray<FReflectedPropertyInfo> OutPropertyInfo;
+    for (int32 ParameterIndex = 0; ParameterIndex < FunctionCall->GetParameterCount(); ParameterIndex++) {
+        FProperty* Parameter = FunctionCall->GetParameter(ParameterIndex);
+        const EReflectedPropertyType PropertyType = DeterminePropertyType(Parameter);
+        if (PropertyType != EReflectedPropertyType::ERPT_Invalid) {
+            OutPropertyInfo.Add(FReflectedPropertyInfo{Parameter->GetFName(), PropertyType});
+        }
+    }
+    return OutPropertyInfo;
+}
+
+FProperty* FReflectedObjectState_FunctionCall::FindPropertyByName(FName PropertyName) const {
+    //Blueprint functions also contain local variables, which are not part of the parameter buffer
+    FProperty* Property = FReflectedPropertyCache::FindProperty(Function, PropertyName);
+    return Property != NULL && Property->HasAnyPropertyFlags(CPF_Parm) ? Property : NULL;
+}
+
+void* FReflectedObjectState_FunctionCall::GetPropertyValue(FName PropertyName) {
+    FProperty* Property = FindPropertyByName(PropertyName);
+    return Property != NULL ? Property->ContainerPtrToValuePtr<void>(FunctionCall->GetParameterBuffer()) : NULL;
+}
+
+UObject* FReflectedObjectState_FunctionCall::GetObjectPointer() const {
+    return ReferencedObject;
+}
+
+UStruct* FReflectedObjectState_FunctionCall::GetStructObject() const {
+    return Function;
+}
+
+void* FReflectedObjectState_FunctionCall::GetObjectData() {
+    return FunctionCall->GetParameterBuffer();
+}
+
+bool FReflectedObjectState_FunctionCall::RequiresBlueprintVisibleProperties() const {
+    return false;
+}
+
+bool FReflectedObjectState_FunctionCall::InvokeFunction() {
+    if (ReferencedObject == NULL) {
+        return false;
+    }
+    FunctionCall->Invoke(ReferencedObject);
+    return true;
+}
+
+void FReflectedObjectState_FunctionCall::AddReferencedObjects(FReferenceCollector& ReferenceCollector) {
+    ReferenceCollector.AddReferencedObject(ReferencedObject);
+    ReferenceCollector.AddReferencedObject(Function);
+    //Parameter values keep their values between invocations, so objects referenced by them have to be kept alive
+    for (int32 ParameterIndex = 0; ParameterIndex < FunctionCall->GetParameterCount(); ParameterIndex++) {
+        FProperty* Parameter = FunctionCall->GetParameter(ParameterIndex);
+        TArray<const FStructProperty*> EncounteredStructProperties;
+        if (Parameter->ContainsObjectReference(EncounteredStructProperties)) {
+            FStructuredArchiveFromArchive StructuredArchive(ReferenceCollector.GetVerySlowReferenceCollectorArchive());
+            Parameter->SerializeBinProperty(StructuredArchive.GetSlot(), FunctionCall->GetParameterBuffer());
+        }
+    }
+}
+
 TArray<FReflectedPropertyInfo> FReflectedObjectState::GetAllProperties() const {
     UStruct* ObjectStruct = GetStructObject();
     TArray<FReflectedPropertyInfo> OutPropertyInfo;
@@ -186,7 +261,7 @@ TArray<FReflectedPropertyInfo> FReflectedObjectState::GetAllProperties() const {
 FProperty* FReflectedObjectState::FindPropertyByName(FName PropertyName) const {
     UStruct* AssociatedStruct = GetStructObject();
     if (AssociatedStruct != NULL) {
-        return AssociatedStruct->FindPropertyByName(PropertyName);
+        return FReflectedPropertyCache::FindProperty(AssociatedStruct, PropertyName);
     }
     return NULL;
 }
@@ -195,7 +270,7 @@ void* FReflectedObjectState::GetPropertyValue(FName PropertyName) {
     UStruct* AssociatedStruct = GetStructObject();
     void* ObjectData = GetObjectData();
     if (AssociatedStruct != NULL && ObjectData != NULL) {
-        FProperty* Property = AssociatedStruct->FindPropertyByName(PropertyName);
+        FProperty* Property = FReflectedPropertyCache::FindProperty(AssociatedStruct, PropertyName);
         if (Property != NULL) {
             return Property->ContainerPtrToValuePtr<void>(ObjectData);
         }
@@ -233,6 +308,14 @@ void* FReflectedObjectState::GetObjectData() {
     return NULL;
 }
 
+bool FReflectedObjectState::RequiresBlueprintVisibleProperties() const {
+    return true;
+}
+
+bool FReflectedObjectState::InvokeFunction() {
+    return false;
+}
+
 FReflectedEnumValue::FReflectedEnumValue() : EnumerationType(NULL), RawEnumValue(0) {}
 
 FReflectedEnumValue::FReflectedEnumValue(UEnum* EnumType, int64 EnumValue) : EnumerationType(EnumType), RawEnumValue(EnumValue) {}
@@ -272,6 +355,18 @@ void FReflectedObject::SetupFromArray(const FReflectedObject& Object, const FNam
     }
 }
 
+void FReflectedObject::SetupFromFunctionCall(UObject* Object, FName FunctionName) {
+    checkf(Object, TEXT("Cannot setup function call on NULL UObject"));
+    UFunction* Function = FReflectedPropertyCache::FindFunction(Object->GetClass(), FunctionName);
+    if (Function != NULL) {
+        this->State = MakeShareable(new FReflectedObjectState_FunctionCall(Object, Function));
+    }
+}
+
+bool FReflectedObject::InvokeFunction() const {
+    return State.IsValid() ? State->InvokeFunction() : false;
+}
+
 UObject* FReflectedObject::GetWrappedObject() const {
     return State.IsValid() ? State->GetObjectPointer() : NULL;
 }
@@ -28,6 +28,17 @@ void UBlueprintReflectionLibrary::DeflectStruct(const FReflectedObject& Reflecte
     ReflectedObject.CopyWrappedStruct(StructInfo.Struct, StructInfo.StructValue);
 }
 
+FReflectedObject UBlueprintReflectionLibrary::PrepareFunctionCall(UObject* Object, FName FunctionName) {
+    checkf(Object, TEXT("Cannot prepare function call on NULL object"));
+    FReflectedObject ReflectedObject{};
+    ReflectedObject.SetupFromFunctionCall(Object, FunctionName);
+    return ReflectedObject;
+}
+
+bool UBlueprintReflectionLibrary::InvokeFunctionCall(const FReflectedObject& FunctionCall) {
+    return FunctionCall.InvokeFunction();
+}
+
 TArray<FReflectedPropertyInfo> UBlueprintReflectionLibrary::GetReflectedProperties(const FReflectedObject& ReflectedObject) {
     return ReflectedObject.GetReflectedProperties();
 }
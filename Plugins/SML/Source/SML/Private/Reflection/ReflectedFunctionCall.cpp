@@ -0,0 +1,115 @@
+#include "Reflection/ReflectedFunctionCall.h"
+#include "Misc/ScopeLock.h"
+
+/** Pooled buffers are bucketed by size rounded up to the alignment they are allocated with */
+static const uint32 PooledBufferAlignment = 16;
+static const int32 MaxPooledBufferSize = 4096;
+static const int32 MaxPooledBuffersPerSize = 8;
+
+static FCriticalSection ParameterBufferPoolLock;
+static TMap<int32, TArray<uint8*>> ParameterBufferPool;
+
+static int32 GetPooledBufferSize(int32 BufferSize) {
+    return Align(FMath::Max(BufferSize, 1), PooledBufferAlignment);
+}
+
+uint8* FReflectedFunctionCall::AllocateParameterBuffer(int32 BufferSize, uint32 BufferAlignment) {
+    const int32 PooledBufferSize = GetPooledBufferSize(BufferSize);
+    if (BufferAlignment <= PooledBufferAlignment && PooledBufferSize <= MaxPooledBufferSize) {
+        FScopeLock ScopeLock(&ParameterBufferPoolLock);
+        TArray<uint8*>* PooledBuffers = ParameterBufferPool.Find(PooledBufferSize);
+        if (PooledBuffers != NULL && PooledBuffers->Num() > 0) {
+            return PooledBuffers->Pop(false);
+        }
+        return static_cast<uint8*>(FMemory::Malloc(PooledBufferSize, PooledBufferAlignment));
+    }
+    //Allocate at least one byte so buffer is never NULL
+    return static_cast<uint8*>(FMemory::Malloc(FMath::Max(BufferSize, 1), BufferAlignment));
+}
+
+void FReflectedFunctionCall::ReleaseParameterBuffer(uint8* Buffer, int32 BufferSize, uint32 BufferAlignment) {
+    const int32 PooledBufferSize = GetPooledBufferSize(BufferSize);
+    if (BufferAlignment <= PooledBufferAlignment && PooledBufferSize <= MaxPooledBufferSize) {
+        FScopeLock ScopeLock(&ParameterBufferPoolLock);
+        TArray<uint8*>& PooledBuffers = ParameterBufferPool.FindOrAdd(PooledBufferSize);
+        if (PooledBuffers.Num() < MaxPooledBuffersPerSize) {
+            PooledBuffers.Add(Buffer);
+            return;
+        }
+    }
+    FMemory::Free(Buffer);
+}
+
+FReflectedFunctionCall::FReflectedFunctionCall(UFunction* Function) : Function(Function), ReturnValueIndex(INDEX_NONE), bNeedsDestruction(false), bIsInvoking(false) {
+    checkf(Function, TEXT("Cannot prepare call of NULL function"));
+    for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It) {
+        FProperty* Property = *It;
+        const bool bIsPlainOldData = Property->HasAnyPropertyFlags(CPF_IsPlainOldData);
+        Parameters.Add(FParameterInfo{Property, Property->GetOffset_ForUFunction(), Property->GetSize(), bIsPlainOldData});
+        if (Property->HasAnyPropertyFlags(CPF_ReturnParm)) {
+            ReturnValueIndex = Parameters.Num() - 1;
+        }
+        if (!Property->HasAnyPropertyFlags(CPF_NoDestructor)) {
+            bNeedsDestruction = true;
+        }
+    }
+    //Buffer is taken once and reused by all calls. Pooled buffers may contain garbage of the previous call
+    ParameterBuffer = AllocateParameterBuffer(Function->ParmsSize, Function->GetMinAlignment());
+    FMemory::Memzero(ParameterBuffer, Function->ParmsSize);
+    for (const FParameterInfo& Parameter : Parameters) {
+        Parameter.Property->InitializeValue_InContainer(ParameterBuffer);
+    }
+}
+
+FReflectedFunctionCall::~FReflectedFunctionCall() {
+    if (bNeedsDestruction) {
+        for (const FParameterInfo& Parameter : Parameters) {
+            Parameter.Property->DestroyValue_InContainer(ParameterBuffer);
+        }
+    }
+    ReleaseParameterBuffer(ParameterBuffer, Function->ParmsSize, Function->GetMinAlignment());
+}
+
+int32 FReflectedFunctionCall::FindParameterIndex(FName ParameterName) const {
+    return Parameters.IndexOfByPredicate([&](const FParameterInfo& Parameter) {
+        return Parameter.Property->GetFName() == ParameterName;
+    });
+}
+
+void FReflectedFunctionCall::SetArgumentRaw(int32 Index, const void* Value) {
+    const FParameterInfo& Parameter = Parameters[Index];
+    if (Parameter.bIsPlainOldData) {
+        FMemory::Memcpy(ParameterBuffer + Parameter.Offset, Value, Parameter.Size);
+    } else {
+        Parameter.Property->CopyCompleteValue(ParameterBuffer + Parameter.Offset, Value);
+    }
+}
+
+void FReflectedFunctionCall::GetResultRaw(int32 Index, void* OutValue) const {
+    const FParameterInfo& Parameter = Parameters[Index];
+    if (Parameter.bIsPlainOldData) {
+        FMemory::Memcpy(OutValue, ParameterBuffer + Parameter.Offset, Parameter.Size);
+    } else {
+        Parameter.Property->CopyCompleteValue(OutValue, ParameterBuffer + Parameter.Offset);
+    }
+}
+
+void FReflectedFunctionCall::Invoke(UObject* Object) {
+    checkf(Object, TEXT("Cannot call function %s on NULL object"), *Function->GetName());
+    //Recursive invocation would overwrite arguments of the outer call in the shared buffer
+    checkf(!bIsInvoking, TEXT("Recursive invocation of the prepared call of function %s"), *Function->GetName());
+    bIsInvoking = true;
+    Object->ProcessEvent(Function, ParameterBuffer);
+    bIsInvoking = false;
+}
+
+void FReflectedFunctionCall::ResetParameters() {
+    for (const FParameterInfo& Parameter : Parameters) {
+        if (Parameter.bIsPlainOldData) {
+            FMemory::Memzero(ParameterBuffer + Parameter.Offset, Parameter.Size);
+        } else {
+            Parameter.Property->DestroyValue_InContainer(ParameterBuffer);
+            Parameter.Property->InitializeValue_InContainer(ParameterBuffer);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#include "Reflection/ReflectedPropertyCache.h"
+#include "UObject/UObjectGlobals.h"
+
+TMap<TPair<FObjectKey, FName>, FProperty*> FReflectedPropertyCache::CachedProperties;
+TMap<TPair<FObjectKey, FName>, UFunction*> FReflectedPropertyCache::CachedFunctions;
+FRWLock FReflectedPropertyCache::CacheLock;
+//Starts at 1 so default constructed handles always resolve on first access
+TAtomic<uint32> FReflectedPropertyCache::CacheGeneration(1);
+
+FProperty* FReflectedPropertyCache::FindProperty(UStruct* Struct, FName PropertyName) {
+    if (Struct == NULL) {
+        return NULL;
+    }
+    //Object key includes serial number, so struct allocated at the address of the collected one never hits its entries
+    const TPair<FObjectKey, FName> CacheKey(FObjectKey(Struct), PropertyName);
+    {
+        FRWScopeLock ScopeLock(CacheLock, SLT_ReadOnly);
+        FProperty** CachedProperty = CachedProperties.Find(CacheKey);
+        if (CachedProperty != NULL) {
+            return *CachedProperty;
+        }
+    }
+    //Property chain is only walked on a miss, without holding the lock
+    FProperty* Property = Struct->FindPropertyByName(PropertyName);
+    FRWScopeLock ScopeLock(CacheLock, SLT_Write);
+    CachedProperties.Add(CacheKey, Property);
+    return Property;
+}
+
+UFunction* FReflectedPropertyCache::FindFunction(UClass* Class, FName FunctionName) {
+    if (Class == NULL) {
+        return NULL;
+    }
+    const TPair<FObjectKey, FName> CacheKey(FObjectKey(Class), FunctionName);
+    {
+        FRWScopeLock ScopeLock(CacheLock, SLT_ReadOnly);
+        UFunction** CachedFunction = CachedFunctions.Find(CacheKey);
+        if (CachedFunction != NULL) {
+            return *CachedFunction;
+        }
+    }
+    //Lookup walks the function maps of all super classes, which is what makes it worth caching
+    UFunction* Function = Class->FindFunctionByName(FunctionName);
+    FRWScopeLock ScopeLock(CacheLock, SLT_Write);
+    CachedFunctions.Add(CacheKey, Function);
+    return Function;
+}
+
+void FReflectedPropertyCache::Invalidate() {
+    FRWScopeLock ScopeLock(CacheLock, SLT_Write);
+    CachedProperties.Empty();
+    CachedFunctions.Empty();
+    CacheGeneration++;
+}
+
+void FReflectedPropertyCache::RemoveStaleEntries() {
+    FRWScopeLock ScopeLock(CacheLock, SLT_Write);
+    for (auto It = CachedProperties.CreateIterator(); It; ++It) {
+        if (It->Key.Key.ResolveObjectPtr() == NULL) {
+            It.RemoveCurrent();
+        }
+    }
+    for (auto It = CachedFunctions.CreateIterator(); It; ++It) {
+        if (It->Key.Key.ResolveObjectPtr() == NULL) {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FReflectedPropertyCache::RegisterDelegates() {
+    FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&FReflectedPropertyCache::RemoveStaleEntries);
+    //Reinstanced classes get new property chains, so previously resolved properties are no longer valid
+    //Classes are reinstanced by hot reload outside of the editor too, so this is not limited to editor builds
+    FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>& ReplacedObjects) {
+        Invalidate();
+    });
+}
+
+FReflectedPropertyHandle::FReflectedPropertyHandle() : Property(NULL), ResolvedGeneration(0) {
+}
+
+FReflectedPropertyHandle::FReflectedPropertyHandle(UStruct* Struct, FName PropertyName) : Struct(Struct), PropertyName(PropertyName), Property(NULL), ResolvedGeneration(0) {
+}
+
+void FReflectedPropertyHandle::Resolve() const {
+    Property = FReflectedPropertyCache::FindProperty(Struct.Get(), PropertyName);
+    ResolvedGeneration = FReflectedPropertyCache::GetGeneration();
+}
@@ -1,6 +1,48 @@
 #include "Registry/ModKeyBindRegistry.h"
 #include "FGOptionsSettings.h"
 #include "GameFramework/InputSettings.h"
+#include "SatisfactoryModLoader.h"
+
+TArray<FName> UModKeyBindRegistry::RegisteredActionNames;
+TMap<FName, int32> UModKeyBindRegistry::ActionNameIndices;
+TArray<FName> UModKeyBindRegistry::RegisteredAxisNames;
+TMap<FName, int32> UModKeyBindRegistry::AxisNameIndices;
+
+int32 UModKeyBindRegistry::AssignBindingIndex(FName BindingName, TArray<FName>& RegisteredNames, TMap<FName, int32>& NameIndices) {
+    const int32* ExistingIndex = NameIndices.Find(BindingName);
+    if (ExistingIndex != NULL) {
+        return *ExistingIndex;
+    }
+    const int32 NewIndex = RegisteredNames.Add(BindingName);
+    NameIndices.Add(BindingName, NewIndex);
+    return NewIndex;
+}
+
+int32 UModKeyBindRegistry::FindModKeyBindIndex(FName ActionName) {
+    const int32* KeyBindIndex = ActionNameIndices.Find(ActionName);
+    return KeyBindIndex ? *KeyBindIndex : INDEX_NONE;
+}
+
+int32 UModKeyBindRegistry::FindModAxisBindIndex(FName AxisName) {
+    const int32* AxisBindIndex = AxisNameIndices.Find(AxisName);
+    return AxisBindIndex ? *AxisBindIndex : INDEX_NONE;
+}
+
+FName UModKeyBindRegistry::GetModKeyBindName(int32 KeyBindIndex) {
+    if (!RegisteredActionNames.IsValidIndex(KeyBindIndex)) {
+        UE_LOG(LogSatisfactoryModLoader, Warning, TEXT("GetModKeyBindName called with invalid mod key bind index: %d"), KeyBindIndex);
+        return NAME_None;
+    }
+    return RegisteredActionNames[KeyBindIndex];
+}
+
+FName UModKeyBindRegistry::GetModAxisBindName(int32 AxisBindIndex) {
+    if (!RegisteredAxisNames.IsValidIndex(AxisBindIndex)) {
+        UE_LOG(LogSatisfactoryModLoader, Warning, TEXT("GetModAxisBindName called with invalid mod axis bind index: %d"), AxisBindIndex);
+        return NAME_None;
+    }
+    return RegisteredAxisNames[AxisBindIndex];
+}
 
 void UModKeyBindRegistry::RegisterModKeyBind(const FString& ModReference, const FInputActionKeyMapping& KeyMapping, const FText& DisplayName) {
     UInputSettings* InputSettings = UInputSettings::GetInputSettings();
@@ -10,6 +52,8 @@ void UModKeyBindRegistry::RegisterModKeyBind(const FString& ModReference, const
     //Ensure that we are prefixed by ModReference to allow unique identification
     const FString ActionName = KeyMapping.ActionName.ToString();
     checkf(ActionName.StartsWith(ModPrefix), TEXT("RegisterModKeyBind called with ActionName not being prefixed by ModReference"));
+    //Gamepad and keyboard mappings of the same action share the index
+    AssignBindingIndex(KeyMapping.ActionName, RegisteredActionNames, ActionNameIndices);
     
     //Check for uniqueness. We want mapping registered only one time
     TArray<FInputActionKeyMapping> MappingsAlreadyRegistered;
@@ -62,6 +106,7 @@ void UModKeyBindRegistry::RegisterModAxisBind(const FString& ModReference, const
     const FString AxisName = PositiveAxisMapping.AxisName.ToString();
     checkf(AxisName.StartsWith(ModPrefix), TEXT("RegisterModAxisBind called with AxisName not being prefixed by ModReference"));
     PerformChecksForModAxisBindings(PositiveAxisMapping, NegativeAxisMapping);
+    AssignBindingIndex(PositiveAxisMapping.AxisName, RegisteredAxisNames, AxisNameIndices);
 
     //Ensure we don't have duplicate axis mappings already registered
     TArray<FInputAxisKeyMapping> MappingsAlreadyRegistered;
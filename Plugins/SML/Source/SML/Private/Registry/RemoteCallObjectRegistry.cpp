@@ -1,11 +1,90 @@
 #include "Registry/RemoteCallObjectRegistry.h"
 #include "FGGameMode.h"
 #include "Player/SMLRemoteCallObject.h"
+#include "FGPlayerController.h"
 #include "GameFramework/GameModeBase.h"
+#include "Kismet/GameplayStatics.h"
 
 void URemoteCallObjectRegistry::RegisterRemoteCallObject(TSubclassOf<UFGRemoteCallObject> RemoteCallObject) {
     check(RemoteCallObject);
-    RegisteredRCOs.AddUnique(RemoteCallObject);
+    if (!RemoteCallObjectSlots.Contains(RemoteCallObject)) {
+        const int32 Slot = RegisteredRCOs.Add(RemoteCallObject);
+        RemoteCallObjectSlots.Add(RemoteCallObject, Slot);
+    }
+}
+
+UFGRemoteCallObject* URemoteCallObjectRegistry::GetRemoteCallObject(AFGPlayerController* PlayerController, TSubclassOf<UFGRemoteCallObject> RemoteCallObject) {
+    const int32 Slot = GetRemoteCallObjectSlot(RemoteCallObject);
+    if (Slot == INDEX_NONE) {
+        //Class is not registered in the registry, resolve it on the controller directly
+        return PlayerController ? PlayerController->GetRemoteCallObjectOfClass(RemoteCallObject) : NULL;
+    }
+    return GetRemoteCallObjectBySlot(PlayerController, Slot);
+}
+
+int32 URemoteCallObjectRegistry::GetRemoteCallObjectSlot(TSubclassOf<UFGRemoteCallObject> RemoteCallObject) const {
+    const int32* Slot = RemoteCallObjectSlots.Find(RemoteCallObject);
+    return Slot ? *Slot : INDEX_NONE;
+}
+
+UFGRemoteCallObject* URemoteCallObjectRegistry::GetRemoteCallObjectBySlot(AFGPlayerController* PlayerController, int32 Slot) {
+    if (PlayerController == NULL || !RegisteredRCOs.IsValidIndex(Slot)) {
+        return NULL;
+    }
+    TArray<TWeakObjectPtr<UFGRemoteCallObject>>& RemoteCallObjects = FindOrAddControllerEntry(PlayerController).RemoteCallObjects;
+    if (RemoteCallObjects.Num() <= Slot) {
+        RemoteCallObjects.SetNum(RegisteredRCOs.Num());
+    }
+    
+    UFGRemoteCallObject* CachedObject = RemoteCallObjects[Slot].Get();
+    if (CachedObject == NULL) {
+        //Objects are created lazily on server and replicated to client, so only cache them once they actually exist
+        CachedObject = PlayerController->GetRemoteCallObjectOfClass(RegisteredRCOs[Slot]);
+        RemoteCallObjects[Slot] = CachedObject;
+    }
+    return CachedObject;
+}
+
+FControllerRemoteCallObjects& URemoteCallObjectRegistry::FindOrAddControllerEntry(AFGPlayerController* PlayerController) {
+    //UI and tick code usually query the same local controller over and over, so it is checked before the map lookup
+    if (ControllerEntries.IsValidIndex(LastControllerEntry) && ControllerEntries[LastControllerEntry].PlayerController.Get() == PlayerController) {
+        return ControllerEntries[LastControllerEntry];
+    }
+    const int32* ExistingEntry = ControllerEntryIndices.Find(PlayerController);
+    if (ExistingEntry != NULL) {
+        LastControllerEntry = *ExistingEntry;
+        return ControllerEntries[LastControllerEntry];
+    }
+    
+    //Drop controllers which have been destroyed since the last time new controller has been seen
+    const int32 RemovedEntries = ControllerEntries.RemoveAll([](const FControllerRemoteCallObjects& Entry) {
+        return !Entry.PlayerController.IsValid();
+    });
+    if (RemovedEntries > 0) {
+        ControllerEntryIndices.Reset();
+        for (int32 EntryIndex = 0; EntryIndex < ControllerEntries.Num(); EntryIndex++) {
+            ControllerEntryIndices.Add(ControllerEntries[EntryIndex].PlayerController, EntryIndex);
+        }
+    }
+    LastControllerEntry = ControllerEntries.Add(FControllerRemoteCallObjects{PlayerController});
+    ControllerEntryIndices.Add(PlayerController, LastControllerEntry);
+    return ControllerEntries[LastControllerEntry];
+}
+
+URemoteCallObjectRegistry* URemoteCallObjectRegistry::Get(const UObject* WorldContext) {
+    UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContext);
+    return GameInstance ? GameInstance->GetSubsystem<URemoteCallObjectRegistry>() : NULL;
+}
+
+UFGRemoteCallObject* URemoteCallObjectRegistry::GetPlayerRemoteCallObject(AFGPlayerController* PlayerController, TSubclassOf<UFGRemoteCallObject> RemoteCallObject) {
+    if (PlayerController == NULL) {
+        return NULL;
+    }
+    URemoteCallObjectRegistry* Registry = Get(PlayerController);
+    if (Registry == NULL) {
+        return PlayerController->GetRemoteCallObjectOfClass(RemoteCallObject);
+    }
+    return Registry->GetRemoteCallObject(PlayerController, RemoteCallObject);
 }
 
 void URemoteCallObjectRegistry::Initialize(FSubsystemCollectionBase& Collection) {
@@ -2,6 +2,7 @@
 #include "FGGameState.h"
 #include "Patching/NativeHookManager.h"
 #include "Subsystem/SMLSubsystemHolder.h"
+#include "Subsystem/ModSubsystemIndex.h"
 
 DEFINE_LOG_CATEGORY(LogSubsystemHolderRegistry);
 
@@ -13,6 +14,7 @@ void USubsystemHolderRegistry::InitializeSubsystems(AFGGameState* GameState) {
     UGameInstance* GameInstance = GameState->GetWorld()->GetGameInstance();
     const USubsystemHolderRegistry* Registry = GameInstance->GetSubsystem<USubsystemHolderRegistry>();
     
+    UModSubsystemIndex* SubsystemIndex = GameState->GetWorld()->GetSubsystem<UModSubsystemIndex>();
     const bool bIsAuthority = GameState->HasAuthority();
     UE_LOG(LogSubsystemHolderRegistry, Display, TEXT("Initializing modded subsystem holders"));
 	
@@ -26,6 +28,7 @@ void USubsystemHolderRegistry::InitializeSubsystems(AFGGameState* GameState) {
         Component->SetNetAddressable();
         Component->SetIsReplicated(true);
         Component->RegisterComponent();
+        SubsystemIndex->AddSubsystemHolder(Component);
 		
         Component->InitLocalSubsystems();
         Component->K2_InitLocalSubsystems();
@@ -17,6 +17,7 @@
 #include "Patching/Patch/OptionsKeybindPatch.h"
 #include "Player/PlayerCheatManagerHandler.h"
 #include "Toolkit/OldToolkit/FGNativeClassDumper.h"
+#include "Reflection/ReflectedPropertyCache.h"
 
 #ifndef SML_BUILD_METADATA
 #define SML_BUILD_METADATA "unknown"
@@ -144,6 +145,9 @@ void FSatisfactoryModLoader::RegisterSubsystems() {
     //Register version checker for remote connections
     FSMLNetworkManager::RegisterMessageTypeAndHandlers();
 
+    //Register invalidation of the reflected property cache
+    FReflectedPropertyCache::RegisterDelegates();
+
     //Initialize asset dumping and asset related stuff in cooked builds only
     if (FPlatformProperties::RequiresCookedData()) {
         //Make sure asset helper is set up correctly as it is needed for asset dumping
@@ -170,7 +174,7 @@ void FSatisfactoryModLoader::PreInitializeModLoading() {
 
     //Register these patches early so no materials/meshes loaded will skip them
     //They will slow down game performance because of hooking in hot spots + extra memory consumption on CPU
-    //Same goes with UStaticMesh patch, it will increase memory usage on CPU and decrease loading speed
+    //UStaticMesh patch only forces CPU access for the mesh packages asset dumper loads for the export
     //We also do not need them in editor because asset dumping is cooked data-only
     if (FPlatformProperties::RequiresCookedData()) {
         if (SMLConfigurationPrivate.bDevelopmentMode) {
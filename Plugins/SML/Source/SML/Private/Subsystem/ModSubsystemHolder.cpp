@@ -1,6 +1,7 @@
 ﻿#include "Subsystem/ModSubsystemHolder.h"
 #include "FGGameState.h"
 #include "Engine/World.h"
+#include "Subsystem/ModSubsystemIndex.h"
 
 void UModSubsystemHolder::InitSubsystems()
 {
@@ -19,14 +20,16 @@ AFGSubsystem* UModSubsystemHolder::K2_SpawnSubsystem(TSubclassOf<AFGSubsystem> S
     SpawnParams.Owner = GetOwner();
     SpawnParams.Name = SpawnName;
 
-    return GetWorld()->SpawnActor<AFGSubsystem>(SpawnClass, SpawnParams);
+    AFGSubsystem* Subsystem = GetWorld()->SpawnActor<AFGSubsystem>(SpawnClass, SpawnParams);
+    if (Subsystem != nullptr) {
+        UModSubsystemIndex::Get(this)->AddSubsystem(Subsystem);
+    }
+    return Subsystem;
 }
 
 UModSubsystemHolder* UModSubsystemHolder::K2_GetModSubsystemHolder(TSubclassOf<UModSubsystemHolder> HolderClass, UObject* WorldContextObject) {
     UWorld* World = WorldContextObject->GetWorld();
     checkf(World, TEXT("GetWorld not implemented for passed WorldContext object"));
-    AFGGameState* GameState = World->GetGameState<AFGGameState>();
-    if (GameState == nullptr)
-        return nullptr;
-    return Cast<UModSubsystemHolder>(GameState->FindComponentByClass(HolderClass));
+    UModSubsystemIndex* SubsystemIndex = World->GetSubsystem<UModSubsystemIndex>();
+    return SubsystemIndex->FindSubsystemHolder(HolderClass);
 }
@@ -0,0 +1,64 @@
+#include "Subsystem/ModSubsystemIndex.h"
+#include "FGGameState.h"
+#include "FGSubsystem.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Subsystem/ModSubsystemHolder.h"
+
+UModSubsystemIndex* UModSubsystemIndex::Get(const UObject* WorldContext) {
+    UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull);
+    return World ? World->GetSubsystem<UModSubsystemIndex>() : nullptr;
+}
+
+void UModSubsystemIndex::Deinitialize() {
+    SubsystemHolders.Empty();
+    Subsystems.Empty();
+}
+
+void UModSubsystemIndex::AddSubsystemHolder(UModSubsystemHolder* SubsystemHolder) {
+    check(SubsystemHolder);
+    SubsystemHolders.Add(SubsystemHolder->GetClass(), SubsystemHolder);
+}
+
+void UModSubsystemIndex::AddSubsystem(AFGSubsystem* Subsystem) {
+    check(Subsystem);
+    Subsystems.Add(Subsystem->GetClass(), Subsystem);
+}
+
+UModSubsystemHolder* UModSubsystemIndex::FindSubsystemHolder(UClass* HolderClass) {
+    UModSubsystemHolder** IndexedHolder = SubsystemHolders.Find(HolderClass);
+    if (IndexedHolder != nullptr && IsValid(*IndexedHolder)) {
+        return *IndexedHolder;
+    }
+    //Holder has been requested by it's parent class, resolve it from the game state once
+    AFGGameState* GameState = GetWorld()->GetGameState<AFGGameState>();
+    if (GameState == nullptr) {
+        return nullptr;
+    }
+    UModSubsystemHolder* SubsystemHolder = Cast<UModSubsystemHolder>(GameState->FindComponentByClass(HolderClass));
+    if (SubsystemHolder != nullptr) {
+        SubsystemHolders.Add(HolderClass, SubsystemHolder);
+    }
+    return SubsystemHolder;
+}
+
+AFGSubsystem* UModSubsystemIndex::FindSubsystem(UClass* SubsystemClass) {
+    AFGSubsystem** IndexedSubsystem = Subsystems.Find(SubsystemClass);
+    if (IndexedSubsystem != nullptr && IsValid(*IndexedSubsystem)) {
+        return *IndexedSubsystem;
+    }
+    //Subsystem has been replicated from the server or requested by it's parent class, find it in the world once
+    for (TActorIterator<AFGSubsystem> It(GetWorld(), SubsystemClass); It; ++It) {
+        if (IsValid(*It)) {
+            Subsystems.Add(SubsystemClass, *It);
+            return *It;
+        }
+    }
+    return nullptr;
+}
+
+AFGSubsystem* UModSubsystemIndex::K2_GetModSubsystem(TSubclassOf<AFGSubsystem> SubsystemClass, UObject* WorldContextObject) {
+    UModSubsystemIndex* SubsystemIndex = Get(WorldContextObject);
+    return SubsystemIndex && SubsystemClass ? SubsystemIndex->FindSubsystem(SubsystemClass) : nullptr;
+}
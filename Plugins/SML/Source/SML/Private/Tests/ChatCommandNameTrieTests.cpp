@@ -0,0 +1,58 @@
+#include "Misc/AutomationTest.h"
+#include "Command/ChatCommandNameTrie.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Trie never dereferences commands, so distinct fake pointers are enough to tell them apart */
+static AChatCommandInstance* MakeTestCommand(int32 CommandIndex) {
+	return reinterpret_cast<AChatCommandInstance*>((UPTRINT) (CommandIndex + 1) * 16);
+}
+
+static FString JoinCompletions(const FChatCommandNameTrie& Trie, const FString& Prefix, int32 MaxResults) {
+	TArray<FString> Completions;
+	Trie.FindCompletions(Prefix, MaxResults, Completions);
+	return FString::Join(Completions, TEXT(","));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChatCommandNameTrieTest, "SML.Command.ChatCommandNameTrie", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FChatCommandNameTrieTest::RunTest(const FString& Parameters) {
+	FChatCommandNameTrie Trie;
+	Trie.Add(TEXT("help"), MakeTestCommand(0), 0);
+	Trie.Add(TEXT("h"), MakeTestCommand(0), 1);
+	Trie.Add(TEXT("heal"), MakeTestCommand(1), 0);
+	Trie.Add(TEXT("Home"), MakeTestCommand(2), 0);
+	Trie.Add(TEXT("hello"), MakeTestCommand(3), 0);
+	Trie.Add(TEXT("tp"), MakeTestCommand(4), 0);
+
+	//Lookup is case-insensitive and only matches complete names
+	TestTrue(TEXT("Find help"), Trie.Find(TEXT("help")) == MakeTestCommand(0));
+	TestTrue(TEXT("Find alias"), Trie.Find(TEXT("h")) == MakeTestCommand(0));
+	TestTrue(TEXT("Find in other case"), Trie.Find(TEXT("HeLP")) == MakeTestCommand(0));
+	TestTrue(TEXT("Find name registered in upper case"), Trie.Find(TEXT("home")) == MakeTestCommand(2));
+	TestNull(TEXT("Find prefix"), Trie.Find(TEXT("hel")));
+	TestNull(TEXT("Find longer name"), Trie.Find(TEXT("helpme")));
+	TestNull(TEXT("Find unknown name"), Trie.Find(TEXT("give")));
+	TestNull(TEXT("Find empty name"), Trie.Find(TEXT("")));
+
+	//Completions are ordered by rank, then by length, then alphabetically, and keep the registered case
+	TestEqual(TEXT("Complete he"), JoinCompletions(Trie, TEXT("he"), 10), FString(TEXT("heal,help,hello")));
+	TestEqual(TEXT("Complete H"), JoinCompletions(Trie, TEXT("H"), 10), FString(TEXT("heal,help,Home,hello,h")));
+	TestEqual(TEXT("Complete H limited"), JoinCompletions(Trie, TEXT("H"), 2), FString(TEXT("heal,help")));
+	TestEqual(TEXT("Complete empty prefix"), JoinCompletions(Trie, TEXT(""), 10), FString(TEXT("tp,heal,help,Home,hello,h")));
+	TestEqual(TEXT("Complete full name"), JoinCompletions(Trie, TEXT("hello"), 10), FString(TEXT("hello")));
+	TestEqual(TEXT("Complete unknown prefix"), JoinCompletions(Trie, TEXT("x"), 10), FString());
+	TestEqual(TEXT("Complete without results"), JoinCompletions(Trie, TEXT("h"), 0), FString());
+
+	//Adding the same name again replaces the command, regardless of the case
+	Trie.Add(TEXT("HEAL"), MakeTestCommand(5), 0);
+	TestTrue(TEXT("Find replaced command"), Trie.Find(TEXT("heal")) == MakeTestCommand(5));
+	TestEqual(TEXT("Complete replaced name"), JoinCompletions(Trie, TEXT("hea"), 10), FString(TEXT("HEAL")));
+
+	Trie.Empty();
+	TestNull(TEXT("Find after empty"), Trie.Find(TEXT("help")));
+	TestEqual(TEXT("Complete after empty"), JoinCompletions(Trie, TEXT(""), 10), FString());
+	return true;
+}
+
+#endif
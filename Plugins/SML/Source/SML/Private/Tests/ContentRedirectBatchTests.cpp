@@ -0,0 +1,51 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/CoreRedirects.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static TArray<FCoreRedirect> MakeTestClassRedirects(const TCHAR* Prefix, int32 RedirectCount) {
+	TArray<FCoreRedirect> Redirects;
+	Redirects.Reserve(RedirectCount);
+	for (int32 RedirectIndex = 0; RedirectIndex < RedirectCount; RedirectIndex++) {
+		Redirects.Add(FCoreRedirect(ECoreRedirectFlags::Type_Class,
+			FString::Printf(TEXT("/Script/%sOld.TestClass%d"), Prefix, RedirectIndex),
+			FString::Printf(TEXT("/Script/%sNew.TestClass%d"), Prefix, RedirectIndex)));
+	}
+	return Redirects;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FContentRedirectBatchBenchmark, "SML.ModLoading.ContentRedirectBatch", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FContentRedirectBatchBenchmark::RunTest(const FString& Parameters) {
+	//Compares registering 10k redirects one by one, the way they were registered before batching, with a single batched list
+	const int32 RedirectCount = 10000;
+	const TArray<FCoreRedirect> IndividualRedirects = MakeTestClassRedirects(TEXT("SMLIndividualRedirect"), RedirectCount);
+	const TArray<FCoreRedirect> BatchedRedirects = MakeTestClassRedirects(TEXT("SMLBatchedRedirect"), RedirectCount);
+
+	const double IndividualStartTime = FPlatformTime::Seconds();
+	for (const FCoreRedirect& Redirect : IndividualRedirects) {
+		FCoreRedirects::AddRedirectList(TArray<FCoreRedirect>{Redirect}, TEXT("FContentRedirectBatchBenchmark"));
+	}
+	const double IndividualTime = FPlatformTime::Seconds() - IndividualStartTime;
+
+	const double BatchedStartTime = FPlatformTime::Seconds();
+	FCoreRedirects::AddRedirectList(BatchedRedirects, TEXT("FContentRedirectBatchBenchmark"));
+	const double BatchedTime = FPlatformTime::Seconds() - BatchedStartTime;
+
+	AddInfo(FString::Printf(TEXT("Registered %d redirects one by one in %.2fms, as a single batch in %.2fms"), RedirectCount, IndividualTime * 1000.0, BatchedTime * 1000.0));
+
+	//Both ways have to result in the same active redirects
+	for (const TArray<FCoreRedirect>* Redirects : {&IndividualRedirects, &BatchedRedirects}) {
+		for (int32 RedirectIndex = 0; RedirectIndex < RedirectCount; RedirectIndex += 997) {
+			const FCoreRedirect& Redirect = (*Redirects)[RedirectIndex];
+			const FCoreRedirectObjectName RedirectedName = FCoreRedirects::GetRedirectedName(ECoreRedirectFlags::Type_Class, Redirect.OldName);
+			TestEqual(FString::Printf(TEXT("Redirected %s"), *Redirect.OldName.ToString()), RedirectedName.ToString(), Redirect.NewName.ToString());
+		}
+	}
+	FCoreRedirects::RemoveRedirectList(IndividualRedirects, TEXT("FContentRedirectBatchBenchmark"));
+	FCoreRedirects::RemoveRedirectList(BatchedRedirects, TEXT("FContentRedirectBatchBenchmark"));
+	return true;
+}
+
+#endif
@@ -0,0 +1,120 @@
+#include "Misc/AutomationTest.h"
+#include "Tooltip/ItemTooltipSubsystem.h"
+#include "Resources/FGItemDescriptor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "ItemTooltipTestTypes.h"
+
+FText UItemTooltipTestProvider::GetItemDescription_Implementation(APlayerController* OwningPlayer, const FInventoryStack& InventoryStack) {
+	NumDescriptionCalls++;
+	if (bStateIndependent) {
+		return FText::FromString(DescriptionPrefix);
+	}
+	const AItemTooltipTestState* ItemState = Cast<AItemTooltipTestState>(InventoryStack.Item.ItemState.Get());
+	const int32 Charge = ItemState != NULL ? ItemState->Charge : -1;
+	return FText::FromString(FString::Printf(TEXT("%s %s %d/%d"), *DescriptionPrefix, *GetNameSafe(OwningPlayer), InventoryStack.NumItems, Charge));
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static UItemTooltipTestProvider* CreateTestProvider(const FString& DescriptionPrefix, bool bStateIndependent) {
+	UItemTooltipTestProvider* Provider = NewObject<UItemTooltipTestProvider>();
+	Provider->DescriptionPrefix = DescriptionPrefix;
+	Provider->bStateIndependent = bStateIndependent;
+	return Provider;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemTooltipDescriptionCacheTest, "SML.Tooltip.ItemTooltipSubsystem.DescriptionCache", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FItemTooltipDescriptionCacheTest::RunTest(const FString& Parameters) {
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	APlayerController* FirstPlayer = World->SpawnActor<APlayerController>();
+	APlayerController* SecondPlayer = World->SpawnActor<APlayerController>();
+	AItemTooltipTestState* ItemState = World->SpawnActor<AItemTooltipTestState>();
+	
+	UItemTooltipSubsystem* TooltipSubsystem = NewObject<UItemTooltipSubsystem>();
+	const TSubclassOf<UFGItemDescriptor> ItemClass = UFGItemDescriptor::StaticClass();
+	FInventoryStack InventoryStack(5, ItemClass);
+	InventoryStack.Item.ItemState = FSharedInventoryStatePtr::MakeShared(ItemState);
+
+	//State independent provider is called once per item class, regardless of the stack
+	UItemTooltipTestProvider* StaticProvider = CreateTestProvider(TEXT("Static"), true);
+	TooltipSubsystem->RegisterGlobalTooltipProvider(TEXT("SML"), StaticProvider);
+	const FText StaticDescription = TooltipSubsystem->GetItemDescription(FirstPlayer, InventoryStack);
+	InventoryStack.NumItems = 7;
+	TestTrue(TEXT("Description of state independent provider"), TooltipSubsystem->GetItemDescription(SecondPlayer, InventoryStack).EqualTo(StaticDescription));
+	TestEqual(TEXT("State independent provider calls"), StaticProvider->NumDescriptionCalls, 1);
+
+	//Registering provider invalidates the cache, descriptions are now keyed by the stack state and player
+	UItemTooltipTestProvider* StateProvider = CreateTestProvider(TEXT("State"), false);
+	TooltipSubsystem->RegisterGlobalTooltipProvider(TEXT("SML"), StateProvider);
+	const auto ExpectDescription = [&](const TCHAR* What, APlayerController* Player, int32 ExpectedCalls) {
+		const FText Description = TooltipSubsystem->GetItemDescription(Player, InventoryStack);
+		const FString ExpectedSuffix = FString::Printf(TEXT("State %s %d/%d"), *GetNameSafe(Player), InventoryStack.NumItems, ItemState->Charge);
+		TestTrue(FString::Printf(TEXT("%s description '%s'"), What, *Description.ToString()), Description.ToString().EndsWith(ExpectedSuffix));
+		TestEqual(FString::Printf(TEXT("%s provider calls"), What), StateProvider->NumDescriptionCalls, ExpectedCalls);
+	};
+	ExpectDescription(TEXT("Initial"), FirstPlayer, 1);
+	ExpectDescription(TEXT("Same state"), FirstPlayer, 1);
+	
+	ItemState->Charge = 42;
+	ExpectDescription(TEXT("Changed item state"), FirstPlayer, 2);
+	InventoryStack.NumItems = 8;
+	ExpectDescription(TEXT("Changed item count"), FirstPlayer, 3);
+	ExpectDescription(TEXT("Other player"), SecondPlayer, 4);
+	
+	ItemState->Charge = 0;
+	InventoryStack.NumItems = 7;
+	ExpectDescription(TEXT("Previous state"), FirstPlayer, 4);
+
+	TooltipSubsystem->InvalidateDescriptionCache();
+	ExpectDescription(TEXT("Invalidated cache"), FirstPlayer, 5);
+	TestEqual(TEXT("Total state independent provider calls"), StaticProvider->NumDescriptionCalls, 6);
+
+	uint32 FirstStateHash = 0;
+	uint32 SecondStateHash = 0;
+	TestTrue(TEXT("State hash is computed"), UItemTooltipSubsystem::ComputeItemStateHash(InventoryStack, FirstStateHash));
+	ItemState->Charge = 1;
+	UItemTooltipSubsystem::ComputeItemStateHash(InventoryStack, SecondStateHash);
+	TestNotEqual(TEXT("State hash depends on the SaveGame properties"), FirstStateHash, SecondStateHash);
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FItemTooltipDescriptionBenchmark, "SML.Tooltip.ItemTooltipSubsystem.DescriptionBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FItemTooltipDescriptionBenchmark::RunTest(const FString& Parameters) {
+	//Tooltip text binding requests the description every frame, so the same few stacks are requested over and over
+	const int32 NumRequests = 10000;
+	const int32 NumDistinctStacks = 100;
+	
+	UItemTooltipSubsystem* TooltipSubsystem = NewObject<UItemTooltipSubsystem>();
+	for (int32 ProviderIndex = 0; ProviderIndex < 8; ProviderIndex++) {
+		TooltipSubsystem->RegisterGlobalTooltipProvider(TEXT("SML"), CreateTestProvider(FString::Printf(TEXT("Provider %d"), ProviderIndex), ProviderIndex % 2 == 0));
+	}
+	TArray<FInventoryStack> InventoryStacks;
+	for (int32 StackIndex = 0; StackIndex < NumDistinctStacks; StackIndex++) {
+		InventoryStacks.Add(FInventoryStack(StackIndex + 1, UFGItemDescriptor::StaticClass()));
+	}
+
+	int32 TotalLength = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 RequestIndex = 0; RequestIndex < NumRequests; RequestIndex++) {
+		TooltipSubsystem->InvalidateDescriptionCache();
+		TotalLength += TooltipSubsystem->GetItemDescription(NULL, InventoryStacks[RequestIndex % NumDistinctStacks]).ToString().Len();
+	}
+	const double UncachedTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 RequestIndex = 0; RequestIndex < NumRequests; RequestIndex++) {
+		TotalLength -= TooltipSubsystem->GetItemDescription(NULL, InventoryStacks[RequestIndex % NumDistinctStacks]).ToString().Len();
+	}
+	const double CachedTime = FPlatformTime::Seconds() - StartTime;
+	
+	TestEqual(TEXT("Cached descriptions match composed ones"), TotalLength, 0);
+	AddInfo(FString::Printf(TEXT("%d description requests: composed every time %.2fms, cached %.2fms"), NumRequests, UncachedTime * 1000.0, CachedTime * 1000.0));
+	return true;
+}
+
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Tooltip/SMLItemTooltipProvider.h"
+#include "ItemTooltipTestTypes.generated.h"
+
+/** Tooltip provider used by the automation tests, counts description calls and includes stack contents in the description */
+UCLASS(NotBlueprintable, Transient)
+class UItemTooltipTestProvider : public UObject, public ISMLItemTooltipProvider {
+	GENERATED_BODY()
+public:
+	FString DescriptionPrefix;
+	bool bStateIndependent;
+	int32 NumDescriptionCalls;
+
+	virtual FText GetItemDescription_Implementation(APlayerController* OwningPlayer, const FInventoryStack& InventoryStack) override;
+	virtual UWidget* CreateDescriptionWidget_Implementation(APlayerController* OwningPlayer, const FInventoryStack& InventoryStack) override { return NULL; }
+	virtual bool IsDescriptionStateIndependent_Implementation() override { return bStateIndependent; }
+};
+
+/** Item state actor used by the automation tests */
+UCLASS(NotBlueprintable, Transient)
+class AItemTooltipTestState : public AActor {
+	GENERATED_BODY()
+public:
+	UPROPERTY(SaveGame)
+	int32 Charge;
+};
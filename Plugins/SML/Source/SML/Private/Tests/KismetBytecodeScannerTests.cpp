@@ -0,0 +1,205 @@
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "Toolkit/KismetBytecodeScanner.h"
+#include "Toolkit/KismetBytecodeDisassemblerJson.h"
+#include "Dom/JsonValue.h"
+#include "UObject/Script.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectIterator.h"
+#include "TestBytecodeWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeScannerTest, "SML.Toolkit.KismetBytecodeScanner", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FKismetBytecodeScannerTest::RunTest(const FString& Parameters) {
+	//Disassembler dereferences properties embedded into the bytecode, so they have to be real ones
+	FProperty* IntProperty = FindFProperty<FProperty>(TBaseStructure<FIntPoint>::Get(), GET_MEMBER_NAME_CHECKED(FIntPoint, X));
+	FProperty* FloatProperty = FindFProperty<FProperty>(TBaseStructure<FVector>::Get(), GET_MEMBER_NAME_CHECKED(FVector, X));
+	if (IntProperty == NULL || FloatProperty == NULL) {
+		AddError(TEXT("Failed to find properties to reference from the bytecode"));
+		return false;
+	}
+
+	FTestBytecodeWriter Writer;
+
+	//Set literal assigned to the variable
+	Writer.BeginStatement(EX_SetSet);
+	Writer.WriteOpcode(EX_LocalVariable);
+	Writer.WritePointer(IntProperty);
+	Writer.WriteInt(2);
+	Writer.WriteOpcode(EX_IntConst);
+	Writer.WriteInt(1);
+	Writer.WriteOpcode(EX_IntConst);
+	Writer.WriteInt(2);
+	Writer.WriteOpcode(EX_EndSet);
+
+	//Map literal assigned to the variable
+	Writer.BeginStatement(EX_SetMap);
+	Writer.WriteOpcode(EX_LocalVariable);
+	Writer.WritePointer(IntProperty);
+	Writer.WriteInt(1);
+	Writer.WriteOpcode(EX_IntOne);
+	Writer.WriteOpcode(EX_FloatConst);
+	Writer.WriteFloat(1.5f);
+	Writer.WriteOpcode(EX_EndMap);
+
+	//Constant set
+	Writer.BeginStatement(EX_SetConst);
+	Writer.WritePointer(IntProperty);
+	Writer.WriteInt(3);
+	Writer.WriteOpcode(EX_IntZero);
+	Writer.WriteOpcode(EX_IntConstByte);
+	Writer.Script.Add(5);
+	Writer.WriteOpcode(EX_IntConst);
+	Writer.WriteInt(7);
+	Writer.WriteOpcode(EX_EndSetConst);
+
+	//Constant map, terminated by EX_EndMapConst rather than EX_EndMap
+	Writer.BeginStatement(EX_MapConst);
+	Writer.WritePointer(IntProperty);
+	Writer.WritePointer(FloatProperty);
+	Writer.WriteInt(2);
+	Writer.WriteOpcode(EX_IntConst);
+	Writer.WriteInt(1);
+	Writer.WriteOpcode(EX_FloatConst);
+	Writer.WriteFloat(2.0f);
+	Writer.WriteOpcode(EX_IntConst);
+	Writer.WriteInt(3);
+	Writer.WriteOpcode(EX_FloatConst);
+	Writer.WriteFloat(4.0f);
+	Writer.WriteOpcode(EX_EndMapConst);
+
+	//Empty constant map
+	Writer.BeginStatement(EX_MapConst);
+	Writer.WritePointer(IntProperty);
+	Writer.WritePointer(FloatProperty);
+	Writer.WriteInt(0);
+	Writer.WriteOpcode(EX_EndMapConst);
+
+	Writer.BeginStatement(EX_Return);
+	Writer.WriteOpcode(EX_Nothing);
+	Writer.BeginStatement(EX_EndOfScript);
+
+	UFunction* Function = NewObject<UFunction>(GetTransientPackage(), NAME_None, RF_Transient);
+	Function->Script = Writer.Script;
+	FKismetBytecodeDisassemblerJson Disassembler;
+
+	//Both should agree on every script index, including the ones inside of the statements
+	for (int32 ScriptIndex = 0; ScriptIndex < Writer.Script.Num(); ScriptIndex++) {
+		int32 ScannerStatementLength;
+		int32 DisassemblerStatementLength;
+		const bool bScannerFoundStatement = FKismetBytecodeScanner::GetStatementLength(Writer.Script, ScriptIndex, ScannerStatementLength);
+		const bool bDisassemblerFoundStatement = Disassembler.GetStatementLength(Function, ScriptIndex, DisassemblerStatementLength);
+
+		TestEqual(FString::Printf(TEXT("Statement at %d"), ScriptIndex), bScannerFoundStatement, Writer.StatementIndices.Contains(ScriptIndex));
+		TestEqual(FString::Printf(TEXT("Statement at %d found by disassembler"), ScriptIndex), bScannerFoundStatement, bDisassemblerFoundStatement);
+		if (bScannerFoundStatement && bDisassemblerFoundStatement) {
+			TestEqual(FString::Printf(TEXT("Length of statement at %d"), ScriptIndex), ScannerStatementLength, DisassemblerStatementLength);
+		}
+	}
+
+	const EExprToken StatementOpcodes[] = {EX_SetSet, EX_SetMap, EX_SetConst, EX_MapConst, EX_Return, EX_EndOfScript, EX_IntConst, EX_EndMapConst};
+	for (const EExprToken Opcode : StatementOpcodes) {
+		int32 ScannerStatementIndex;
+		int32 DisassemblerStatementIndex;
+		const bool bScannerFoundStatement = FKismetBytecodeScanner::FindFirstStatementOfType(Writer.Script, 0, Opcode, ScannerStatementIndex);
+		const bool bDisassemblerFoundStatement = Disassembler.FindFirstStatementOfType(Function, 0, Opcode, DisassemblerStatementIndex);
+
+		TestEqual(FString::Printf(TEXT("Statement with opcode %d found"), (int32) Opcode), bScannerFoundStatement, bDisassemblerFoundStatement);
+		TestEqual(FString::Printf(TEXT("First statement with opcode %d"), (int32) Opcode), ScannerStatementIndex, DisassemblerStatementIndex);
+	}
+
+	//Truncated bytecode is rejected by the scanner instead of being read out of bounds
+	int32 ExpressionSize;
+	const int32 LastMapStatementIndex = Writer.StatementIndices[4];
+	const TArray<uint8> TruncatedScript(Writer.Script.GetData(), LastMapStatementIndex + 1 + (int32) sizeof(ScriptPointerType));
+	TestFalse(TEXT("Truncated map literal"), FKismetBytecodeScanner::GetExpressionSize(TruncatedScript, LastMapStatementIndex, ExpressionSize));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeScannerLoadedFunctionsTest, "SML.Toolkit.KismetBytecodeScanner.LoadedFunctions", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeScannerLoadedFunctionsTest::RunTest(const FString& Parameters) {
+	//Compares statement boundaries with the disassembler on the bytecode of every blueprint function currently loaded
+	int32 FunctionsChecked = 0;
+	for (TObjectIterator<UFunction> It; It; ++It) {
+		UFunction* Function = *It;
+		if (Function->Script.Num() == 0) {
+			continue;
+		}
+		FunctionsChecked++;
+
+		TArray<int32> ExpectedStatementIndices;
+		FKismetBytecodeDisassemblerJson Disassembler;
+		for (const TSharedPtr<FJsonValue>& Statement : Disassembler.SerializeFunction(Function)) {
+			ExpectedStatementIndices.Add((int32) Statement->AsObject()->GetNumberField(TEXT("StatementIndex")));
+		}
+
+		TArray<int32> StatementIndices;
+		int32 ScriptIndex = 0;
+		while (ScriptIndex < Function->Script.Num()) {
+			int32 StatementLength;
+			if (!FKismetBytecodeScanner::GetExpressionSize(Function->Script, ScriptIndex, StatementLength)) {
+				AddError(FString::Printf(TEXT("Failed to walk statement at %d in %s"), ScriptIndex, *Function->GetPathName()));
+				break;
+			}
+			StatementIndices.Add(ScriptIndex);
+			ScriptIndex += StatementLength;
+		}
+		if (StatementIndices != ExpectedStatementIndices) {
+			AddError(FString::Printf(TEXT("Statement boundaries of %s differ from the disassembler"), *Function->GetPathName()));
+		}
+	}
+	AddInfo(FString::Printf(TEXT("Checked bytecode of %d loaded functions"), FunctionsChecked));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeScannerFuzzTest, "SML.Toolkit.KismetBytecodeScanner.Fuzz", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FKismetBytecodeScannerFuzzTest::RunTest(const FString& Parameters) {
+	//Truncated and corrupted bytecode has to be rejected or walked within the script bounds, never read past them
+	TArray<TArray<uint8>> SourceScripts;
+	for (TObjectIterator<UFunction> It; It && SourceScripts.Num() < 64; ++It) {
+		if (It->Script.Num() > 0) {
+			SourceScripts.Add(It->Script);
+		}
+	}
+	//Make sure there is something to mutate even without any blueprints loaded
+	SourceScripts.Add(TArray<uint8>{(uint8) EX_Return, (uint8) EX_Nothing, (uint8) EX_EndOfScript});
+
+	FRandomStream RandomStream(0x4B424353);
+	for (const TArray<uint8>& SourceScript : SourceScripts) {
+		for (int32 Iteration = 0; Iteration < 32; Iteration++) {
+			TArray<uint8> Script = SourceScript;
+			if (Iteration % 2 == 0) {
+				Script.SetNum(RandomStream.RandRange(0, Script.Num()));
+			} else {
+				const int32 NumMutations = RandomStream.RandRange(1, 4);
+				for (int32 i = 0; i < NumMutations; i++) {
+					Script[RandomStream.RandRange(0, Script.Num() - 1)] = (uint8) RandomStream.RandRange(0, 255);
+				}
+			}
+
+			int32 ScriptIndex = 0;
+			while (ScriptIndex < Script.Num()) {
+				int32 ExpressionSize;
+				if (!FKismetBytecodeScanner::GetExpressionSize(Script, ScriptIndex, ExpressionSize)) {
+					break;
+				}
+				if (ExpressionSize <= 0 || ScriptIndex + ExpressionSize > Script.Num()) {
+					AddError(FString::Printf(TEXT("Expression at %d of size %d is outside of the script of size %d"), ScriptIndex, ExpressionSize, Script.Num()));
+					break;
+				}
+				ScriptIndex += ExpressionSize;
+			}
+			int32 StatementIndex;
+			if (FKismetBytecodeScanner::FindFirstStatementOfType(Script, 0, EX_Return, StatementIndex)) {
+				TestTrue(TEXT("Found statement is inside of the script"), StatementIndex >= 0 && StatementIndex < Script.Num());
+			}
+		}
+	}
+	return true;
+}
+
+#endif
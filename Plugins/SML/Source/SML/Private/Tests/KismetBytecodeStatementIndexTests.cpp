@@ -0,0 +1,122 @@
+#include "Misc/AutomationTest.h"
+#include "Toolkit/KismetBytecodeScanner.h"
+#include "Toolkit/KismetBytecodeStatementIndex.h"
+#include "UObject/Class.h"
+#include "UObject/Package.h"
+#include "TestBytecodeWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Writes a script with top level jumps and a switch expression nested into the return statement */
+static FTestBytecodeWriter WriteStatementIndexTestScript(TArray<int32>& OutNestedJumpTargets) {
+	FTestBytecodeWriter Writer;
+	Writer.BeginStatement(EX_Jump);
+	const int32 JumpOperand = Writer.WriteSkipCount(0);
+	
+	Writer.BeginStatement(EX_JumpIfNot);
+	const int32 JumpIfNotOperand = Writer.WriteSkipCount(0);
+	Writer.WriteOpcode(EX_True);
+
+	Writer.BeginStatement(EX_PushExecutionFlow);
+	const int32 PushExecutionFlowOperand = Writer.WriteSkipCount(0);
+
+	Writer.BeginStatement(EX_Return);
+	Writer.WriteOpcode(EX_SwitchValue);
+	Writer.Script.Add(1);
+	Writer.Script.Add(0);
+	const int32 SwitchEndOperand = Writer.WriteSkipCount(0);
+	Writer.WriteOpcode(EX_IntOne);
+	Writer.WriteOpcode(EX_IntOne);
+	const int32 NextCaseOperand = Writer.WriteSkipCount(0);
+	Writer.WriteOpcode(EX_True);
+	const int32 NextCaseOffset = Writer.Script.Num();
+	Writer.WriteOpcode(EX_False);
+	const int32 SwitchEndOffset = Writer.Script.Num();
+	
+	Writer.BeginStatement(EX_EndOfScript);
+
+	Writer.PatchSkipCount(JumpOperand, Writer.StatementIndices[2]);
+	Writer.PatchSkipCount(JumpIfNotOperand, Writer.StatementIndices[3]);
+	Writer.PatchSkipCount(PushExecutionFlowOperand, Writer.StatementIndices[3]);
+	Writer.PatchSkipCount(NextCaseOperand, NextCaseOffset);
+	Writer.PatchSkipCount(SwitchEndOperand, SwitchEndOffset);
+	OutNestedJumpTargets = {NextCaseOffset, SwitchEndOffset};
+	return Writer;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeStatementIndexTest, "SML.Toolkit.KismetBytecodeStatementIndex", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FKismetBytecodeStatementIndexTest::RunTest(const FString& Parameters) {
+	TArray<int32> NestedJumpTargets;
+	const FTestBytecodeWriter Writer = WriteStatementIndexTestScript(NestedJumpTargets);
+	const TArray<int32>& Statements = Writer.StatementIndices;
+	const FKismetBytecodeStatementIndex StatementIndex(Writer.Script);
+
+	TestTrue(TEXT("Index is complete"), StatementIndex.IsComplete());
+	TestTrue(TEXT("Statement offsets"), StatementIndex.GetStatementOffsets() == Statements);
+	TestTrue(TEXT("Return statement offsets"), StatementIndex.GetReturnStatementOffsets() == TArray<int32>{Statements[3]});
+	TestEqual(TEXT("First return statement"), StatementIndex.GetFirstReturnStatementOffset(), Statements[3]);
+
+	//Targets of the top level jumps and of the switch nested into the return statement are all reported
+	TestTrue(TEXT("Jump target"), StatementIndex.IsJumpTarget(Statements[2]));
+	TestTrue(TEXT("Conditional jump target"), StatementIndex.IsJumpTarget(Statements[3]));
+	for (const int32 NestedJumpTarget : NestedJumpTargets) {
+		TestTrue(FString::Printf(TEXT("Nested jump target %d"), NestedJumpTarget), StatementIndex.IsJumpTarget(NestedJumpTarget));
+	}
+	TestFalse(TEXT("Statement which is not a jump target"), StatementIndex.IsJumpTarget(Statements[1]));
+	TestEqual(TEXT("Amount of unique jump targets"), StatementIndex.GetJumpTargets().Num(), 2 + NestedJumpTargets.Num());
+
+	for (int32 ScriptOffset = 0; ScriptOffset < Writer.Script.Num(); ScriptOffset++) {
+		int32 ExpectedLength;
+		int32 StatementLength;
+		const bool bExpectedStatement = FKismetBytecodeScanner::GetStatementLength(Writer.Script, ScriptOffset, ExpectedLength);
+		TestEqual(FString::Printf(TEXT("Statement at %d"), ScriptOffset), StatementIndex.GetStatementLength(ScriptOffset, StatementLength), bExpectedStatement);
+		if (bExpectedStatement) {
+			TestEqual(FString::Printf(TEXT("Length of statement at %d"), ScriptOffset), StatementLength, ExpectedLength);
+		}
+	}
+	TestEqual(TEXT("Statement after the first one"), StatementIndex.FindStatementAtOrAfter(Statements[0] + 1), Statements[1]);
+	TestEqual(TEXT("Statement after the end"), StatementIndex.FindStatementAtOrAfter(Writer.Script.Num()), (int32) INDEX_NONE);
+
+	//Truncated script is indexed up to the first malformed statement
+	const TArray<uint8> TruncatedScript(Writer.Script.GetData(), Statements[3] + 2);
+	const FKismetBytecodeStatementIndex TruncatedStatementIndex(TruncatedScript);
+	TestFalse(TEXT("Truncated index is complete"), TruncatedStatementIndex.IsComplete());
+	TestEqual(TEXT("Truncated index statements"), TruncatedStatementIndex.GetStatementOffsets().Num(), 3);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKismetBytecodeStatementIndexCacheTest, "SML.Toolkit.KismetBytecodeStatementIndex.Cache", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FKismetBytecodeStatementIndexCacheTest::RunTest(const FString& Parameters) {
+	TArray<int32> NestedJumpTargets;
+	const FTestBytecodeWriter Writer = WriteStatementIndexTestScript(NestedJumpTargets);
+	const TArray<int32>& Statements = Writer.StatementIndices;
+
+	UFunction* Function = NewObject<UFunction>(GetTransientPackage(), NAME_None, RF_Transient);
+	Function->Script = Writer.Script;
+
+	const TSharedRef<const FKismetBytecodeStatementIndex> FirstIndex = FKismetBytecodeStatementIndex::GetStatementIndex(Function);
+	TestTrue(TEXT("Index is cached"), &FKismetBytecodeStatementIndex::GetStatementIndex(Function).Get() == &FirstIndex.Get());
+	TestTrue(TEXT("Original jump target"), FirstIndex->IsJumpTarget(Statements[2]));
+
+	//Rewrite the first jump in place the way blueprint hooking does, index stays cached until it is invalidated
+	FPlatformMemory::WriteUnaligned<CodeSkipSizeType>(&Function->Script[Statements[0] + 1], Statements[3]);
+	TestTrue(TEXT("Index is cached after in place rewrite"), &FKismetBytecodeStatementIndex::GetStatementIndex(Function).Get() == &FirstIndex.Get());
+	
+	FKismetBytecodeStatementIndex::InvalidateStatementIndex(Function);
+	const TSharedRef<const FKismetBytecodeStatementIndex> RewrittenIndex = FKismetBytecodeStatementIndex::GetStatementIndex(Function);
+	TestTrue(TEXT("Index is rebuilt after invalidation"), &RewrittenIndex.Get() != &FirstIndex.Get());
+	TestFalse(TEXT("Rewritten jump no longer targets the old statement"), RewrittenIndex->IsJumpTarget(Statements[2]));
+	TestTrue(TEXT("Rewritten jump targets the new statement"), RewrittenIndex->IsJumpTarget(Statements[3]));
+	
+	//Appending code changes script size, so index is rebuilt without explicit invalidation
+	Function->Script.Add(EX_Nothing);
+	const TSharedRef<const FKismetBytecodeStatementIndex> ResizedIndex = FKismetBytecodeStatementIndex::GetStatementIndex(Function);
+	TestEqual(TEXT("Statements after resize"), ResizedIndex->GetStatementOffsets().Num(), Statements.Num() + 1);
+	
+	FKismetBytecodeStatementIndex::InvalidateStatementIndex(Function);
+	return true;
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include "Misc/AutomationTest.h"
+#include "Misc/Base64.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Network/NetworkHandler.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Reader positioned at the start of the data written to the writer, the way received bunch is */
+static FBitReader MakeLoopbackReader(FBitWriter& Writer) {
+	return FBitReader(Writer.GetData(), Writer.GetNumBits());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModNetworkBinaryPayloadTest, "SML.Network.BinaryPayload", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FModNetworkBinaryPayloadTest::RunTest(const FString& Parameters) {
+	//Payload written as TArray<uint8> is read back unchanged, including the largest allowed one
+	for (const int32 PayloadSize : {0, 1, 57, UModNetworkHandler::MaxBinaryMessageSize}) {
+		TArray<uint8> Payload;
+		for (int32 i = 0; i < PayloadSize; i++) {
+			Payload.Add((uint8) (i * 7));
+		}
+		FBitWriter Writer(0, true);
+		Writer << Payload;
+		FBitReader Reader = MakeLoopbackReader(Writer);
+		TArray<uint8> ReceivedPayload;
+		TestTrue(FString::Printf(TEXT("Payload of %d bytes is received"), PayloadSize), UModNetworkHandler::ReceiveBinaryPayload(Reader, UModNetworkHandler::MaxBinaryMessageSize, ReceivedPayload));
+		TestTrue(FString::Printf(TEXT("Payload of %d bytes is unchanged"), PayloadSize), ReceivedPayload == Payload);
+	}
+
+	//Payload over the limit is rejected before anything is allocated for it
+	TArray<uint8> OversizedPayload;
+	OversizedPayload.SetNumZeroed(UModNetworkHandler::MaxBinaryMessageSize + 1);
+	FBitWriter OversizedWriter(0, true);
+	OversizedWriter << OversizedPayload;
+	FBitReader OversizedReader = MakeLoopbackReader(OversizedWriter);
+	TArray<uint8> ReceivedPayload;
+	TestFalse(TEXT("Oversized payload is rejected"), UModNetworkHandler::ReceiveBinaryPayload(OversizedReader, UModNetworkHandler::MaxBinaryMessageSize, ReceivedPayload));
+	TestTrue(TEXT("Oversized payload marks reader as errored"), OversizedReader.IsError());
+	TestEqual(TEXT("Oversized payload is not read"), ReceivedPayload.Num(), 0);
+
+	//Announced sizes not backed by the data left in the bunch, or negative ones, are rejected as well
+	for (int32 AnnouncedSize : {1024, -1}) {
+		FBitWriter MalformedWriter(0, true);
+		MalformedWriter << AnnouncedSize;
+		uint8 Data[16] = {};
+		MalformedWriter.Serialize(Data, sizeof(Data));
+		FBitReader MalformedReader = MakeLoopbackReader(MalformedWriter);
+		TArray<uint8> MalformedPayload;
+		TestFalse(FString::Printf(TEXT("Announced size %d is rejected"), AnnouncedSize), UModNetworkHandler::ReceiveBinaryPayload(MalformedReader, UModNetworkHandler::MaxBinaryMessageSize, MalformedPayload));
+		TestEqual(FString::Printf(TEXT("Announced size %d is not read"), AnnouncedSize), MalformedPayload.Num(), 0);
+	}
+
+	//Sender refuses oversized payloads before touching the connection
+	AddExpectedError(TEXT("is too large"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Oversized payload is not sent"), UModNetworkHandler::SendBinaryMessage(nullptr, FMessageType{TEXT("SML"), 0}, OversizedPayload));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModNetworkBinaryMessageLoopbackTest, "SML.Network.BinaryMessageLoopback", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FModNetworkBinaryMessageLoopbackTest::RunTest(const FString& Parameters) {
+	//Compares the wire size of the state a mod pushes during join, sent as string messages flushed one by one and as coalesced binary messages
+	const int32 NumMessages = 64;
+	const int32 PayloadSize = 48;
+	//Default MaxPacket of IP net connections
+	const int32 MaxPacketSize = 1024;
+	//Message type indices used by NMT_ModMessage, NMT_ModMessageId and NMT_ModBinaryMessage
+	uint8 StringMessageType = 40;
+	uint8 ModIdMessageType = 41;
+	uint8 BinaryMessageType = 42;
+	FString ModId = TEXT("ExampleMod");
+	int32 MessageId = 1;
+
+	TArray<TArray<uint8>> Payloads;
+	for (int32 MessageIndex = 0; MessageIndex < NumMessages; MessageIndex++) {
+		TArray<uint8>& Payload = Payloads.AddDefaulted_GetRef();
+		for (int32 i = 0; i < PayloadSize; i++) {
+			Payload.Add((uint8) (MessageIndex * 13 + i));
+		}
+	}
+
+	//String messages carry the payload encoded as text and the mod ID every time, and every one of them is flushed into its own packet
+	int32 StringBytes = 0;
+	int32 StringPackets = 0;
+	TArray<TArray<uint8>> ReceivedStringPayloads;
+	for (const TArray<uint8>& Payload : Payloads) {
+		FBitWriter Writer(0, true);
+		FString Content = FBase64::Encode(Payload);
+		Writer << StringMessageType << ModId << MessageId << Content;
+		StringBytes += Writer.GetNumBytes();
+		StringPackets += FMath::DivideAndRoundUp((int32) Writer.GetNumBytes(), MaxPacketSize);
+
+		FBitReader Reader = MakeLoopbackReader(Writer);
+		uint8 ReceivedMessageType; FString ReceivedModId; int32 ReceivedMessageId; FString ReceivedContent;
+		Reader << ReceivedMessageType << ReceivedModId << ReceivedMessageId << ReceivedContent;
+		FBase64::Decode(ReceivedContent, ReceivedStringPayloads.AddDefaulted_GetRef());
+	}
+
+	//Binary messages refer to the mod ID announced once by its index, and are flushed together on the next tick
+	FBitWriter BinaryWriter(0, true);
+	uint16 ModIdIndex = 0;
+	BinaryWriter << ModIdMessageType << ModIdIndex << ModId;
+	for (const TArray<uint8>& Payload : Payloads) {
+		TArray<uint8> MutablePayload = Payload;
+		BinaryWriter << BinaryMessageType << ModIdIndex << MessageId << MutablePayload;
+	}
+	const int32 BinaryBytes = BinaryWriter.GetNumBytes();
+	const int32 BinaryPackets = FMath::DivideAndRoundUp(BinaryBytes, MaxPacketSize);
+
+	TArray<TArray<uint8>> ReceivedBinaryPayloads;
+	FBitReader BinaryReader = MakeLoopbackReader(BinaryWriter);
+	uint8 ReceivedMessageType; uint16 ReceivedModIdIndex; FString ReceivedModId; int32 ReceivedMessageId;
+	BinaryReader << ReceivedMessageType << ReceivedModIdIndex << ReceivedModId;
+	TestEqual(TEXT("Received mod ID"), ReceivedModId, ModId);
+	for (int32 MessageIndex = 0; MessageIndex < NumMessages; MessageIndex++) {
+		BinaryReader << ReceivedMessageType << ReceivedModIdIndex << ReceivedMessageId;
+		if (!UModNetworkHandler::ReceiveBinaryPayload(BinaryReader, UModNetworkHandler::MaxBinaryMessageSize, ReceivedBinaryPayloads.AddDefaulted_GetRef())) {
+			AddError(FString::Printf(TEXT("Failed to receive binary message %d"), MessageIndex));
+			break;
+		}
+	}
+
+	TestTrue(TEXT("String payloads received unchanged"), ReceivedStringPayloads == Payloads);
+	TestTrue(TEXT("Binary payloads received unchanged"), ReceivedBinaryPayloads == Payloads);
+	TestTrue(TEXT("Binary messages take less bytes"), BinaryBytes < StringBytes);
+	TestTrue(TEXT("Binary messages take less packets"), BinaryPackets < StringPackets);
+	AddInfo(FString::Printf(TEXT("%d messages of %d bytes: string messages %d bytes in %d packets, binary messages %d bytes in %d packets"),
+		NumMessages, PayloadSize, StringBytes, StringPackets, BinaryBytes, BinaryPackets));
+	return true;
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include "Misc/AutomationTest.h"
+#include "Misc/Crc.h"
+#include "Network/NetworkHandler.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModNetworkTransferLoopbackTest, "SML.Network.TransferLoopback", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FModNetworkTransferLoopbackTest::RunTest(const FString& Parameters) {
+	//Pumps 50MB transfer followed by a small and an empty one through the sender, reassembling them on the other side
+	const int32 LargeTransferSize = 50 * 1024 * 1024;
+	TArray<TArray<uint8>> Payloads;
+	TArray<uint8>& LargePayload = Payloads.AddDefaulted_GetRef();
+	LargePayload.SetNumUninitialized(LargeTransferSize);
+	for (int32 i = 0; i < LargeTransferSize; i++) {
+		LargePayload[i] = (uint8) ((i * 31) ^ (i >> 11));
+	}
+	Payloads.Add(TArray<uint8>{1, 2, 3});
+	Payloads.AddDefaulted();
+
+	FModConnectionState SenderState;
+	TArray<uint32> ExpectedChecksums;
+	for (const TArray<uint8>& Payload : Payloads) {
+		ExpectedChecksums.Add(FCrc::MemCrc32(Payload.GetData(), Payload.Num()));
+		FOutgoingModTransfer& Transfer = SenderState.OutgoingTransfers.AddDefaulted_GetRef();
+		Transfer.TransferId = SenderState.NextTransferId++;
+		Transfer.MessageType = FMessageType{TEXT("SML"), 0};
+		Transfer.Data = Payload;
+		Transfer.BytesSent = 0;
+		Transfer.bStarted = false;
+	}
+
+	TMap<int32, TArray<uint8>> ReceivedTransfers;
+	TArray<int32> StartedTransfers;
+	int32 NumTicks = 0;
+	const int32 MaxTicks = LargeTransferSize / UModNetworkHandler::MaxTransferBytesPerTick + 16;
+
+	while (SenderState.OutgoingTransfers.Num() > 0 && NumTicks < MaxTicks) {
+		NumTicks++;
+		//Every 10th tick connection is saturated, and nothing should be sent at all
+		const bool bConnectionReady = NumTicks % 10 != 0;
+		int32 ChunksSentThisTick = 0;
+		
+		const int32 BytesSentThisTick = SenderState.SendOutgoingTransferChunks(UModNetworkHandler::MaxTransferBytesPerTick, UModNetworkHandler::TransferChunkSize, [&]() {
+			return bConnectionReady;
+		}, [&](const FOutgoingModTransfer& Transfer) {
+			StartedTransfers.Add(Transfer.TransferId);
+			ReceivedTransfers.Add(Transfer.TransferId);
+			return true;
+		}, [&](int32 TransferId, const TArray<uint8>& Chunk) {
+			ChunksSentThisTick++;
+			if (Chunk.Num() > UModNetworkHandler::TransferChunkSize) {
+				AddError(FString::Printf(TEXT("Chunk of %d bytes exceeds chunk size"), Chunk.Num()));
+			}
+			TArray<uint8>* ReceivedData = ReceivedTransfers.Find(TransferId);
+			if (ReceivedData == NULL) {
+				AddError(FString::Printf(TEXT("Chunk of transfer %d has been sent before its start"), TransferId));
+				return;
+			}
+			ReceivedData->Append(Chunk);
+		});
+
+		if (BytesSentThisTick > UModNetworkHandler::MaxTransferBytesPerTick) {
+			AddError(FString::Printf(TEXT("Tick %d sent %d bytes, more than the per tick limit"), NumTicks, BytesSentThisTick));
+			break;
+		}
+		if (!bConnectionReady && ChunksSentThisTick != 0) {
+			AddError(FString::Printf(TEXT("Tick %d sent data while connection was not ready"), NumTicks));
+			break;
+		}
+	}
+
+	TestEqual(TEXT("All transfers sent"), SenderState.OutgoingTransfers.Num(), 0);
+	TestTrue(TEXT("Transfers started once each in order"), StartedTransfers == TArray<int32>{0, 1, 2});
+	//Large transfer has to be split over as many ticks as the per tick limit requires, plus the saturated ones
+	const int32 MinTicks = LargeTransferSize / UModNetworkHandler::MaxTransferBytesPerTick;
+	TestTrue(FString::Printf(TEXT("Transfer took %d ticks, at least %d expected"), NumTicks, MinTicks), NumTicks >= MinTicks);
+
+	for (int32 TransferId = 0; TransferId < Payloads.Num(); TransferId++) {
+		const TArray<uint8>* ReceivedData = ReceivedTransfers.Find(TransferId);
+		if (ReceivedData == NULL) {
+			AddError(FString::Printf(TEXT("Transfer %d has not been received"), TransferId));
+			continue;
+		}
+		TestEqual(FString::Printf(TEXT("Transfer %d size"), TransferId), ReceivedData->Num(), Payloads[TransferId].Num());
+		TestEqual(FString::Printf(TEXT("Transfer %d checksum"), TransferId), FCrc::MemCrc32(ReceivedData->GetData(), ReceivedData->Num()), ExpectedChecksums[TransferId]);
+	}
+
+	//Transfer which cannot be announced is dropped without sending any chunks
+	FOutgoingModTransfer& RejectedTransfer = SenderState.OutgoingTransfers.AddDefaulted_GetRef();
+	RejectedTransfer.TransferId = SenderState.NextTransferId++;
+	RejectedTransfer.Data = TArray<uint8>{1, 2, 3};
+	RejectedTransfer.BytesSent = 0;
+	RejectedTransfer.bStarted = false;
+	int32 RejectedChunks = 0;
+	SenderState.SendOutgoingTransferChunks(UModNetworkHandler::MaxTransferBytesPerTick, UModNetworkHandler::TransferChunkSize, []() { return true; },
+		[](const FOutgoingModTransfer&) { return false; }, [&](int32, const TArray<uint8>&) { RejectedChunks++; });
+	TestEqual(TEXT("Rejected transfer chunks"), RejectedChunks, 0);
+	TestEqual(TEXT("Rejected transfer is dropped"), SenderState.OutgoingTransfers.Num(), 0);
+	return true;
+}
+
+#endif
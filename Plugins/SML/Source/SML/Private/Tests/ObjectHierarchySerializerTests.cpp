@@ -0,0 +1,70 @@
+#include "Misc/AutomationTest.h"
+#include "Toolkit/ObjectHierarchySerializer.h"
+#include "Toolkit/PropertySerializer.h"
+#include "Util/ObjectMetadata.h"
+#include "UObject/Package.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Serializes object hierarchy of the package starting at the provided object, returning serializer to lookup assigned indices */
+static UObjectHierarchySerializer* SerializeTestHierarchy(UPackage* Package, UObject* RootObject, FString& OutJsonString) {
+	UPropertySerializer* PropertySerializer = NewObject<UPropertySerializer>();
+	UObjectHierarchySerializer* ObjectSerializer = NewObject<UObjectHierarchySerializer>();
+	ObjectSerializer->Initialize(Package, PropertySerializer);
+	ObjectSerializer->SerializeObject(RootObject);
+
+	const TArray<TSharedPtr<FJsonValue>> Objects = ObjectSerializer->FinalizeSerialization();
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutJsonString);
+	FJsonSerializer::Serialize(Objects, Writer);
+	return ObjectSerializer;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FObjectHierarchySerializerOrderTest, "SML.Toolkit.ObjectHierarchySerializer.ObjectOrder", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FObjectHierarchySerializerOrderTest::RunTest(const FString& Parameters) {
+	//Root references First and Second, and First references Nested, so depth-first order differs from breadth-first one
+	UPackage* Package = CreatePackage(NULL, TEXT("/Temp/SMLObjectHierarchySerializerTest"));
+	UObjectMetadata* RootObject = NewObject<UObjectMetadata>(Package, TEXT("Root"));
+	UObjectMetadata* FirstObject = RootObject->GetOrCreateSubObject<UObjectMetadata>(TEXT("First"));
+	UObjectMetadata* SecondObject = RootObject->GetOrCreateSubObject<UObjectMetadata>(TEXT("Second"));
+	UObjectMetadata* NestedObject = FirstObject->GetOrCreateSubObject<UObjectMetadata>(TEXT("Nested"));
+
+	FString JsonString;
+	UObjectHierarchySerializer* ObjectSerializer = SerializeTestHierarchy(Package, RootObject, JsonString);
+	//Objects which have already been serialized just return their existing index
+	const int32 RootIndex = ObjectSerializer->SerializeObject(RootObject);
+	const int32 FirstIndex = ObjectSerializer->SerializeObject(FirstObject);
+	const int32 SecondIndex = ObjectSerializer->SerializeObject(SecondObject);
+	const int32 NestedIndex = ObjectSerializer->SerializeObject(NestedObject);
+
+	//Objects are indexed in the order they are first referenced while properties are serialized depth-first
+	TestEqual(TEXT("Root object index"), RootIndex, 0);
+	TestTrue(TEXT("First object comes after the root"), FirstIndex > RootIndex);
+	TestTrue(TEXT("Nested object comes right after the first one's header"), NestedIndex > FirstIndex);
+	TestTrue(TEXT("Second object comes after the nested one"), SecondIndex > NestedIndex);
+
+	//Same hierarchy always produces exactly the same output
+	FString SecondJsonString;
+	SerializeTestHierarchy(Package, RootObject, SecondJsonString);
+	TestEqual(TEXT("Repeated serialization output"), SecondJsonString, JsonString);
+
+	//Objects referenced by the root object properties are written as their indices
+	TArray<TSharedPtr<FJsonValue>> Objects;
+	const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, Objects) || !Objects.IsValidIndex(RootIndex)) {
+		AddError(TEXT("Failed to read back serialized objects"));
+		return false;
+	}
+	const TSharedPtr<FJsonObject> RootProperties = Objects[RootIndex]->AsObject()->GetObjectField(TEXT("Properties"));
+	TArray<int32> StoredSubobjectIndices;
+	for (const TSharedPtr<FJsonValue>& Value : RootProperties->GetArrayField(TEXT("StoredSubobjects"))) {
+		StoredSubobjectIndices.Add((int32) Value->AsNumber());
+	}
+	TestTrue(TEXT("Root object references"), StoredSubobjectIndices == TArray<int32>{FirstIndex, SecondIndex});
+	return true;
+}
+
+#endif
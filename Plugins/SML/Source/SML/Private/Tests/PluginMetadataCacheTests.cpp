@@ -0,0 +1,111 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "ModLoading/PluginMetadataCache.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static FFileStatData MakeTestDescriptorStat(int64 FileSize) {
+	return FFileStatData(FDateTime(2021, 1, 1), FDateTime(2021, 1, 1), FDateTime(2021, 1, 1), FileSize, false, false);
+}
+
+static FString MakeTestDescriptorPath(int32 DescriptorIndex) {
+	return FString::Printf(TEXT("../../../FactoryGame/Mods/TestMod%d/TestMod%d.uplugin"), DescriptorIndex, DescriptorIndex);
+}
+
+static FString MakeTestDescriptor(int32 DescriptorIndex) {
+	return FString::Printf(TEXT("{\"FileVersion\": 3, \"SemVersion\": \"1.%d.0\", \"RemoteVersionRange\": \">=1.0.0 <2.0.0\", \"Plugins\": [")
+		TEXT("{\"Name\": \"SML\", \"SemVersion\": \"^3.0.0\"}, {\"Name\": \"TestDependency%d\", \"SemVersion\": \">=1.2.0\"}]}"), DescriptorIndex, DescriptorIndex);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginMetadataCacheTest, "SML.ModLoading.PluginMetadataCache", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FPluginMetadataCacheTest::RunTest(const FString& Parameters) {
+	const FString CacheFilePath = FPaths::AutomationTransientDir() / TEXT("SML/PluginMetadataCacheTest.bin");
+	FSMLPluginDescriptorMetadata Metadata{};
+	Metadata.Version = FVersion(1, 2, 3);
+	Metadata.bAcceptsAnyRemoteVersion = false;
+	Metadata.RemoteVersionRange = FVersionRange::CreateRangeWithMinVersion(Metadata.Version);
+
+	FPluginMetadataCache InitialCache;
+	InitialCache.AddMetadata(MakeTestDescriptorPath(0), MakeTestDescriptorStat(100), 1, Metadata);
+	InitialCache.AddMetadata(MakeTestDescriptorPath(1), MakeTestDescriptorStat(200), 2, Metadata);
+	TestTrue(TEXT("Initial cache saved"), InitialCache.SaveToFile(CacheFilePath));
+
+	//Second plugin has been removed, and the first one is a hit, so nothing has changed except for the stale entry
+	FPluginMetadataCache HitCache;
+	TestTrue(TEXT("Cache loaded"), HitCache.LoadFromFile(CacheFilePath));
+	const FSMLPluginDescriptorMetadata* CachedMetadata = HitCache.FindMetadata(MakeTestDescriptorPath(0), MakeTestDescriptorStat(100));
+	TestTrue(TEXT("Cached metadata found"), CachedMetadata != NULL && CachedMetadata->Version.Compare(Metadata.Version) == 0);
+	TestNull(TEXT("Changed descriptor is a miss"), HitCache.FindMetadata(MakeTestDescriptorPath(1), MakeTestDescriptorStat(201)));
+	TestTrue(TEXT("Cache saved after hits"), HitCache.SaveToFile(CacheFilePath));
+
+	FPluginMetadataCache ReloadedCache;
+	TestTrue(TEXT("Cache reloaded"), ReloadedCache.LoadFromFile(CacheFilePath));
+	TestNotNull(TEXT("Used entry is kept"), ReloadedCache.FindMetadata(MakeTestDescriptorPath(0), MakeTestDescriptorStat(100)));
+	TestNull(TEXT("Stale entry is dropped"), ReloadedCache.FindMetadata(MakeTestDescriptorPath(1), MakeTestDescriptorStat(200)));
+	TestNull(TEXT("Stale entry is not found by hash"), ReloadedCache.FindMetadataByHash(MakeTestDescriptorPath(1), MakeTestDescriptorStat(200), 2));
+
+	IFileManager::Get().Delete(*CacheFilePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginMetadataCacheStartupBenchmark, "SML.ModLoading.PluginMetadataCache.Startup", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FPluginMetadataCacheStartupBenchmark::RunTest(const FString& Parameters) {
+	//Compares metadata loading of a large mod list on the first launch, when every descriptor is parsed, with the following launches
+	const int32 NumDescriptors = 500;
+	const FString CacheFilePath = FPaths::AutomationTransientDir() / TEXT("SML/PluginMetadataCacheBenchmark.bin");
+	IFileManager::Get().Delete(*CacheFilePath);
+
+	TArray<FString> Descriptors;
+	for (int32 DescriptorIndex = 0; DescriptorIndex < NumDescriptors; DescriptorIndex++) {
+		Descriptors.Add(MakeTestDescriptor(DescriptorIndex));
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	FPluginMetadataCache ColdCache;
+	ColdCache.LoadFromFile(CacheFilePath);
+	for (int32 DescriptorIndex = 0; DescriptorIndex < NumDescriptors; DescriptorIndex++) {
+		const FString& Descriptor = Descriptors[DescriptorIndex];
+		TSharedPtr<FJsonObject> DescriptorObject;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Descriptor), DescriptorObject)) {
+			AddError(FString::Printf(TEXT("Failed to parse test descriptor %d"), DescriptorIndex));
+			return false;
+		}
+		FSMLPluginDescriptorMetadata Metadata{};
+		Metadata.Version = FVersion(1, 0, 0);
+		Metadata.bAcceptsAnyRemoteVersion = false;
+		Metadata.Load(FString::Printf(TEXT("TestMod%d"), DescriptorIndex), DescriptorObject);
+
+		const uint64 ContentHash = FPluginMetadataCache::ComputeContentHash(TArray<uint8>(reinterpret_cast<const uint8*>(*Descriptor), Descriptor.Len() * sizeof(TCHAR)));
+		ColdCache.AddMetadata(MakeTestDescriptorPath(DescriptorIndex), MakeTestDescriptorStat(Descriptor.Len()), ContentHash, Metadata);
+	}
+	ColdCache.SaveToFile(CacheFilePath);
+	const double ColdTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	FPluginMetadataCache WarmCache;
+	WarmCache.LoadFromFile(CacheFilePath);
+	int32 NumHits = 0;
+	for (int32 DescriptorIndex = 0; DescriptorIndex < NumDescriptors; DescriptorIndex++) {
+		const FSMLPluginDescriptorMetadata* Metadata = WarmCache.FindMetadata(MakeTestDescriptorPath(DescriptorIndex), MakeTestDescriptorStat(Descriptors[DescriptorIndex].Len()));
+		if (Metadata != NULL && Metadata->Version.Compare(FVersion(1, DescriptorIndex, 0)) == 0 && Metadata->DependenciesVersions.Num() == 2) {
+			NumHits++;
+		}
+	}
+	WarmCache.SaveToFile(CacheFilePath);
+	const double WarmTime = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("Warm cache hits"), NumHits, NumDescriptors);
+	AddInfo(FString::Printf(TEXT("Metadata of %d descriptors: cold start %.2fms, warm start %.2fms"), NumDescriptors, ColdTime * 1000.0, WarmTime * 1000.0));
+
+	IFileManager::Get().Delete(*CacheFilePath);
+	return true;
+}
+
+#endif
@@ -0,0 +1,150 @@
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "ModLoading/PluginModuleLoader.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Stands in for the root module, recording the order in which it receives lifecycle events */
+struct FTestLifecycleModule {
+	FString OwnerPluginName;
+	TArray<FString>* DispatchLog;
+
+	void DispatchLifecycleEvent(ELifecyclePhase Phase) {
+		DispatchLog->Add(OwnerPluginName);
+	}
+};
+
+static TArray<FDiscoveredModule> MakeTestModules(const TArray<FString>& PluginNames) {
+	TArray<FDiscoveredModule> Modules;
+	for (const FString& PluginName : PluginNames) {
+		Modules.Add(FDiscoveredModule{PluginName, nullptr});
+	}
+	return Modules;
+}
+
+static FString JoinModuleNames(const TArray<FDiscoveredModule>& Modules) {
+	TArray<FString> PluginNames;
+	for (const FDiscoveredModule& Module : Modules) {
+		PluginNames.Add(Module.OwnerPluginName);
+	}
+	return FString::Join(PluginNames, TEXT(","));
+}
+
+/** Collects all plugins the provided plugin depends on, directly or through other plugins */
+static void CollectTransitiveDependencies(const TMap<FString, TArray<FString>>& PluginDependencies, const FString& PluginName, TSet<FString>& OutDependencies) {
+	TArray<FString> PluginsToVisit{PluginName};
+	while (PluginsToVisit.Num()) {
+		const TArray<FString>* Dependencies = PluginDependencies.Find(PluginsToVisit.Pop(false));
+		if (Dependencies == NULL) {
+			continue;
+		}
+		for (const FString& Dependency : *Dependencies) {
+			bool bIsAlreadyInSet = false;
+			OutDependencies.Add(Dependency, &bIsAlreadyInSet);
+			if (!bIsAlreadyInSet) {
+				PluginsToVisit.Add(Dependency);
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginModuleLoaderSortTest, "SML.ModLoading.PluginModuleLoader.DependencyLevels", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FPluginModuleLoaderSortTest::RunTest(const FString& Parameters) {
+	//Library plugin has no modules of its own, but still orders modules depending on it after its dependencies
+	TMap<FString, TArray<FString>> PluginDependencies;
+	PluginDependencies.Add(TEXT("ModA"), {TEXT("Library")});
+	PluginDependencies.Add(TEXT("Library"), {TEXT("ModB")});
+	PluginDependencies.Add(TEXT("ModC"), {TEXT("ModB"), TEXT("ModD"), TEXT("OptionalMissing")});
+	const auto GetPluginDependencies = [&](const FString& PluginName) {
+		return PluginDependencies.FindRef(PluginName);
+	};
+
+	TArray<FDiscoveredModule> Modules = MakeTestModules({TEXT("ModD"), TEXT("ModC"), TEXT("ModB"), TEXT("ModA"), TEXT("ModE")});
+	TArray<int32> LevelOffsets;
+	FPluginModuleLoader::SortModulesByDependencyLevel(Modules, LevelOffsets, GetPluginDependencies);
+	TestEqual(TEXT("Sorted modules"), JoinModuleNames(Modules), FString(TEXT("ModD,ModB,ModE,ModC,ModA")));
+	TestTrue(TEXT("Level offsets"), LevelOffsets == TArray<int32>{0, 3});
+
+	//Modules are dispatched level by level, in the sorted order
+	TArray<FString> DispatchLog;
+	TArray<FTestLifecycleModule> RootModuleStorage;
+	for (const FDiscoveredModule& Module : Modules) {
+		RootModuleStorage.Add(FTestLifecycleModule{Module.OwnerPluginName, &DispatchLog});
+	}
+	TArray<FTestLifecycleModule*> RootModules;
+	for (FTestLifecycleModule& RootModule : RootModuleStorage) {
+		RootModules.Add(&RootModule);
+	}
+	FPluginModuleLoader::DispatchLifecycleEventByLevel(RootModules, LevelOffsets, ELifecyclePhase::INITIALIZATION);
+	TestEqual(TEXT("Dispatch order"), FString::Join(DispatchLog, TEXT(",")), JoinModuleNames(Modules));
+
+	//Randomly generated plugin dependency graphs, some of the plugins having no modules
+	FRandomStream RandomStream(0x4D4F44);
+	for (int32 GraphIndex = 0; GraphIndex < 100; GraphIndex++) {
+		const int32 PluginCount = RandomStream.RandRange(1, 30);
+		TArray<FString> PluginNames;
+		for (int32 PluginIndex = 0; PluginIndex < PluginCount; PluginIndex++) {
+			PluginNames.Add(FString::Printf(TEXT("Plugin%d"), PluginIndex));
+		}
+		//Plugins only depend on plugins with lower indices, so the graph has no cycles
+		PluginDependencies.Reset();
+		for (int32 PluginIndex = 1; PluginIndex < PluginCount; PluginIndex++) {
+			TArray<FString>& Dependencies = PluginDependencies.Add(PluginNames[PluginIndex]);
+			const int32 DependencyCount = RandomStream.RandRange(0, 3);
+			for (int32 i = 0; i < DependencyCount; i++) {
+				Dependencies.AddUnique(PluginNames[RandomStream.RandRange(0, PluginIndex - 1)]);
+			}
+		}
+		TArray<FString> DiscoveredPluginNames;
+		for (const FString& PluginName : PluginNames) {
+			if (RandomStream.FRand() < 0.7f) {
+				DiscoveredPluginNames.Insert(PluginName, RandomStream.RandRange(0, DiscoveredPluginNames.Num()));
+			}
+		}
+
+		TArray<FDiscoveredModule> RandomModules = MakeTestModules(DiscoveredPluginNames);
+		TArray<int32> RandomLevelOffsets;
+		FPluginModuleLoader::SortModulesByDependencyLevel(RandomModules, RandomLevelOffsets, GetPluginDependencies);
+
+		const FString GraphName = FString::Printf(TEXT("Graph %d"), GraphIndex);
+		if (RandomModules.Num() != DiscoveredPluginNames.Num()) {
+			AddError(FString::Printf(TEXT("%s has %d sorted modules instead of %d"), *GraphName, RandomModules.Num(), DiscoveredPluginNames.Num()));
+			continue;
+		}
+		TMap<FString, int32> ModuleLevels;
+		for (int32 LevelIndex = 0; LevelIndex < RandomLevelOffsets.Num(); LevelIndex++) {
+			const int32 LevelEnd = LevelIndex + 1 < RandomLevelOffsets.Num() ? RandomLevelOffsets[LevelIndex + 1] : RandomModules.Num();
+			for (int32 ModuleIndex = RandomLevelOffsets[LevelIndex]; ModuleIndex < LevelEnd; ModuleIndex++) {
+				ModuleLevels.Add(RandomModules[ModuleIndex].OwnerPluginName, LevelIndex);
+				//Discovery order is kept inside of the level
+				if (ModuleIndex > RandomLevelOffsets[LevelIndex] &&
+					DiscoveredPluginNames.IndexOfByKey(RandomModules[ModuleIndex - 1].OwnerPluginName) > DiscoveredPluginNames.IndexOfByKey(RandomModules[ModuleIndex].OwnerPluginName)) {
+					AddError(FString::Printf(TEXT("%s level %d does not keep discovery order"), *GraphName, LevelIndex));
+				}
+			}
+		}
+		for (const FDiscoveredModule& Module : RandomModules) {
+			const int32 ModuleLevel = ModuleLevels.FindChecked(Module.OwnerPluginName);
+			TSet<FString> Dependencies;
+			CollectTransitiveDependencies(PluginDependencies, Module.OwnerPluginName, Dependencies);
+
+			//Modules of all dependencies are in the earlier levels, and every module past the first level has one in the level right before it
+			int32 MaxDependencyLevel = -1;
+			for (const FString& Dependency : Dependencies) {
+				if (const int32* DependencyLevel = ModuleLevels.Find(Dependency)) {
+					if (*DependencyLevel >= ModuleLevel) {
+						AddError(FString::Printf(TEXT("%s module %s is not after its dependency %s"), *GraphName, *Module.OwnerPluginName, *Dependency));
+					}
+					MaxDependencyLevel = FMath::Max(MaxDependencyLevel, *DependencyLevel);
+				}
+			}
+			if (MaxDependencyLevel != ModuleLevel - 1) {
+				AddError(FString::Printf(TEXT("%s module %s is at level %d, but its last dependency is at level %d"), *GraphName, *Module.OwnerPluginName, ModuleLevel, MaxDependencyLevel));
+			}
+		}
+	}
+	return true;
+}
+
+#endif
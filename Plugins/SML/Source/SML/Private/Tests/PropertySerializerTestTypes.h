@@ -0,0 +1,81 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Engine/EngineTypes.h"
+#include "PropertySerializerTestTypes.generated.h"
+
+/** Enumeration used by the property serializer automation tests */
+UENUM()
+enum class EPropertySerializerTestEnum : uint8 {
+	First,
+	Second
+};
+
+/** Struct nested into the property serializer test row */
+USTRUCT()
+struct FPropertySerializerTestNested {
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	int32 Value;
+
+	UPROPERTY()
+	FString Label;
+};
+
+/** Data table row covering every kind of property value the property serializer handles without an object hierarchy */
+USTRUCT()
+struct FPropertySerializerTestRow : public FTableRowBase {
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	int32 IntValue;
+
+	UPROPERTY()
+	float FloatValue;
+
+	UPROPERTY()
+	bool bBoolValue;
+
+	UPROPERTY()
+	FString StringValue;
+
+	UPROPERTY()
+	FName NameValue;
+
+	UPROPERTY()
+	EPropertySerializerTestEnum EnumValue;
+
+	UPROPERTY()
+	TEnumAsByte<ECollisionChannel> ByteEnumValue;
+
+	UPROPERTY()
+	int32 FixedArray[2];
+
+	UPROPERTY()
+	TArray<int32> ArrayValue;
+
+	UPROPERTY()
+	TMap<FString, int32> MapValue;
+
+	UPROPERTY()
+	TSet<FName> SetValue;
+
+	UPROPERTY()
+	FPropertySerializerTestNested NestedValue;
+
+	UPROPERTY()
+	TArray<FPropertySerializerTestNested> NestedArray;
+
+	UPROPERTY()
+	UClass* ClassValue;
+
+	UPROPERTY()
+	TSoftObjectPtr<UObject> SoftObjectValue;
+
+	UPROPERTY(Transient)
+	int32 TransientValue;
+
+	UPROPERTY()
+	int32 BlacklistedValue;
+};
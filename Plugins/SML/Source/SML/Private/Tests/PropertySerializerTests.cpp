@@ -0,0 +1,117 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Toolkit/ObjectHierarchySerializer.h"
+#include "Toolkit/PropertySerializer.h"
+#include "UObject/Package.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "PropertySerializerTestTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static FPropertySerializerTestRow MakeTestRow(int32 RowIndex) {
+	FPropertySerializerTestRow Row;
+	Row.IntValue = 42 + RowIndex;
+	Row.FloatValue = 1.5f;
+	Row.bBoolValue = true;
+	Row.StringValue = TEXT("Text");
+	Row.NameValue = TEXT("TestName");
+	Row.EnumValue = EPropertySerializerTestEnum::Second;
+	Row.ByteEnumValue = ECC_Pawn;
+	Row.FixedArray[0] = 1;
+	Row.FixedArray[1] = 2;
+	Row.ArrayValue = {3, 4, 5};
+	Row.MapValue.Add(TEXT("First"), 1);
+	Row.MapValue.Add(TEXT("Second"), 2);
+	Row.SetValue.Add(TEXT("Alpha"));
+	Row.SetValue.Add(TEXT("Beta"));
+	Row.NestedValue.Value = 7;
+	Row.NestedValue.Label = TEXT("Nested");
+	Row.NestedArray.Add(FPropertySerializerTestNested{8, TEXT("A")});
+	Row.ClassValue = UObject::StaticClass();
+	Row.TransientValue = 9;
+	Row.BlacklistedValue = 10;
+	return Row;
+}
+
+static FString WriteCondensedJson(const TSharedRef<FJsonObject>& JsonObject) {
+	FString JsonString;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonString);
+	FJsonSerializer::Serialize(JsonObject, Writer);
+	return JsonString;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPropertySerializerGoldenTest, "SML.Toolkit.PropertySerializer.Golden", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FPropertySerializerGoldenTest::RunTest(const FString& Parameters) {
+	//Expected output in the format produced before serialization plans were introduced. Values are exactly representable as doubles
+	const FString ExpectedCommonJson = TEXT("{\"IntValue\":42,\"FloatValue\":1.5,\"bBoolValue\":true,\"StringValue\":\"Text\",\"NameValue\":\"TestName\",")
+		TEXT("\"EnumValue\":\"EPropertySerializerTestEnum::Second\",\"ByteEnumValue\":\"ECC_Pawn\",\"FixedArray\":[1,2],\"ArrayValue\":[3,4,5],")
+		TEXT("\"MapValue\":[{\"Key\":\"First\",\"Value\":1},{\"Key\":\"Second\",\"Value\":2}],\"SetValue\":[\"Alpha\",\"Beta\"],")
+		TEXT("\"NestedValue\":{\"Value\":7,\"Label\":\"Nested\"},\"NestedArray\":[{\"Value\":8,\"Label\":\"A\"}],")
+		TEXT("\"ClassValue\":\"/Script/CoreUObject.Object\",\"SoftObjectValue\":\"\"");
+	const FString ExpectedUnfilteredJson = ExpectedCommonJson + TEXT(",\"TransientValue\":9,\"BlacklistedValue\":10}");
+	const FString ExpectedFilteredJson = ExpectedCommonJson + TEXT("}");
+
+	UScriptStruct* RowStruct = FPropertySerializerTestRow::StaticStruct();
+	const FPropertySerializerTestRow Row = MakeTestRow(0);
+
+	//Without the object hierarchy serializer, all properties are serialized
+	UPropertySerializer* PropertySerializer = NewObject<UPropertySerializer>();
+	TestEqual(TEXT("Unfiltered struct"), WriteCondensedJson(PropertySerializer->SerializeStruct(RowStruct, &Row)), ExpectedUnfilteredJson);
+	//Second run executes the cached plan
+	TestEqual(TEXT("Unfiltered struct with cached plan"), WriteCondensedJson(PropertySerializer->SerializeStruct(RowStruct, &Row)), ExpectedUnfilteredJson);
+
+	//With it, transient and blacklisted properties are skipped, including blacklist changes made after the plan has been compiled
+	UObjectHierarchySerializer* ObjectSerializer = NewObject<UObjectHierarchySerializer>();
+	ObjectSerializer->Initialize(GetTransientPackage(), PropertySerializer);
+	const FString FilteredJsonWithBlacklistedValue = WriteCondensedJson(PropertySerializer->SerializeStruct(RowStruct, &Row));
+	TestEqual(TEXT("Filtered struct"), FilteredJsonWithBlacklistedValue, ExpectedCommonJson + TEXT(",\"BlacklistedValue\":10}"));
+	PropertySerializer->DisablePropertySerialization(RowStruct, GET_MEMBER_NAME_CHECKED(FPropertySerializerTestRow, BlacklistedValue));
+	TestEqual(TEXT("Filtered struct with blacklisted property"), WriteCondensedJson(PropertySerializer->SerializeStruct(RowStruct, &Row)), ExpectedFilteredJson);
+
+	//Custom serializers set after the plan has been compiled are used as well
+	PropertySerializer->SetCustomSerializer(RowStruct, GET_MEMBER_NAME_CHECKED(FPropertySerializerTestRow, IntValue), [](FProperty* Property, const void* Value) -> TSharedRef<FJsonValue> {
+		return MakeShareable(new FJsonValueString(TEXT("Custom")));
+	});
+	const FString ExpectedCustomJson = ExpectedFilteredJson.Replace(TEXT("\"IntValue\":42"), TEXT("\"IntValue\":\"Custom\""));
+	TestEqual(TEXT("Filtered struct with custom serializer"), WriteCondensedJson(PropertySerializer->SerializeStruct(RowStruct, &Row)), ExpectedCustomJson);
+
+	//Deserializing the output has to produce the same value again
+	UPropertySerializer* RoundTripSerializer = NewObject<UPropertySerializer>();
+	FPropertySerializerTestRow DeserializedRow;
+	RoundTripSerializer->DeserializeStruct(RowStruct, RoundTripSerializer->SerializeStruct(RowStruct, &Row), &DeserializedRow);
+	TestEqual(TEXT("Round trip"), WriteCondensedJson(RoundTripSerializer->SerializeStruct(RowStruct, &DeserializedRow)), ExpectedUnfilteredJson);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPropertySerializerDataTableBenchmark, "SML.Toolkit.PropertySerializer.DataTable", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FPropertySerializerDataTableBenchmark::RunTest(const FString& Parameters) {
+	//Dumps every row of a large synthetic data table, the way data table assets are dumped
+	const int32 NumRows = 20000;
+	UDataTable* DataTable = NewObject<UDataTable>(GetTransientPackage(), NAME_None, RF_Transient);
+	DataTable->RowStruct = FPropertySerializerTestRow::StaticStruct();
+	for (int32 RowIndex = 0; RowIndex < NumRows; RowIndex++) {
+		DataTable->AddRow(*FString::Printf(TEXT("Row%d"), RowIndex), MakeTestRow(RowIndex));
+	}
+
+	UPropertySerializer* PropertySerializer = NewObject<UPropertySerializer>();
+	UObjectHierarchySerializer* ObjectSerializer = NewObject<UObjectHierarchySerializer>();
+	ObjectSerializer->Initialize(GetTransientPackage(), PropertySerializer);
+
+	int32 NumSerializedFields = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (const TPair<FName, uint8*>& RowPair : DataTable->GetRowMap()) {
+		NumSerializedFields += PropertySerializer->SerializeStruct(DataTable->RowStruct, RowPair.Value)->Values.Num();
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	//Every row has all properties except for the transient one
+	TestEqual(TEXT("Serialized fields"), NumSerializedFields, NumRows * 16);
+	AddInfo(FString::Printf(TEXT("Serialized %d data table rows in %.2fms, %.0f rows per second"), NumRows, ElapsedTime * 1000.0, ElapsedTime > 0.0 ? NumRows / ElapsedTime : 0.0));
+	return true;
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet/KismetStringLibrary.h"
+#include "Reflection/BlueprintReflectedObject.h"
+#include "Reflection/ReflectedFunctionCall.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectedFunctionCallTest, "SML.Reflection.ReflectedFunctionCall", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FReflectedFunctionCallTest::RunTest(const FString& Parameters) {
+	//Static library functions are called on the class default object
+	UObject* MathLibrary = UKismetMathLibrary::StaticClass()->GetDefaultObject();
+	UObject* StringLibrary = UKismetStringLibrary::StaticClass()->GetDefaultObject();
+
+	FReflectedFunctionCall FunctionCall(MathLibrary->FindFunction(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Add_IntInt)));
+	const int32 FirstIndex = FunctionCall.FindParameterIndex(TEXT("A"));
+	const int32 SecondIndex = FunctionCall.FindParameterIndex(TEXT("B"));
+	TestTrue(TEXT("Parameters found"), FirstIndex != INDEX_NONE && SecondIndex != INDEX_NONE && FunctionCall.GetReturnValueIndex() != INDEX_NONE);
+	FunctionCall.SetArgument<FIntProperty>(FirstIndex, 40);
+	FunctionCall.SetArgument<FIntProperty>(SecondIndex, 2);
+	FunctionCall.Invoke(MathLibrary);
+	TestEqual(TEXT("Prepared call result"), FunctionCall.GetResult<FIntProperty>(FunctionCall.GetReturnValueIndex()), 42);
+	//Arguments persist between calls
+	FunctionCall.SetArgument<FIntProperty>(SecondIndex, 3);
+	FunctionCall.Invoke(MathLibrary);
+	TestEqual(TEXT("Prepared call result with persisted argument"), FunctionCall.GetResult<FIntProperty>(FunctionCall.GetReturnValueIndex()), 43);
+	FunctionCall.ResetParameters();
+	TestEqual(TEXT("Reset argument"), FunctionCall.GetResult<FIntProperty>(FirstIndex), 0);
+
+	//Reflected object exposes parameters, including ones that are not plain old data, as properties
+	FReflectedObject StringCall{};
+	StringCall.SetupFromFunctionCall(StringLibrary, GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, Concat_StrStr));
+	StringCall.SetStrProperty(TEXT("A"), TEXT("Satisfactory "));
+	StringCall.SetStrProperty(TEXT("B"), TEXT("Mod Loader"));
+	TestTrue(TEXT("Reflected call invoked"), StringCall.InvokeFunction());
+	TestEqual(TEXT("Reflected call result"), StringCall.GetStrProperty(TEXT("ReturnValue")), FString(TEXT("Satisfactory Mod Loader")));
+	TestEqual(TEXT("Reflected call parameters"), StringCall.GetReflectedProperties().Num(), 3);
+	TestEqual(TEXT("Missing parameter"), StringCall.GetStrProperty(TEXT("C")), FString());
+
+	FReflectedObject MissingCall{};
+	MissingCall.SetupFromFunctionCall(StringLibrary, TEXT("SMLMissingFunction"));
+	TestFalse(TEXT("Missing function is not invoked"), MissingCall.InvokeFunction());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectedFunctionCallBenchmark, "SML.Reflection.ReflectedFunctionCall.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FReflectedFunctionCallBenchmark::RunTest(const FString& Parameters) {
+	const int32 NumCalls = 100000;
+	UObject* MathLibrary = UKismetMathLibrary::StaticClass()->GetDefaultObject();
+	UFunction* Function = MathLibrary->FindFunction(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Add_IntInt));
+	const FName FirstName = TEXT("A");
+	const FName SecondName = TEXT("B");
+	const FName ReturnValueName = TEXT("ReturnValue");
+	int64 ExpectedSum = 0;
+	for (int32 CallIndex = 0; CallIndex < NumCalls; CallIndex++) {
+		ExpectedSum += CallIndex + 1;
+	}
+
+	//Native call with the parameter struct laid out by hand
+	struct FAddIntIntParams {
+		int32 A;
+		int32 B;
+		int32 ReturnValue;
+	};
+	int64 NativeSum = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 CallIndex = 0; CallIndex < NumCalls; CallIndex++) {
+		FAddIntIntParams Params{CallIndex, 1, 0};
+		MathLibrary->ProcessEvent(Function, &Params);
+		NativeSum += Params.ReturnValue;
+	}
+	const double NativeTime = FPlatformTime::Seconds() - StartTime;
+
+	//Parameter buffer allocated, initialized and accessed by name on every call
+	int64 UnpreparedSum = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 CallIndex = 0; CallIndex < NumCalls; CallIndex++) {
+		uint8* ParameterBuffer = static_cast<uint8*>(FMemory::Malloc(Function->ParmsSize, Function->GetMinAlignment()));
+		FMemory::Memzero(ParameterBuffer, Function->ParmsSize);
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It) {
+			It->InitializeValue_InContainer(ParameterBuffer);
+		}
+		CastField<FIntProperty>(Function->FindPropertyByName(FirstName))->SetPropertyValue_InContainer(ParameterBuffer, CallIndex);
+		CastField<FIntProperty>(Function->FindPropertyByName(SecondName))->SetPropertyValue_InContainer(ParameterBuffer, 1);
+		MathLibrary->ProcessEvent(Function, ParameterBuffer);
+		UnpreparedSum += CastField<FIntProperty>(Function->FindPropertyByName(ReturnValueName))->GetPropertyValue_InContainer(ParameterBuffer);
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It) {
+			It->DestroyValue_InContainer(ParameterBuffer);
+		}
+		FMemory::Free(ParameterBuffer);
+	}
+	const double UnpreparedTime = FPlatformTime::Seconds() - StartTime;
+
+	//Prepared call reused for all calls, arguments written by index
+	int64 PreparedSum = 0;
+	StartTime = FPlatformTime::Seconds();
+	FReflectedFunctionCall FunctionCall(Function);
+	const int32 FirstIndex = FunctionCall.FindParameterIndex(FirstName);
+	const int32 SecondIndex = FunctionCall.FindParameterIndex(SecondName);
+	FunctionCall.SetArgument<FIntProperty>(SecondIndex, 1);
+	for (int32 CallIndex = 0; CallIndex < NumCalls; CallIndex++) {
+		FunctionCall.SetArgument<FIntProperty>(FirstIndex, CallIndex);
+		FunctionCall.Invoke(MathLibrary);
+		PreparedSum += FunctionCall.GetResult<FIntProperty>(FunctionCall.GetReturnValueIndex());
+	}
+	const double PreparedTime = FPlatformTime::Seconds() - StartTime;
+
+	//Reflected object prepared once, parameters accessed by name
+	int64 ReflectedSum = 0;
+	StartTime = FPlatformTime::Seconds();
+	FReflectedObject ReflectedCall{};
+	ReflectedCall.SetupFromFunctionCall(MathLibrary, Function->GetFName());
+	ReflectedCall.SetIntProperty(SecondName, 1);
+	for (int32 CallIndex = 0; CallIndex < NumCalls; CallIndex++) {
+		ReflectedCall.SetIntProperty(FirstName, CallIndex);
+		ReflectedCall.InvokeFunction();
+		ReflectedSum += ReflectedCall.GetIntProperty(ReturnValueName);
+	}
+	const double ReflectedTime = FPlatformTime::Seconds() - StartTime;
+
+	//Reflected object prepared for every call, with the parameter buffer taken from the pool
+	int64 PooledSum = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 CallIndex = 0; CallIndex < NumCalls; CallIndex++) {
+		FReflectedObject PooledCall{};
+		PooledCall.SetupFromFunctionCall(MathLibrary, Function->GetFName());
+		PooledCall.SetIntProperty(FirstName, CallIndex);
+		PooledCall.SetIntProperty(SecondName, 1);
+		PooledCall.InvokeFunction();
+		PooledSum += PooledCall.GetIntProperty(ReturnValueName);
+	}
+	const double PooledTime = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("Native call results"), NativeSum, ExpectedSum);
+	TestEqual(TEXT("Unprepared call results"), UnpreparedSum, ExpectedSum);
+	TestEqual(TEXT("Prepared call results"), PreparedSum, ExpectedSum);
+	TestEqual(TEXT("Reflected call results"), ReflectedSum, ExpectedSum);
+	TestEqual(TEXT("Pooled call results"), PooledSum, ExpectedSum);
+
+	const auto CallsPerSecond = [NumCalls](double Time) { return Time > 0.0 ? NumCalls / Time : 0.0; };
+	AddInfo(FString::Printf(TEXT("Calls per second: native %.0f, unprepared %.0f, prepared %.0f, reflected object %.0f, reflected object prepared per call %.0f"),
+		CallsPerSecond(NativeTime), CallsPerSecond(UnpreparedTime), CallsPerSecond(PreparedTime), CallsPerSecond(ReflectedTime), CallsPerSecond(PooledTime)));
+	return true;
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Async/ParallelFor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Reflection/ClassGenerator.h"
+#include "Reflection/ReflectedPropertyCache.h"
+#include "Reflection/ReflectionHelper.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Generated classes are rooted and cannot be generated twice, so they are reused by subsequent runs */
+static UClass* GetOrGenerateTestClass(int32 ClassIndex) {
+	const FString ClassName = FString::Printf(TEXT("SMLReflectedPropertyCacheTestClass%d"), ClassIndex);
+	if (UClass* ExistingClass = FindObject<UClass>(ANY_PACKAGE, *ClassName)) {
+		return ExistingClass;
+	}
+	//Deep engine class as a parent, so uncached lookups have to walk long property chains and function maps
+	return FClassGenerator::GenerateSimpleClass(TEXT("/Script/SMLReflectedPropertyCacheTest"), *ClassName, UStaticMeshComponent::StaticClass());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectedPropertyCacheTest, "SML.Reflection.ReflectedPropertyCache", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FReflectedPropertyCacheTest::RunTest(const FString& Parameters) {
+	UClass* TestClass = GetOrGenerateTestClass(0);
+	const FName PropertyName = GET_MEMBER_NAME_CHECKED(UPrimitiveComponent, MinDrawDistance);
+	const FName FunctionName = GET_FUNCTION_NAME_CHECKED(USceneComponent, SetVisibility);
+	const FName MissingName = TEXT("SMLMissingField");
+
+	//Cached lookups have to resolve the same fields as the uncached ones, including misses
+	TestTrue(TEXT("Cached property"), FReflectedPropertyCache::FindProperty(TestClass, PropertyName) == TestClass->FindPropertyByName(PropertyName));
+	TestTrue(TEXT("Cached property again"), FReflectedPropertyCache::FindProperty(TestClass, PropertyName) == TestClass->FindPropertyByName(PropertyName));
+	TestNull(TEXT("Missing property"), FReflectedPropertyCache::FindProperty(TestClass, MissingName));
+	TestNull(TEXT("Missing property again"), FReflectedPropertyCache::FindProperty(TestClass, MissingName));
+	TestTrue(TEXT("Cached function"), FReflectedPropertyCache::FindFunction(TestClass, FunctionName) == TestClass->FindFunctionByName(FunctionName));
+	TestNotNull(TEXT("Inherited function"), FReflectedPropertyCache::FindFunction(TestClass, FunctionName));
+	TestNull(TEXT("Missing function"), FReflectedPropertyCache::FindFunction(TestClass, MissingName));
+	TestNull(TEXT("Property of NULL struct"), FReflectedPropertyCache::FindProperty(NULL, PropertyName));
+
+	//Handles resolve again once the cache has been invalidated
+	const FReflectedPropertyHandle PropertyHandle(TestClass, PropertyName);
+	TestTrue(TEXT("Handle property"), PropertyHandle.GetProperty<FFloatProperty>() == TestClass->FindPropertyByName(PropertyName));
+	const uint32 Generation = FReflectedPropertyCache::GetGeneration();
+	FReflectedPropertyCache::Invalidate();
+	TestTrue(TEXT("Generation changes on invalidation"), FReflectedPropertyCache::GetGeneration() != Generation);
+	TestTrue(TEXT("Handle property after invalidation"), PropertyHandle.GetProperty<FFloatProperty>() == TestClass->FindPropertyByName(PropertyName));
+
+	//Concurrent lookups, including misses populating the cache, have to agree with the uncached ones
+	TArray<FName> FieldNames;
+	for (TFieldIterator<FProperty> It(TestClass); It; ++It) {
+		FieldNames.Add(It->GetFName());
+	}
+	FieldNames.Add(MissingName);
+	TArray<bool> LookupResults;
+	LookupResults.SetNumZeroed(FieldNames.Num() * 8);
+	FReflectedPropertyCache::Invalidate();
+	ParallelFor(LookupResults.Num(), [&](int32 LookupIndex) {
+		const FName FieldName = FieldNames[LookupIndex % FieldNames.Num()];
+		LookupResults[LookupIndex] = FReflectedPropertyCache::FindProperty(TestClass, FieldName) == TestClass->FindPropertyByName(FieldName) &&
+			FReflectedPropertyCache::FindFunction(TestClass, FieldName) == TestClass->FindFunctionByName(FieldName);
+	});
+	for (int32 LookupIndex = 0; LookupIndex < LookupResults.Num(); LookupIndex++) {
+		if (!LookupResults[LookupIndex]) {
+			AddError(FString::Printf(TEXT("Concurrent lookup of %s differs from the uncached one"), *FieldNames[LookupIndex % FieldNames.Num()].ToString()));
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectedPropertyCacheBenchmark, "SML.Reflection.ReflectedPropertyCache.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FReflectedPropertyCacheBenchmark::RunTest(const FString& Parameters) {
+	//Reflected gets and sets across many classes, the way interop code running every tick accesses them
+	const int32 NumClasses = 100;
+	const int32 NumIterations = 1000;
+	const FName FloatPropertyName = GET_MEMBER_NAME_CHECKED(UPrimitiveComponent, MinDrawDistance);
+	const FName IntPropertyName = GET_MEMBER_NAME_CHECKED(UPrimitiveComponent, TranslucencySortPriority);
+
+	TArray<UObject*> Objects;
+	TArray<FReflectedPropertyHandle> FloatHandles;
+	TArray<FReflectedPropertyHandle> IntHandles;
+	for (int32 ClassIndex = 0; ClassIndex < NumClasses; ClassIndex++) {
+		UClass* TestClass = GetOrGenerateTestClass(ClassIndex);
+		Objects.Add(NewObject<UObject>(GetTransientPackage(), TestClass, NAME_None, RF_Transient));
+		FloatHandles.Add(FReflectedPropertyHandle(TestClass, FloatPropertyName));
+		IntHandles.Add(FReflectedPropertyHandle(TestClass, IntPropertyName));
+	}
+	const int32 NumAccesses = NumClasses * NumIterations * 4;
+
+	//Uncached lookups by name, the way reflection helpers resolved properties before
+	double ValueSum = 0.0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+		for (UObject* Object : Objects) {
+			FFloatProperty* FloatProperty = FindFProperty<FFloatProperty>(Object->GetClass(), FloatPropertyName);
+			FIntProperty* IntProperty = FindFProperty<FIntProperty>(Object->GetClass(), IntPropertyName);
+			FloatProperty->SetPropertyValue_InContainer(Object, (float) Iteration);
+			IntProperty->SetPropertyValue_InContainer(Object, Iteration);
+			ValueSum += FindFProperty<FFloatProperty>(Object->GetClass(), FloatPropertyName)->GetPropertyValue_InContainer(Object);
+			ValueSum += FindFProperty<FIntProperty>(Object->GetClass(), IntPropertyName)->GetPropertyValue_InContainer(Object);
+		}
+	}
+	const double UncachedTime = FPlatformTime::Seconds() - StartTime;
+
+	//Cached lookups by name through the reflection helper
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+		for (UObject* Object : Objects) {
+			FReflectionHelper::SetPropertyValue<FFloatProperty>(Object, TEXT("MinDrawDistance"), (float) Iteration);
+			FReflectionHelper::SetPropertyValue<FIntProperty>(Object, TEXT("TranslucencySortPriority"), Iteration);
+			ValueSum -= FReflectionHelper::GetPropertyValue<FFloatProperty>(Object, TEXT("MinDrawDistance"));
+			ValueSum -= FReflectionHelper::GetPropertyValue<FIntProperty>(Object, TEXT("TranslucencySortPriority"));
+		}
+	}
+	const double CachedTime = FPlatformTime::Seconds() - StartTime;
+
+	//Handles resolved once per class
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+		for (int32 ObjectIndex = 0; ObjectIndex < Objects.Num(); ObjectIndex++) {
+			UObject* Object = Objects[ObjectIndex];
+			FFloatProperty* FloatProperty = FloatHandles[ObjectIndex].GetProperty<FFloatProperty>();
+			FIntProperty* IntProperty = IntHandles[ObjectIndex].GetProperty<FIntProperty>();
+			FloatProperty->SetPropertyValue_InContainer(Object, (float) Iteration);
+			IntProperty->SetPropertyValue_InContainer(Object, Iteration);
+			ValueSum += FloatHandles[ObjectIndex].GetProperty<FFloatProperty>()->GetPropertyValue_InContainer(Object);
+			ValueSum += IntHandles[ObjectIndex].GetProperty<FIntProperty>()->GetPropertyValue_InContainer(Object);
+		}
+	}
+	const double HandleTime = FPlatformTime::Seconds() - StartTime;
+
+	//Values are integers, so the sums are exact and all three ways have to cancel out
+	TestEqual(TEXT("Values read through all access paths"), ValueSum, (double) NumClasses * NumIterations * (NumIterations - 1));
+	AddInfo(FString::Printf(TEXT("%d reflected accesses across %d classes: uncached %.2fms, cached by name %.2fms, handles %.2fms"),
+		NumAccesses, NumClasses, UncachedTime * 1000.0, CachedTime * 1000.0, HandleTime * 1000.0));
+	return true;
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "Misc/AutomationTest.h"
+#include "Network/SMLConnection/SMLNetworkManager.h"
+#include "Network/SMLConnection/SMLConnectionMetadata.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Creates synthetic mod list of the provided size, with mods added in the forward or reversed order */
+static TMap<FString, FVersion> CreateTestModList(int32 NumMods, bool bReversedOrder) {
+	TMap<FString, FVersion> ModVersions;
+	for (int32 i = 0; i < NumMods; i++) {
+		const int32 ModIndex = bReversedOrder ? NumMods - 1 - i : i;
+		ModVersions.Add(FString::Printf(TEXT("TestMod%03d"), ModIndex), FVersion(1, ModIndex % 7, ModIndex));
+	}
+	return ModVersions;
+}
+
+static bool AreModListsEqual(const TMap<FString, FVersion>& A, const TMap<FString, FVersion>& B) {
+	if (A.Num() != B.Num()) {
+		return false;
+	}
+	for (const TPair<FString, FVersion>& Pair : A) {
+		const FVersion* OtherVersion = B.Find(Pair.Key);
+		if (OtherVersion == NULL || !(*OtherVersion == Pair.Value)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSMLNetworkManagerModListHandshakeTest, "SML.Network.SMLNetworkManager.ModListHandshake", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FSMLNetworkManagerModListHandshakeTest::RunTest(const FString& Parameters) {
+	const TMap<FString, FVersion> ServerMods = CreateTestModList(150, false);
+
+	//Matching mod lists, client only sends the hash and is done
+	const TMap<FString, FVersion> MatchingClientMods = CreateTestModList(150, true);
+	const TArray<uint8> MatchingHashPayload = FSMLNetworkManager::SerializeModListHash(MatchingClientMods);
+	TestTrue(TEXT("Hash does not depend on the mod order"), MatchingHashPayload == FSMLNetworkManager::SerializeModListHash(ServerMods));
+
+	//Mismatching mod lists, server requests the full list and client sends it compressed
+	TMap<FString, FVersion> MismatchingClientMods = ServerMods;
+	MismatchingClientMods.Add(TEXT("TestMod042"), FVersion(2, 0, 0));
+	const TArray<uint8> MismatchingHashPayload = FSMLNetworkManager::SerializeModListHash(MismatchingClientMods);
+	TestFalse(TEXT("Different mod version changes the hash"), MismatchingHashPayload == MatchingHashPayload);
+
+	const TArray<uint8> CompressedModList = FSMLNetworkManager::SerializeCompressedModList(MismatchingClientMods);
+	USMLConnectionMetadata* CompressedMetadata = NewObject<USMLConnectionMetadata>();
+	TestTrue(TEXT("Compressed mod list is parsed"), FSMLNetworkManager::HandleCompressedModList(CompressedMetadata, CompressedModList));
+	TestTrue(TEXT("Compressed mod list round trip"), AreModListsEqual(CompressedMetadata->InstalledClientMods, MismatchingClientMods));
+
+	//Json mod list is still sent to the servers that have not announced hash handshake support
+	const FString JsonModList = FSMLNetworkManager::SerializeModList(MismatchingClientMods);
+	USMLConnectionMetadata* JsonMetadata = NewObject<USMLConnectionMetadata>();
+	TestTrue(TEXT("Json mod list is parsed"), FSMLNetworkManager::HandleModListObject(JsonMetadata, JsonModList));
+	TestTrue(TEXT("Json mod list round trip"), AreModListsEqual(JsonMetadata->InstalledClientMods, MismatchingClientMods));
+
+	//Corrupted payloads are rejected instead of being partially applied as a valid list
+	TArray<uint8> TruncatedModList = CompressedModList;
+	TruncatedModList.SetNum(TruncatedModList.Num() / 2);
+	TestFalse(TEXT("Truncated compressed mod list is rejected"), FSMLNetworkManager::HandleCompressedModList(NewObject<USMLConnectionMetadata>(), TruncatedModList));
+	TArray<uint8> OversizedModList = CompressedModList;
+	OversizedModList[0] = OversizedModList[1] = OversizedModList[2] = OversizedModList[3] = 0x7F;
+	TestFalse(TEXT("Oversized compressed mod list is rejected"), FSMLNetworkManager::HandleCompressedModList(NewObject<USMLConnectionMetadata>(), OversizedModList));
+
+	const int32 JsonModListBytes = FTCHARToUTF8(*JsonModList).Length();
+	TestTrue(TEXT("Compressed mod list is smaller than the json one"), CompressedModList.Num() < JsonModListBytes);
+	AddInfo(FString::Printf(TEXT("Handshake payload bytes for %d mods: matching hash %d, mismatching hash %d + compressed list %d, legacy json list %d"),
+		MismatchingClientMods.Num(), MatchingHashPayload.Num(), MismatchingHashPayload.Num(), CompressedModList.Num(), JsonModListBytes));
+	return true;
+}
+
+#endif
@@ -0,0 +1,548 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Util/SemVersion.h"
+#include <regex>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSemVersionParseVersionTest, "SML.Util.SemVersion.ParseVersion", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FSemVersionParseVersionTest::RunTest(const FString& Parameters) {
+	struct FValidVersion {
+		const TCHAR* String;
+		int64 Major;
+		int64 Minor;
+		int64 Patch;
+		const TCHAR* Type;
+		const TCHAR* BuildInfo;
+	};
+	//Strings accepted by the regular expression the parser has replaced, with the fields it captured
+	const FValidVersion ValidVersions[] = {
+		{TEXT("1.2.3"), 1, 2, 3, TEXT(""), TEXT("")},
+		{TEXT("0.0.0"), 0, 0, 0, TEXT(""), TEXT("")},
+		{TEXT("v1.2.3"), 1, 2, 3, TEXT(""), TEXT("")},
+		{TEXT("=10.20.30"), 10, 20, 30, TEXT(""), TEXT("")},
+		{TEXT("1.2.3-alpha"), 1, 2, 3, TEXT("alpha"), TEXT("")},
+		{TEXT("1.2.3-alpha.1.x-y"), 1, 2, 3, TEXT("alpha.1.x-y"), TEXT("")},
+		{TEXT("1.2.3-0a"), 1, 2, 3, TEXT("0a"), TEXT("")},
+		{TEXT("1.2.3+build.05"), 1, 2, 3, TEXT(""), TEXT("build.05")},
+		{TEXT("1.2.3-rc.1+Build"), 1, 2, 3, TEXT("rc.1"), TEXT("Build")},
+		{TEXT("4294967295.0.0"), 4294967295ll, 0, 0, TEXT(""), TEXT("")},
+	};
+	for (const FValidVersion& ValidVersion : ValidVersions) {
+		FVersion Version;
+		FString ErrorMessage;
+		if (!Version.ParseVersion(ValidVersion.String, ErrorMessage)) {
+			AddError(FString::Printf(TEXT("Failed to parse '%s': %s"), ValidVersion.String, *ErrorMessage));
+			continue;
+		}
+		TestEqual(FString::Printf(TEXT("Major of '%s'"), ValidVersion.String), Version.Major, ValidVersion.Major);
+		TestEqual(FString::Printf(TEXT("Minor of '%s'"), ValidVersion.String), Version.Minor, ValidVersion.Minor);
+		TestEqual(FString::Printf(TEXT("Patch of '%s'"), ValidVersion.String), Version.Patch, ValidVersion.Patch);
+		TestEqual(FString::Printf(TEXT("Type of '%s'"), ValidVersion.String), Version.Type, FString(ValidVersion.Type));
+		TestEqual(FString::Printf(TEXT("BuildInfo of '%s'"), ValidVersion.String), Version.BuildInfo, FString(ValidVersion.BuildInfo));
+	}
+
+	const TCHAR* InvalidVersions[] = {
+		TEXT(""),
+		TEXT("1"),
+		TEXT("1.2"),
+		TEXT("1.2.x"),
+		TEXT(">=1.2.3"),
+		TEXT("01.2.3"),
+		TEXT("1.02.3"),
+		TEXT("1.2.03"),
+		TEXT("1.2.3-"),
+		TEXT("1.2.3-01"),
+		TEXT("1.2.3-alpha..1"),
+		TEXT("1.2.3+"),
+		TEXT("1.2.3+build_1"),
+		TEXT("1.2-alpha"),
+		TEXT("1.2.3 "),
+		TEXT(" 1.2.3"),
+		TEXT("1.2.3.4"),
+		TEXT("a.b.c"),
+		TEXT("4294967296.0.0"),
+	};
+	for (const TCHAR* InvalidVersion : InvalidVersions) {
+		FVersion Version;
+		FString ErrorMessage;
+		TestFalse(FString::Printf(TEXT("'%s' is rejected"), InvalidVersion), Version.ParseVersion(InvalidVersion, ErrorMessage));
+		TestFalse(FString::Printf(TEXT("'%s' has error message"), InvalidVersion), ErrorMessage.IsEmpty());
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSemVersionParseComparatorTest, "SML.Util.SemVersion.ParseComparator", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FSemVersionParseComparatorTest::RunTest(const FString& Parameters) {
+	struct FValidComparator {
+		const TCHAR* String;
+		EVersionComparisonOp Op;
+		int64 Major;
+		int64 Minor;
+		int64 Patch;
+	};
+	//Unspecified numbers become wildcards for equals and caret, stay unspecified for tilde and become zeros otherwise
+	const FValidComparator ValidComparators[] = {
+		{TEXT("1.2.3"), EVersionComparisonOp::EQUALS, 1, 2, 3},
+		{TEXT("1.2"), EVersionComparisonOp::EQUALS, 1, 2, SEMVER_VERSION_NUMBER_WILDCARD},
+		{TEXT("1.X"), EVersionComparisonOp::EQUALS, 1, SEMVER_VERSION_NUMBER_WILDCARD, SEMVER_VERSION_NUMBER_WILDCARD},
+		{TEXT("*"), EVersionComparisonOp::EQUALS, SEMVER_VERSION_NUMBER_WILDCARD, SEMVER_VERSION_NUMBER_WILDCARD, SEMVER_VERSION_NUMBER_WILDCARD},
+		{TEXT(">=1.2"), EVersionComparisonOp::GREATER_EQUALS, 1, 2, 0},
+		{TEXT(">1"), EVersionComparisonOp::GREATER, 1, 0, 0},
+		{TEXT("<=2.0.1"), EVersionComparisonOp::LESS_EQUALS, 2, 0, 1},
+		{TEXT("<3"), EVersionComparisonOp::LESS, 3, 0, 0},
+		{TEXT("^0.2"), EVersionComparisonOp::CARET, 0, 2, SEMVER_VERSION_NUMBER_WILDCARD},
+		{TEXT("~1.2"), EVersionComparisonOp::TILDE, 1, 2, SEMVER_VERSION_NUMBER_UNSPECIFIED},
+	};
+	for (const FValidComparator& ValidComparator : ValidComparators) {
+		FVersionComparator Comparator;
+		FString ErrorMessage;
+		if (!Comparator.ParseVersionComparator(ValidComparator.String, ErrorMessage)) {
+			AddError(FString::Printf(TEXT("Failed to parse '%s': %s"), ValidComparator.String, *ErrorMessage));
+			continue;
+		}
+		TestTrue(FString::Printf(TEXT("Operator of '%s'"), ValidComparator.String), Comparator.Op == ValidComparator.Op);
+		TestEqual(FString::Printf(TEXT("Major of '%s'"), ValidComparator.String), Comparator.MyVersion.Major, ValidComparator.Major);
+		TestEqual(FString::Printf(TEXT("Minor of '%s'"), ValidComparator.String), Comparator.MyVersion.Minor, ValidComparator.Minor);
+		TestEqual(FString::Printf(TEXT("Patch of '%s'"), ValidComparator.String), Comparator.MyVersion.Patch, ValidComparator.Patch);
+	}
+
+	const TCHAR* InvalidComparators[] = {
+		TEXT(""),
+		TEXT(">="),
+		TEXT(">=1.x"),
+		TEXT("<*"),
+		TEXT("~1.x"),
+		TEXT("1.x.3"),
+		TEXT("x.1"),
+		TEXT("=>1.2.3"),
+	};
+	for (const TCHAR* InvalidComparator : InvalidComparators) {
+		FVersionComparator Comparator;
+		FString ErrorMessage;
+		TestFalse(FString::Printf(TEXT("'%s' is rejected"), InvalidComparator), Comparator.ParseVersionComparator(InvalidComparator, ErrorMessage));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSemVersionParseRangeTest, "SML.Util.SemVersion.ParseRange", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FSemVersionParseRangeTest::RunTest(const FString& Parameters) {
+	//Range strings paired with their normalized form, hyphen ranges are decomposed into comparators
+	const TPair<const TCHAR*, const TCHAR*> ValidRanges[] = {
+		{TEXT(">=1.2.3"), TEXT(">=1.2.3")},
+		{TEXT(">=1.0.0   <2.0.0"), TEXT(">=1.0.0 <2.0.0")},
+		{TEXT("1.2.3 - 2.3.4"), TEXT(">=1.2.3 <=2.3.4")},
+		{TEXT("1.2 - 2"), TEXT(">=1.2.0 <3.0.0")},
+		{TEXT("1.2.3 - 2.3"), TEXT(">=1.2.3 <2.4.0")},
+		{TEXT("^1.2.3 || ~2.1.0 ||  3.x"), TEXT("^1.2.3 || ~2.1.0 || 3.x.x")},
+		{TEXT("||1.0.0||"), TEXT("1.0.0")},
+		{TEXT("=1.0.0+Build"), TEXT("1.0.0+Build")},
+	};
+	for (const TPair<const TCHAR*, const TCHAR*>& ValidRange : ValidRanges) {
+		FVersionRange VersionRange;
+		FString ErrorMessage;
+		if (!VersionRange.ParseVersionRange(ValidRange.Key, ErrorMessage)) {
+			AddError(FString::Printf(TEXT("Failed to parse '%s': %s"), ValidRange.Key, *ErrorMessage));
+			continue;
+		}
+		TestEqual(FString::Printf(TEXT("Normalized form of '%s'"), ValidRange.Key), VersionRange.ToString(), FString(ValidRange.Value));
+	}
+
+	const TCHAR* InvalidRanges[] = {
+		TEXT(""),
+		TEXT("||"),
+		TEXT("   "),
+		TEXT("- 1.0.0"),
+		TEXT("1.0.0 -"),
+		TEXT("1.0.0 - - 2.0.0"),
+		TEXT("1.0.0 - >=2.0.0"),
+		TEXT("1.x - 2.0.0"),
+		TEXT("1.0.0 || >=a"),
+	};
+	for (const TCHAR* InvalidRange : InvalidRanges) {
+		FVersionRange VersionRange;
+		FString ErrorMessage;
+		TestFalse(FString::Printf(TEXT("'%s' is rejected"), InvalidRange), VersionRange.ParseVersionRange(InvalidRange, ErrorMessage));
+		TestFalse(FString::Printf(TEXT("'%s' has error message"), InvalidRange), ErrorMessage.IsEmpty());
+	}
+	return true;
+}
+
+/** Evaluates range through its comparators only, the way it has been matched before ranges were compiled */
+static bool MatchesThroughComparators(const FVersionRange& VersionRange, const FVersion& Version) {
+	for (const FVersionComparatorCollection& Collection : VersionRange.GetCollections()) {
+		if (Collection.Matches(Version)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static FVersion MakeTestVersion(int64 Major, int64 Minor, int64 Patch, const TCHAR* Type) {
+	FVersion Version(Major, Minor, Patch);
+	Version.Type = Type;
+	return Version;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSemVersionCompiledRangeTest, "SML.Util.SemVersion.CompiledRange", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FSemVersionCompiledRangeTest::RunTest(const FString& Parameters) {
+	const TCHAR* RangeStrings[] = {
+		TEXT(">=1.2.3"),
+		TEXT(">1.2.3"),
+		TEXT("<2.0.0"),
+		TEXT("<=1.5"),
+		TEXT("1.2.3"),
+		TEXT("1.2.x"),
+		TEXT("1.x"),
+		TEXT("*"),
+		TEXT("^1.2.3"),
+		TEXT("^0.2.3"),
+		TEXT("^0.0.3"),
+		TEXT("^1.x"),
+		TEXT("^0.1.x"),
+		TEXT("~1.2.3"),
+		TEXT("~1.2"),
+		TEXT("~1"),
+		TEXT("1.0.0 - 2.0.0"),
+		TEXT("1.2 - 2"),
+		TEXT(">=1.0.0 <1.5.0 || >=2.1.0 <3.0.0"),
+		TEXT("<1.0.0 || >=1.0.1"),
+		TEXT("^1.2.3 || ~2.1"),
+		TEXT(">=2.0.0 <1.0.0"),
+		TEXT(">=1048576.0.0"),
+	};
+	TArray<FVersion> Versions;
+	const TCHAR* VersionTypes[] = {TEXT(""), TEXT("alpha"), TEXT("Alpha")};
+	for (const int64 Major : {0, 1, 2, 3}) {
+		for (const int64 Minor : {0, 1, 2, 5}) {
+			for (const int64 Patch : {0, 3, 4}) {
+				for (const TCHAR* VersionType : VersionTypes) {
+					Versions.Add(MakeTestVersion(Major, Minor, Patch, VersionType));
+				}
+			}
+		}
+	}
+	//Numbers not fitting into the packed key are matched against the comparators
+	Versions.Add(MakeTestVersion(1048576, 0, 0, TEXT("")));
+	Versions.Add(MakeTestVersion(5000000, 1, 2, TEXT("")));
+	
+	for (const TCHAR* RangeString : RangeStrings) {
+		FVersionRange VersionRange;
+		FString ErrorMessage;
+		if (!VersionRange.ParseVersionRange(RangeString, ErrorMessage)) {
+			AddError(FString::Printf(TEXT("Failed to parse '%s': %s"), RangeString, *ErrorMessage));
+			continue;
+		}
+		for (const FVersion& Version : Versions) {
+			TestEqual(FString::Printf(TEXT("'%s' matching %s"), RangeString, *Version.ToString()),
+				VersionRange.Matches(Version), MatchesThroughComparators(VersionRange, Version));
+		}
+	}
+	
+	const FVersionRange MinVersionRange = FVersionRange::CreateRangeWithMinVersion(FVersion(1, 2, 0));
+	const FVersionRange AnyVersionRange = FVersionRange::CreateAnyVersionRange();
+	for (const FVersion& Version : Versions) {
+		TestEqual(FString::Printf(TEXT("Minimum version range matching %s"), *Version.ToString()),
+			MinVersionRange.Matches(Version), MatchesThroughComparators(MinVersionRange, Version));
+		TestTrue(FString::Printf(TEXT("Any version range matching %s"), *Version.ToString()), AnyVersionRange.Matches(Version));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSemVersionInternedRangeTest, "SML.Util.SemVersion.InternedRange", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FSemVersionInternedRangeTest::RunTest(const FString& Parameters) {
+	FString ErrorMessage;
+	
+	//Range strings differing only in case must not share the interned parsing result
+	FVersionRange UpperCaseRange;
+	FVersionRange LowerCaseRange;
+	TestTrue(TEXT("Upper case range is parsed"), UpperCaseRange.ParseVersionRange(TEXT("=1.0.0+Build"), ErrorMessage));
+	TestTrue(TEXT("Lower case range is parsed"), LowerCaseRange.ParseVersionRange(TEXT("=1.0.0+build"), ErrorMessage));
+	TestTrue(TEXT("Upper case range keeps its case"), UpperCaseRange.ToString().Equals(TEXT("1.0.0+Build"), ESearchCase::CaseSensitive));
+	TestTrue(TEXT("Lower case range keeps its case"), LowerCaseRange.ToString().Equals(TEXT("1.0.0+build"), ESearchCase::CaseSensitive));
+	
+	//Pre-release types are compared case-sensitively, so compiled ranges must agree with comparators on them
+	FVersionRange PreReleaseRange;
+	TestTrue(TEXT("Pre-release range is parsed"), PreReleaseRange.ParseVersionRange(TEXT(">=1.0.0 <=1.0.0"), ErrorMessage));
+	for (const TCHAR* VersionType : {TEXT("alpha"), TEXT("Alpha"), TEXT("ALPHA")}) {
+		const FVersion Version = MakeTestVersion(1, 0, 0, VersionType);
+		TestEqual(FString::Printf(TEXT("Pre-release range matching %s"), *Version.ToString()),
+			PreReleaseRange.Matches(Version), MatchesThroughComparators(PreReleaseRange, Version));
+	}
+	
+	//Parsing the same invalid string again reports the same error
+	FVersionRange InvalidRange;
+	FString FirstErrorMessage;
+	FString SecondErrorMessage;
+	TestFalse(TEXT("Invalid range is rejected"), InvalidRange.ParseVersionRange(TEXT("1.0.0 -"), FirstErrorMessage));
+	TestFalse(TEXT("Invalid range is rejected again"), InvalidRange.ParseVersionRange(TEXT("1.0.0 -"), SecondErrorMessage));
+	TestEqual(TEXT("Interned error message"), SecondErrorMessage, FirstErrorMessage);
+	
+	//Collections modified after parsing are matched through comparators until the range is compiled again
+	FVersionRange ModifiedRange;
+	TestTrue(TEXT("Modified range is parsed"), ModifiedRange.ParseVersionRange(TEXT("^1.2.0"), ErrorMessage));
+	TestTrue(TEXT("Range matches before modification"), ModifiedRange.Matches(FVersion(1, 5, 0)));
+	ModifiedRange.GetMutableCollections()[0].Comparators[0].Op = EVersionComparisonOp::LESS;
+	TestFalse(TEXT("Modified range does not match previously matched version"), ModifiedRange.Matches(FVersion(1, 5, 0)));
+	TestTrue(TEXT("Modified range matches lower version"), ModifiedRange.Matches(FVersion(1, 0, 0)));
+	ModifiedRange.UpdateCompiledRange();
+	TestFalse(TEXT("Recompiled range does not match previously matched version"), ModifiedRange.Matches(FVersion(1, 5, 0)));
+	TestTrue(TEXT("Recompiled range matches lower version"), ModifiedRange.Matches(FVersion(1, 0, 0)));
+	
+	//Modifying the range must not affect other ranges parsed from the same string
+	FVersionRange OtherRange;
+	TestTrue(TEXT("Other range is parsed"), OtherRange.ParseVersionRange(TEXT("^1.2.0"), ErrorMessage));
+	TestTrue(TEXT("Other range is not modified"), OtherRange.Matches(FVersion(1, 5, 0)));
+
+	//Once the interned table is full, new strings are still parsed correctly without being interned
+	for (int32 RangeIndex = 0; RangeIndex < 5000; RangeIndex++) {
+		FVersionRange UniqueRange;
+		const FString RangeString = FString::Printf(TEXT(">=%d.0.0"), RangeIndex);
+		if (!UniqueRange.ParseVersionRange(RangeString, ErrorMessage)) {
+			AddError(FString::Printf(TEXT("Failed to parse '%s': %s"), *RangeString, *ErrorMessage));
+			break;
+		}
+		if (!UniqueRange.Matches(FVersion(RangeIndex, 1, 0)) || (RangeIndex > 0 && UniqueRange.Matches(FVersion(RangeIndex - 1, 0, 0)))) {
+			AddError(FString::Printf(TEXT("Range '%s' matches wrong versions"), *RangeString));
+			break;
+		}
+	}
+	return true;
+}
+
+/** Regular expression the hand-written version parser has replaced, kept as a reference for the differential tests */
+static bool ParseVersionTemplateWithRegex(const FString& String, FVersion& OutVersion, EVersionComparisonOp& OutComparison) {
+	static const std::wregex VersionRegex(L"^(~|v|=|<=|<|>|>=|\\^)?(X|x|\\*|0|[1-9]\\d*)(?:\\.(X|x|\\*|0|[1-9]\\d*)(?:\\.(X|x|\\*|0|[1-9]\\d*)(?:-((?:0|[1-9]\\d*|\\d*[a-zA-Z-][0-9a-zA-Z-]*)(?:\\.(?:0|[1-9]\\d*|\\d*[a-zA-Z-][0-9a-zA-Z-]*))*))?(?:\\+([0-9a-zA-Z-]+(?:\\.[0-9a-zA-Z-]+)*))?)?)?$", std::regex::ECMAScript | std::regex::optimize);
+	std::wstring WideString;
+	WideString.reserve(String.Len());
+	for (int32 CharIndex = 0; CharIndex < String.Len(); CharIndex++) {
+		WideString.push_back((wchar_t) String[CharIndex]);
+	}
+	std::wsmatch Match;
+	if (!std::regex_match(WideString, Match, VersionRegex)) {
+		return false;
+	}
+	const std::wstring Comparison = Match[1].str();
+	if (Comparison == L"<=") {
+		OutComparison = EVersionComparisonOp::LESS_EQUALS;
+	} else if (Comparison == L"<") {
+		OutComparison = EVersionComparisonOp::LESS;
+	} else if (Comparison == L">=") {
+		OutComparison = EVersionComparisonOp::GREATER_EQUALS;
+	} else if (Comparison == L">") {
+		OutComparison = EVersionComparisonOp::GREATER;
+	} else if (Comparison == L"^") {
+		OutComparison = EVersionComparisonOp::CARET;
+	} else if (Comparison == L"~") {
+		OutComparison = EVersionComparisonOp::TILDE;
+	} else {
+		OutComparison = EVersionComparisonOp::EQUALS;
+	}
+	int64 Numbers[3];
+	for (int32 NumberIndex = 0; NumberIndex < 3; NumberIndex++) {
+		const std::wstring Number = Match[NumberIndex + 2].str();
+		if (Number == L"X" || Number == L"x" || Number == L"*") {
+			Numbers[NumberIndex] = SEMVER_VERSION_NUMBER_WILDCARD;
+		} else if (Number.empty()) {
+			Numbers[NumberIndex] = SEMVER_VERSION_NUMBER_UNSPECIFIED;
+		} else {
+			//Numbers not fitting into 32 bits are intentionally rejected by the new parser, they made std::stoul throw before
+			if (Number.size() > 10 || std::stoll(Number) > (int64) MAX_uint32) {
+				return false;
+			}
+			Numbers[NumberIndex] = std::stoll(Number);
+		}
+	}
+	OutVersion.Major = Numbers[0];
+	OutVersion.Minor = Numbers[1];
+	OutVersion.Patch = Numbers[2];
+	//Wildcards can only be followed by wildcards or unspecified version numbers
+	if (OutVersion.Major == SEMVER_VERSION_NUMBER_WILDCARD || OutVersion.Minor == SEMVER_VERSION_NUMBER_WILDCARD) {
+		if (OutVersion.Patch != SEMVER_VERSION_NUMBER_WILDCARD && OutVersion.Patch != SEMVER_VERSION_NUMBER_UNSPECIFIED) {
+			return false;
+		}
+	}
+	if (OutVersion.Major == SEMVER_VERSION_NUMBER_WILDCARD) {
+		if (OutVersion.Minor != SEMVER_VERSION_NUMBER_WILDCARD && OutVersion.Minor != SEMVER_VERSION_NUMBER_UNSPECIFIED) {
+			return false;
+		}
+	}
+	OutVersion.Type = Match[5].str().c_str();
+	OutVersion.BuildInfo = Match[6].str().c_str();
+	return true;
+}
+
+/** FVersion::ParseVersion as it has been implemented on top of the regular expression */
+static bool ParseVersionWithRegex(const FString& String, FVersion& OutVersion) {
+	EVersionComparisonOp Comparison = EVersionComparisonOp::EQUALS;
+	return ParseVersionTemplateWithRegex(String, OutVersion, Comparison) &&
+		Comparison == EVersionComparisonOp::EQUALS && !OutVersion.ContainsSpecialVersionNumbers();
+}
+
+/** FVersionComparator::ParseVersionComparator as it has been implemented on top of the regular expression */
+static bool ParseComparatorWithRegex(const FString& String, FVersionComparator& OutComparator) {
+	FVersion Version{};
+	EVersionComparisonOp Comparison = EVersionComparisonOp::EQUALS;
+	if (!ParseVersionTemplateWithRegex(String, Version, Comparison)) {
+		return false;
+	}
+	if (Comparison == EVersionComparisonOp::EQUALS || Comparison == EVersionComparisonOp::CARET) {
+		Version = Version.RemoveSpecialNumbers(SEMVER_VERSION_NUMBER_WILDCARD);
+	} else {
+		if (Version.Major == SEMVER_VERSION_NUMBER_WILDCARD || Version.Minor == SEMVER_VERSION_NUMBER_WILDCARD || Version.Patch == SEMVER_VERSION_NUMBER_WILDCARD) {
+			return false;
+		}
+		if (Comparison != EVersionComparisonOp::TILDE) {
+			Version = Version.RemoveSpecialNumbers(0);
+		}
+	}
+	OutComparator = FVersionComparator(Comparison, Version);
+	return true;
+}
+
+/** Generates version-like strings, mostly close to the grammar so both accepted and rejected inputs are covered */
+static FString MakeFuzzVersionString(FRandomStream& RandomStream) {
+	static const TCHAR FuzzChars[] = TEXT("0123456789xX*.-+~v=<>^azAZ_ ");
+	static const TCHAR* FuzzComparisons[] = {TEXT(""), TEXT(""), TEXT("v"), TEXT("="), TEXT(">="), TEXT(">"), TEXT("<="), TEXT("<"), TEXT("^"), TEXT("~"), TEXT("=>"), TEXT("V")};
+	static const TCHAR* FuzzNumbers[] = {TEXT("0"), TEXT("1"), TEXT("2"), TEXT("10"), TEXT("123"), TEXT("01"), TEXT("00"), TEXT("x"), TEXT("X"), TEXT("*"), TEXT(""), TEXT("4294967295"), TEXT("4294967296"), TEXT("99999999999")};
+	static const TCHAR* FuzzIdentifiers[] = {TEXT("alpha"), TEXT("Beta"), TEXT("rc"), TEXT("0"), TEXT("1"), TEXT("01"), TEXT("0a"), TEXT("x-y"), TEXT("-"), TEXT("--1"), TEXT(""), TEXT("build_1"), TEXT("a.b")};
+	const int32 NumFuzzChars = UE_ARRAY_COUNT(FuzzChars) - 1;
+
+	FString Result;
+	if (RandomStream.FRand() < 0.2f) {
+		//Completely random string
+		const int32 Length = RandomStream.RandRange(0, 12);
+		for (int32 CharIndex = 0; CharIndex < Length; CharIndex++) {
+			Result.AppendChar(FuzzChars[RandomStream.RandRange(0, NumFuzzChars - 1)]);
+		}
+		return Result;
+	}
+	Result.Append(FuzzComparisons[RandomStream.RandRange(0, UE_ARRAY_COUNT(FuzzComparisons) - 1)]);
+	const int32 NumNumbers = RandomStream.RandRange(1, 4);
+	for (int32 NumberIndex = 0; NumberIndex < NumNumbers; NumberIndex++) {
+		if (NumberIndex > 0) {
+			Result.AppendChar(TEXT('.'));
+		}
+		Result.Append(FuzzNumbers[RandomStream.RandRange(0, UE_ARRAY_COUNT(FuzzNumbers) - 1)]);
+	}
+	for (const TCHAR Separator : {TEXT('-'), TEXT('+')}) {
+		if (RandomStream.FRand() < 0.4f) {
+			Result.AppendChar(Separator);
+			const int32 NumIdentifiers = RandomStream.RandRange(1, 3);
+			for (int32 IdentifierIndex = 0; IdentifierIndex < NumIdentifiers; IdentifierIndex++) {
+				if (IdentifierIndex > 0) {
+					Result.AppendChar(TEXT('.'));
+				}
+				Result.Append(FuzzIdentifiers[RandomStream.RandRange(0, UE_ARRAY_COUNT(FuzzIdentifiers) - 1)]);
+			}
+		}
+	}
+	//Mutate some of the structured strings by a single character
+	if (RandomStream.FRand() < 0.25f) {
+		const int32 MutationIndex = RandomStream.RandRange(0, Result.Len());
+		const TCHAR MutationChar = FuzzChars[RandomStream.RandRange(0, NumFuzzChars - 1)];
+		if (MutationIndex < Result.Len() && RandomStream.FRand() < 0.5f) {
+			Result[MutationIndex] = MutationChar;
+		} else {
+			Result.InsertAt(MutationIndex, MutationChar);
+		}
+	}
+	return Result;
+}
+
+static bool AreVersionsIdentical(const FVersion& First, const FVersion& Second) {
+	return First.Major == Second.Major && First.Minor == Second.Minor && First.Patch == Second.Patch &&
+		First.Type.Equals(Second.Type, ESearchCase::CaseSensitive) && First.BuildInfo.Equals(Second.BuildInfo, ESearchCase::CaseSensitive);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSemVersionDifferentialFuzzTest, "SML.Util.SemVersion.DifferentialFuzz", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSemVersionDifferentialFuzzTest::RunTest(const FString& Parameters) {
+	//Hand-written parser has to accept the same strings as the regular expression and extract the same fields
+	const int32 NumInputs = 100000;
+	const int32 MaxReportedMismatches = 20;
+	FRandomStream RandomStream(0x5E4E);
+	int32 NumMismatches = 0;
+	int32 NumAcceptedVersions = 0;
+	int32 NumAcceptedComparators = 0;
+
+	for (int32 InputIndex = 0; InputIndex < NumInputs && NumMismatches < MaxReportedMismatches; InputIndex++) {
+		const FString Input = MakeFuzzVersionString(RandomStream);
+		FString ErrorMessage;
+
+		FVersion Version;
+		FVersion ReferenceVersion;
+		const bool bVersionParsed = Version.ParseVersion(Input, ErrorMessage);
+		const bool bReferenceVersionParsed = ParseVersionWithRegex(Input, ReferenceVersion);
+		if (bVersionParsed != bReferenceVersionParsed || (bVersionParsed && !AreVersionsIdentical(Version, ReferenceVersion))) {
+			AddError(FString::Printf(TEXT("Version '%s' parsed differently: %s, reference %s"), *Input,
+				bVersionParsed ? *Version.ToString() : TEXT("rejected"), bReferenceVersionParsed ? *ReferenceVersion.ToString() : TEXT("rejected")));
+			NumMismatches++;
+		}
+		NumAcceptedVersions += bVersionParsed ? 1 : 0;
+
+		FVersionComparator Comparator;
+		FVersionComparator ReferenceComparator;
+		const bool bComparatorParsed = Comparator.ParseVersionComparator(Input, ErrorMessage);
+		const bool bReferenceComparatorParsed = ParseComparatorWithRegex(Input, ReferenceComparator);
+		if (bComparatorParsed != bReferenceComparatorParsed || (bComparatorParsed &&
+			(Comparator.Op != ReferenceComparator.Op || !AreVersionsIdentical(Comparator.MyVersion, ReferenceComparator.MyVersion)))) {
+			AddError(FString::Printf(TEXT("Comparator '%s' parsed differently: %s, reference %s"), *Input,
+				bComparatorParsed ? *Comparator.ToString() : TEXT("rejected"), bReferenceComparatorParsed ? *ReferenceComparator.ToString() : TEXT("rejected")));
+			NumMismatches++;
+		}
+		NumAcceptedComparators += bComparatorParsed ? 1 : 0;
+	}
+	AddInfo(FString::Printf(TEXT("%d inputs, %d accepted as versions, %d accepted as comparators"), NumInputs, NumAcceptedVersions, NumAcceptedComparators));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSemVersionParseBenchmark, "SML.Util.SemVersion.ParseBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FSemVersionParseBenchmark::RunTest(const FString& Parameters) {
+	//Version strings of the shape found in plugin descriptors, parsed by the hand-written parser and the regular expression
+	const int32 NumInputs = 10000;
+	const int32 NumIterations = 10;
+	TArray<FString> Inputs;
+	for (int32 InputIndex = 0; InputIndex < NumInputs; InputIndex++) {
+		const TCHAR* Comparison = InputIndex % 3 == 0 ? TEXT("^") : (InputIndex % 3 == 1 ? TEXT(">=") : TEXT(""));
+		const TCHAR* Type = InputIndex % 4 == 0 ? TEXT("-rc.1") : TEXT("");
+		Inputs.Add(FString::Printf(TEXT("%s%d.%d.%d%s"), Comparison, InputIndex % 5, InputIndex % 17, InputIndex, Type));
+	}
+
+	int32 NumParsed = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+		for (const FString& Input : Inputs) {
+			FVersionComparator Comparator;
+			FString ErrorMessage;
+			NumParsed += Comparator.ParseVersionComparator(Input, ErrorMessage) ? 1 : 0;
+		}
+	}
+	const double ParserTime = FPlatformTime::Seconds() - StartTime;
+
+	int32 NumReferenceParsed = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+		for (const FString& Input : Inputs) {
+			FVersionComparator Comparator;
+			NumReferenceParsed += ParseComparatorWithRegex(Input, Comparator) ? 1 : 0;
+		}
+	}
+	const double RegexTime = FPlatformTime::Seconds() - StartTime;
+
+	const int32 NumParses = NumInputs * NumIterations;
+	TestEqual(TEXT("Parsed by hand-written parser"), NumParsed, NumParses);
+	TestEqual(TEXT("Parsed by regular expression"), NumReferenceParsed, NumParses);
+	const auto ParsesPerSecond = [NumParses](double Time) { return Time > 0.0 ? NumParses / Time : 0.0; };
+	AddInfo(FString::Printf(TEXT("Parses per second: hand-written parser %.0f, regular expression %.0f"), ParsesPerSecond(ParserTime), ParsesPerSecond(RegexTime)));
+	return true;
+}
+
+#endif
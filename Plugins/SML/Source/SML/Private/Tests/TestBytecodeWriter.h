@@ -0,0 +1,49 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Script.h"
+
+/** Writes kismet bytecode into the script buffer, remembering where each top level statement starts */
+class FTestBytecodeWriter {
+public:
+	TArray<uint8> Script;
+	TArray<int32> StatementIndices;
+
+	void BeginStatement(EExprToken Opcode) {
+		StatementIndices.Add(Script.Num());
+		WriteOpcode(Opcode);
+	}
+
+	void WriteOpcode(EExprToken Opcode) {
+		Script.Add((uint8) Opcode);
+	}
+
+	void WriteInt(int32 Value) {
+		for (int32 i = 0; i < (int32) sizeof(int32); i++) {
+			Script.Add((uint8) (Value >> (i * 8)));
+		}
+	}
+
+	void WriteFloat(float Value) {
+		int32 IntValue;
+		FMemory::Memcpy(&IntValue, &Value, sizeof(float));
+		WriteInt(IntValue);
+	}
+
+	/** Writes code offset operand and returns its position, so it can be patched once the target is known */
+	int32 WriteSkipCount(CodeSkipSizeType Value) {
+		const int32 Position = Script.AddUninitialized(sizeof(CodeSkipSizeType));
+		PatchSkipCount(Position, Value);
+		return Position;
+	}
+
+	void PatchSkipCount(int32 Position, CodeSkipSizeType Value) {
+		FPlatformMemory::WriteUnaligned<CodeSkipSizeType>(&Script[Position], Value);
+	}
+
+	void WritePointer(const void* Pointer) {
+		const ScriptPointerType Value = (ScriptPointerType) Pointer;
+		for (int32 i = 0; i < (int32) sizeof(ScriptPointerType); i++) {
+			Script.Add((uint8) (Value >> (i * 8)));
+		}
+	}
+};
@@ -0,0 +1,108 @@
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "Util/TopologicalSort/TopologicalSort.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Sorts the graph through the recursive ExploreNode traversal over the inversed graph, the way TopologicalSort did before */
+static bool RecursiveTopologicalSort(const TDirectedGraph<int32>& Graph, TArray<int32>& OutSortedNodes, TSet<int32>& OutCycleNodes) {
+	const TDirectedGraph<int32> ReversedGraph = Graph.InverseGraph();
+	TSet<int32> VisitedNodes;
+	TSet<int32> ExpandedNodes;
+	bool bSortingSuccess = true;
+
+	for (const int32 Node : ReversedGraph.OrderedNodes) {
+		bSortingSuccess &= FTopologicalSort::ExploreNode(Node, ReversedGraph, OutSortedNodes, VisitedNodes, ExpandedNodes, &OutCycleNodes);
+	}
+	return bSortingSuccess;
+}
+
+/** Creates graph with randomly ordered nodes and random edges. When bAllowCycles is false, edges only go forward in the hidden node order */
+static TDirectedGraph<int32> CreateRandomGraph(FRandomStream& RandomStream, int32 NodeCount, int32 EdgeCount, bool bAllowCycles) {
+	TArray<int32> Nodes;
+	for (int32 Node = 0; Node < NodeCount; Node++) {
+		Nodes.Add(Node);
+	}
+	for (int32 NodeIndex = NodeCount - 1; NodeIndex > 0; NodeIndex--) {
+		Nodes.Swap(NodeIndex, RandomStream.RandRange(0, NodeIndex));
+	}
+	TDirectedGraph<int32> Graph;
+	for (const int32 Node : Nodes) {
+		Graph.AddNode(Node);
+	}
+	for (int32 EdgeIndex = 0; EdgeIndex < EdgeCount; EdgeIndex++) {
+		int32 From = RandomStream.RandRange(0, NodeCount - 1);
+		int32 To = RandomStream.RandRange(0, NodeCount - 1);
+		if (!bAllowCycles) {
+			if (From == To) {
+				continue;
+			}
+			if (From > To) {
+				Swap(From, To);
+			}
+		}
+		Graph.AddEdge(From, To);
+	}
+	return Graph;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTopologicalSortTest, "SML.Util.TopologicalSort", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FTopologicalSortTest::RunTest(const FString& Parameters) {
+	FRandomStream RandomStream(0x534D4C);
+
+	for (int32 GraphIndex = 0; GraphIndex < 200; GraphIndex++) {
+		const bool bAllowCycles = GraphIndex % 2 == 1;
+		const int32 NodeCount = RandomStream.RandRange(1, 40);
+		const int32 EdgeCount = RandomStream.RandRange(0, NodeCount * 3);
+		const TDirectedGraph<int32> Graph = CreateRandomGraph(RandomStream, NodeCount, EdgeCount, bAllowCycles);
+
+		TArray<int32> ExpectedSortedNodes;
+		TSet<int32> ExpectedCycleNodes;
+		const bool bExpectedSuccess = RecursiveTopologicalSort(Graph, ExpectedSortedNodes, ExpectedCycleNodes);
+
+		TArray<int32> SortedNodes;
+		TSet<int32> CycleNodes;
+		TArray<int32> CyclePath;
+		const bool bSuccess = FTopologicalSort::TopologicalSort(Graph, SortedNodes, &CycleNodes, &CyclePath);
+
+		const FString GraphName = FString::Printf(TEXT("Graph %d"), GraphIndex);
+		TestEqual(GraphName + TEXT(" sorting result"), bSuccess, bExpectedSuccess);
+		TestTrue(GraphName + TEXT(" sorted nodes"), SortedNodes == ExpectedSortedNodes);
+		TestTrue(GraphName + TEXT(" cycle nodes"), CycleNodes.Num() == ExpectedCycleNodes.Num() && CycleNodes.Includes(ExpectedCycleNodes));
+		if (!bAllowCycles) {
+			TestTrue(GraphName + TEXT(" acyclic graph is sorted"), bSuccess);
+		}
+
+		//Cycle path has to be an actual cycle of the graph consisting of the reported cycle nodes
+		TestEqual(GraphName + TEXT(" cycle path is reported"), CyclePath.Num() != 0, !bSuccess);
+		for (int32 PathIndex = 0; PathIndex < CyclePath.Num(); PathIndex++) {
+			const int32 From = CyclePath[PathIndex];
+			const int32 To = CyclePath[(PathIndex + 1) % CyclePath.Num()];
+			TestTrue(FString::Printf(TEXT("%s cycle path edge %d -> %d"), *GraphName, From, To), Graph.EdgesFrom(From).Contains(To));
+			TestTrue(FString::Printf(TEXT("%s cycle path node %d"), *GraphName, From), CycleNodes.Contains(From));
+		}
+	}
+
+	//Long dependency chain, which used to be limited by the stack depth of the recursive traversal
+	const int32 ChainLength = 100000;
+	TDirectedGraph<int32> ChainGraph;
+	for (int32 Node = 0; Node < ChainLength; Node++) {
+		ChainGraph.AddNode(Node);
+	}
+	for (int32 Node = 1; Node < ChainLength; Node++) {
+		ChainGraph.AddEdge(Node, Node - 1);
+	}
+	TArray<int32> SortedChain;
+	TestTrue(TEXT("Chain is sorted"), FTopologicalSort::TopologicalSort(ChainGraph, SortedChain));
+	TestEqual(TEXT("Sorted chain length"), SortedChain.Num(), ChainLength);
+	for (int32 NodeIndex = 0; NodeIndex < SortedChain.Num(); NodeIndex++) {
+		if (SortedChain[NodeIndex] != ChainLength - 1 - NodeIndex) {
+			AddError(FString::Printf(TEXT("Chain node %d is sorted into position %d"), SortedChain[NodeIndex], NodeIndex));
+			break;
+		}
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,242 @@
+#include "Misc/AutomationTest.h"
+#include "Util/ZipFile/ZipFile.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "miniz.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Deterministic, but reasonably compressible test data, so it can be verified at any offset without keeping it around */
+static FORCEINLINE uint8 GetTestDataByte(uint64 Offset) {
+	return static_cast<uint8>((Offset / 4096) * 31 + (Offset % 251));
+}
+
+static void FillTestData(uint64 Offset, uint8* OutData, int64 Length) {
+	for (int64 i = 0; i < Length; i++) {
+		OutData[i] = GetTestDataByte(Offset + i);
+	}
+}
+
+static size_t ReadTestDataFunc(void* Opaque, mz_uint64 FileOffset, void* ReadBuffer, size_t Amount) {
+	//Opaque holds the offset shifting data of the entry, so entries have different contents
+	FillTestData(FileOffset + reinterpret_cast<UPTRINT>(Opaque), static_cast<uint8*>(ReadBuffer), static_cast<int64>(Amount));
+	return Amount;
+}
+
+static FString GetTestZipFilePath(const TCHAR* FileName) {
+	return FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("ZipFile") / FileName);
+}
+
+/** Writes zip file with the entries holding the test data of the provided sizes. Data of the first entry starts at zero offset */
+static bool WriteTestZipFile(const FString& FilePath, const TArray<TPair<FString, int64>>& Entries) {
+	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(FilePath));
+	mz_zip_archive ZipArchive;
+	FMemory::Memzero(&ZipArchive, sizeof(ZipArchive));
+	if (!mz_zip_writer_init_file(&ZipArchive, TCHAR_TO_UTF8(*FilePath), 0)) {
+		return false;
+	}
+	bool bSuccess = true;
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++) {
+		const TPair<FString, int64>& Entry = Entries[EntryIndex];
+		void* DataOffset = reinterpret_cast<void*>(static_cast<UPTRINT>(EntryIndex) * 7919);
+		bSuccess &= static_cast<bool>(mz_zip_writer_add_read_buf_callback(&ZipArchive, TCHAR_TO_UTF8(*Entry.Key), &ReadTestDataFunc, DataOffset,
+			static_cast<mz_uint64>(Entry.Value), NULL, NULL, 0, MZ_BEST_SPEED, NULL, 0, NULL, 0));
+	}
+	bSuccess &= static_cast<bool>(mz_zip_writer_finalize_archive(&ZipArchive));
+	mz_zip_writer_end(&ZipArchive);
+	return bSuccess;
+}
+
+/** Reads next chunk from the reader and checks it against the test data at the current reader position */
+static bool ReadAndVerifyTestData(FArchive& Reader, int64 Length, TArray<uint8>& Buffer, TArray<uint8>& ExpectedBuffer) {
+	const int64 Offset = Reader.Tell();
+	Buffer.SetNumUninitialized(Length, false);
+	ExpectedBuffer.SetNumUninitialized(Length, false);
+	Reader.Serialize(Buffer.GetData(), Length);
+	FillTestData(Offset, ExpectedBuffer.GetData(), Length);
+	return !Reader.IsError() && FMemory::Memcmp(Buffer.GetData(), ExpectedBuffer.GetData(), Length) == 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FZipFileEntryReaderTest, "SML.Util.ZipFile.EntryReader", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FZipFileEntryReaderTest::RunTest(const FString& Parameters) {
+	const FString ZipFilePath = GetTestZipFilePath(TEXT("EntryReader.zip"));
+	const int64 EntrySize = 1024 * 1024 + 17;
+	if (!WriteTestZipFile(ZipFilePath, {TPair<FString, int64>(TEXT("Data.bin"), EntrySize), TPair<FString, int64>(TEXT("Other.bin"), 4096)})) {
+		AddError(TEXT("Failed to write test zip file"));
+		return false;
+	}
+	FString ErrorMessage;
+	TSharedPtr<FZipFile> ZipFile = FZipFile::CreateZipArchiveReader(ZipFilePath, ErrorMessage);
+	if (!ZipFile.IsValid()) {
+		AddError(FString::Printf(TEXT("Failed to open test zip file: %s"), *ErrorMessage));
+		return false;
+	}
+	TUniquePtr<FArchive> FirstReader = ZipFile->CreateFileReader(TEXT("Data.bin"));
+	TUniquePtr<FArchive> SecondReader = ZipFile->CreateFileReader(TEXT("Data.bin"));
+	TestNull(TEXT("Reader of missing file"), ZipFile->CreateFileReader(TEXT("Missing.bin")).Get());
+	if (!FirstReader.IsValid() || !SecondReader.IsValid()) {
+		AddError(TEXT("Failed to create entry readers"));
+		return false;
+	}
+
+	//Readers keep zip file alive and have their own archive state, so they can be interleaved with each other and other reads
+	TArray<uint8> OtherFileData;
+	OtherFileData.SetNumUninitialized(4096);
+	TestTrue(TEXT("Read other file between reader creation"), ZipFile->ReadFileToBuffer(TEXT("Other.bin"), OtherFileData.GetData(), OtherFileData.Num()));
+	ZipFile.Reset();
+
+	TArray<uint8> Buffer;
+	TArray<uint8> ExpectedBuffer;
+	SecondReader->Seek(EntrySize / 2);
+	while (FirstReader->Tell() < EntrySize) {
+		const int64 ChunkSize = FMath::Min<int64>(EntrySize - FirstReader->Tell(), 10000);
+		if (!ReadAndVerifyTestData(*FirstReader, ChunkSize, Buffer, ExpectedBuffer)) {
+			AddError(FString::Printf(TEXT("First reader data mismatch at %lld"), FirstReader->Tell()));
+			break;
+		}
+		if (SecondReader->Tell() + ChunkSize <= EntrySize && !ReadAndVerifyTestData(*SecondReader, ChunkSize, Buffer, ExpectedBuffer)) {
+			AddError(FString::Printf(TEXT("Second reader data mismatch at %lld"), SecondReader->Tell()));
+			break;
+		}
+	}
+
+	//Seeking backward restarts decompression, reading past the end of the entry fails
+	SecondReader->Seek(12345);
+	TestTrue(TEXT("Read after seeking backward"), ReadAndVerifyTestData(*SecondReader, 4096, Buffer, ExpectedBuffer));
+	FirstReader->Serialize(Buffer.GetData(), 1);
+	TestTrue(TEXT("Read past the end of the entry fails"), FirstReader->IsError());
+
+	FirstReader.Reset();
+	SecondReader.Reset();
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*ZipFilePath);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FZipFileLargeEntryStreamingTest, "SML.Util.ZipFile.LargeEntryStreaming", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+bool FZipFileLargeEntryStreamingTest::RunTest(const FString& Parameters) {
+	//Entry is streamed through the fixed size window, so memory usage should not grow with the entry size
+	const FString ZipFilePath = GetTestZipFilePath(TEXT("LargeEntry.zip"));
+	const int64 EntrySize = 2ll * 1024 * 1024 * 1024;
+	const int64 ChunkSize = 1024 * 1024;
+	const uint64 MaxMemoryGrowth = 256 * 1024 * 1024;
+	
+	if (!WriteTestZipFile(ZipFilePath, {TPair<FString, int64>(TEXT("Large.bin"), EntrySize)})) {
+		AddError(TEXT("Failed to write test zip file"));
+		return false;
+	}
+	FString ErrorMessage;
+	TSharedPtr<FZipFile> ZipFile = FZipFile::CreateZipArchiveReader(ZipFilePath, ErrorMessage);
+	TUniquePtr<FArchive> Reader = ZipFile.IsValid() ? ZipFile->CreateFileReader(TEXT("Large.bin")) : nullptr;
+	if (!Reader.IsValid()) {
+		AddError(FString::Printf(TEXT("Failed to open test zip file entry: %s"), *ErrorMessage));
+		return false;
+	}
+	TestEqual(TEXT("Entry size"), Reader->TotalSize(), EntrySize);
+
+	TArray<uint8> Buffer;
+	TArray<uint8> ExpectedBuffer;
+	const uint64 InitialUsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+	uint64 PeakUsedMemory = InitialUsedMemory;
+	const double StartTime = FPlatformTime::Seconds();
+	
+	while (Reader->Tell() < EntrySize) {
+		if (!ReadAndVerifyTestData(*Reader, FMath::Min(ChunkSize, EntrySize - Reader->Tell()), Buffer, ExpectedBuffer)) {
+			AddError(FString::Printf(TEXT("Data mismatch at %lld"), Reader->Tell()));
+			break;
+		}
+		if (Reader->Tell() % (64 * ChunkSize) == 0) {
+			PeakUsedMemory = FMath::Max(PeakUsedMemory, FPlatformMemory::GetStats().UsedPhysical);
+		}
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+	
+	AddInfo(FString::Printf(TEXT("Streamed %lld bytes in %.2fs, resident memory grew by %llu bytes"), EntrySize, ElapsedTime, PeakUsedMemory - InitialUsedMemory));
+	TestTrue(TEXT("Resident memory stays bounded while streaming"), PeakUsedMemory - InitialUsedMemory < MaxMemoryGrowth);
+
+	Reader.Reset();
+	ZipFile.Reset();
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*ZipFilePath);
+	return true;
+}
+
+/** Computes crc32 of the extracted file, the same one zip uses, or returns false if file cannot be read */
+static bool ComputeExtractedFileCrc(const FString& FilePath, uint32& OutCrc) {
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent)) {
+		return false;
+	}
+	OutCrc = static_cast<uint32>(mz_crc32(MZ_CRC32_INIT, FileData.GetData(), FileData.Num()));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FZipFileExtractAllTest, "SML.Util.ZipFile.ExtractAll", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FZipFileExtractAllTest::RunTest(const FString& Parameters) {
+	const FString ZipFilePath = GetTestZipFilePath(TEXT("ExtractAll.zip"));
+	TArray<TPair<FString, int64>> Entries;
+	for (int32 FileIndex = 0; FileIndex < 64; FileIndex++) {
+		Entries.Add(TPair<FString, int64>(FString::Printf(TEXT("Dir%d/File%d.bin"), FileIndex % 5, FileIndex), (FileIndex * 37813) % (512 * 1024)));
+	}
+	//Entries resolving to the path of the first entry, and the one escaping the output directory
+	const TArray<FString> InvalidEntries = {TEXT("DIR0/file0.BIN"), TEXT("Dir1/../Dir0/File0.bin"), TEXT("../Escape.bin")};
+	for (const FString& InvalidEntry : InvalidEntries) {
+		Entries.Add(TPair<FString, int64>(InvalidEntry, 1024));
+	}
+	if (!WriteTestZipFile(ZipFilePath, Entries)) {
+		AddError(TEXT("Failed to write test zip file"));
+		return false;
+	}
+	FString ErrorMessage;
+	const TSharedPtr<FZipFile> ZipFile = FZipFile::CreateZipArchiveReader(ZipFilePath, ErrorMessage);
+	if (!ZipFile.IsValid()) {
+		AddError(FString::Printf(TEXT("Failed to open test zip file: %s"), *ErrorMessage));
+		return false;
+	}
+	
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString SerialDirectory = GetTestZipFilePath(TEXT("Serial/Output"));
+	const FString ParallelDirectory = GetTestZipFilePath(TEXT("Parallel/Output"));
+	PlatformFile.DeleteDirectoryRecursively(*GetTestZipFilePath(TEXT("Serial")));
+	PlatformFile.DeleteDirectoryRecursively(*GetTestZipFilePath(TEXT("Parallel")));
+
+	TArray<FZipExtractionError> SerialErrors;
+	TArray<FZipExtractionError> ParallelErrors;
+	TestFalse(TEXT("Serial extraction reports invalid entries"), ZipFile->ExtractAll(SerialDirectory, SerialErrors, true));
+	TestFalse(TEXT("Parallel extraction reports invalid entries"), ZipFile->ExtractAll(ParallelDirectory, ParallelErrors, false));
+	
+	TArray<FString> SerialErrorPaths;
+	TArray<FString> ParallelErrorPaths;
+	for (const FZipExtractionError& Error : SerialErrors) {
+		SerialErrorPaths.Add(Error.FilePath);
+	}
+	for (const FZipExtractionError& Error : ParallelErrors) {
+		ParallelErrorPaths.Add(Error.FilePath);
+	}
+	TestTrue(TEXT("Serial extraction errors"), SerialErrorPaths == InvalidEntries);
+	TestTrue(TEXT("Parallel extraction errors"), ParallelErrorPaths == InvalidEntries);
+
+	//Parallel extraction has to produce exactly the same files as the serial one, and they have to match the archive
+	for (int32 FileIndex = 0; FileIndex < Entries.Num() - InvalidEntries.Num(); FileIndex++) {
+		const FString& EntryPath = Entries[FileIndex].Key;
+		uint32 SerialCrc = 0;
+		uint32 ParallelCrc = 0;
+		if (!ComputeExtractedFileCrc(SerialDirectory / EntryPath, SerialCrc) || !ComputeExtractedFileCrc(ParallelDirectory / EntryPath, ParallelCrc)) {
+			AddError(FString::Printf(TEXT("Entry %s has not been extracted"), *EntryPath));
+			continue;
+		}
+		TestEqual(FString::Printf(TEXT("Crc of %s extracted in parallel"), *EntryPath), ParallelCrc, SerialCrc);
+		TestEqual(FString::Printf(TEXT("Crc of %s stored in the archive"), *EntryPath), SerialCrc, ZipFile->StatFile(EntryPath).FileCrc32);
+	}
+	TestFalse(TEXT("Escaping entry is not extracted"), PlatformFile.FileExists(*GetTestZipFilePath(TEXT("Parallel/Escape.bin"))));
+
+	PlatformFile.DeleteDirectoryRecursively(*GetTestZipFilePath(TEXT("Serial")));
+	PlatformFile.DeleteDirectoryRecursively(*GetTestZipFilePath(TEXT("Parallel")));
+	PlatformFile.DeleteFile(*ZipFilePath);
+	return true;
+}
+
+#endif
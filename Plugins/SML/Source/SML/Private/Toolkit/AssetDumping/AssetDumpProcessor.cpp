@@ -3,6 +3,8 @@
 #include "SatisfactoryModLoader.h"
 #include "Toolkit/AssetDumping/AssetTypeSerializer.h"
 #include "Toolkit/AssetDumping/SerializationContext.h"
+#include "Toolkit/AssetTypes/FbxMeshExporter.h"
+#include "Engine/StaticMesh.h"
 
 FAssetDumpSettings::FAssetDumpSettings() :
 		RootDumpDirectory(FPaths::ProjectDir() + TEXT("AssetDump/")),
@@ -35,8 +37,13 @@ FAssetDumpProcessor::~FAssetDumpProcessor() {
 		Package->RemoveFromRoot();
 	}
 	
+	for (const TPair<FName, UPackage*>& Pair : this->RenderDataPackages) {
+		Pair.Value->RemoveFromRoot();
+	}
+	
 	this->LoadedPackages.Empty();
 	this->AssetDataByPackageName.Empty();
+	this->RenderDataPackages.Empty();
 	this->PackagesToLoad.Empty();
 }
 
@@ -94,10 +101,18 @@ void FAssetDumpProcessor::Tick(float DeltaTime) {
 		PerformAssetDumpForPackage(PackagesToProcessThisTick[PackageIndex]);
 	}, Flags);
 
+	//Mesh geometry has been exported by now, so let render data copies be garbage collected
+	for (UPackage* Package : PackagesToProcessThisTick) {
+		ReleaseRenderDataPackage(Package->GetFName());
+	}
+
 	if (CurrentPackageToLoadIndex >= PackagesToLoad.Num() &&
 		PackageLoadRequestsInFlyCounter.GetValue() == 0 &&
 		PackagesWaitingForProcessing.GetValue() == 0) {
 		UE_LOG(LogSatisfactoryModLoader, Display, TEXT("Asset dumping finished successfully"));
+		const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+		UE_LOG(LogSatisfactoryModLoader, Display, TEXT("Peak memory usage during dumping: %.2f MB physical, %.2f MB virtual"),
+			MemoryStats.PeakUsedPhysical / (1024.0f * 1024.0f), MemoryStats.PeakUsedVirtual / (1024.0f * 1024.0f));
 		this->bHasFinishedDumping = true;
 
 		//If we were requested to exit on finish, do it now
@@ -114,13 +129,11 @@ void FAssetDumpProcessor::Tick(float DeltaTime) {
 }
 
 void FAssetDumpProcessor::OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result) {
-	//Reduce package load requests in fly counter, so next request can be made
-	this->PackageLoadRequestsInFlyCounter.Decrement();
-
 	//Make sure request suceeded
 	if (Result != EAsyncLoadingResult::Succeeded) {
 		UE_LOG(LogSatisfactoryModLoader, Error, TEXT("Failed to load package %s for dumping. It will be skipped."), *PackageName.ToString());
 		PackagesSkipped.Increment();
+		this->PackageLoadRequestsInFlyCounter.Decrement();
 		return;
 	}
 	
@@ -128,6 +141,54 @@ void FAssetDumpProcessor::OnPackageLoaded(const FName& PackageName, UPackage* Lo
 	check(LoadedPackage);
 	LoadedPackage->AddToRoot();
 
+	//Static meshes need CPU access to their render data to be exported. Unless mesh keeps it itself, CPU data is freed
+	//once GPU resources are initialized, so we re-read the package under a temporary name with CPU access forced
+	const FAssetData* AssetData = AssetDataByPackageName.FindChecked(PackageName);
+	if (AssetData->AssetClass == UStaticMesh::StaticClass()->GetFName()) {
+		UStaticMesh* StaticMesh = FindObject<UStaticMesh>(LoadedPackage, *AssetData->AssetName.ToString());
+		if (StaticMesh != NULL && !StaticMesh->bAllowCPUAccess) {
+			LoadRenderDataPackage(LoadedPackage);
+			return;
+		}
+	}
+	EnqueueLoadedPackage(LoadedPackage);
+}
+
+void FAssetDumpProcessor::LoadRenderDataPackage(UPackage* OriginalPackage) {
+	//Package names are made unique because released copies can still be resident until they are garbage collected
+	static int32 RenderDataPackageCounter = 0;
+	const FString RenderDataPackageName = FString::Printf(TEXT("/Temp/AssetDumpRenderData%d%s"), RenderDataPackageCounter++, *OriginalPackage->GetName());
+
+	//Copy is only used by us, so CPU access is forced just for the meshes inside of it and not for anything else being loaded at the same time
+	FFbxMeshExporter::BeginForceStaticMeshCPUAccess(*RenderDataPackageName);
+	LoadPackageAsync(RenderDataPackageName, NULL, *OriginalPackage->GetName(), FLoadPackageAsyncDelegate::CreateRaw(this, &FAssetDumpProcessor::OnRenderDataPackageLoaded, OriginalPackage));
+}
+
+void FAssetDumpProcessor::OnRenderDataPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result, UPackage* OriginalPackage) {
+	FFbxMeshExporter::EndForceStaticMeshCPUAccess(PackageName);
+	
+	if (Result == EAsyncLoadingResult::Succeeded) {
+		check(LoadedPackage);
+		LoadedPackage->AddToRoot();
+		this->RenderDataPackages.Add(OriginalPackage->GetFName(), LoadedPackage);
+	} else {
+		UE_LOG(LogSatisfactoryModLoader, Warning, TEXT("Failed to load render data of package %s, mesh geometry will not be exported"), *OriginalPackage->GetName());
+	}
+	EnqueueLoadedPackage(OriginalPackage);
+}
+
+void FAssetDumpProcessor::ReleaseRenderDataPackage(FName PackageName) {
+	UPackage* RenderDataPackage = NULL;
+	if (RenderDataPackages.RemoveAndCopyValue(PackageName, RenderDataPackage)) {
+		//Copy is not referenced by anything else, so garbage collection will release its render resources properly
+		RenderDataPackage->RemoveFromRoot();
+	}
+}
+
+void FAssetDumpProcessor::EnqueueLoadedPackage(UPackage* LoadedPackage) {
+	//Reduce package load requests in fly counter, so next request can be made
+	this->PackageLoadRequestsInFlyCounter.Decrement();
+
 	//Add package to loaded ones, using critical section so we avoid concurrency issues
 	this->LoadedPackagesCriticalSection.Lock();
 	this->LoadedPackages.Add(LoadedPackage);
@@ -140,6 +201,8 @@ void FAssetDumpProcessor::OnPackageLoaded(const FName& PackageName, UPackage* Lo
 void FAssetDumpProcessor::PerformAssetDumpForPackage(UPackage* Package) {
 	FAssetData* AssetData = AssetDataByPackageName.FindChecked(Package->GetFName());
 	const TSharedRef<FSerializationContext> Context = MakeShareable(new FSerializationContext(Settings.RootDumpDirectory, *AssetData, Package));
+	//Render data packages are only modified on the game thread outside of the parallel dumping
+	Context->RenderDataPackage = RenderDataPackages.FindRef(Package->GetFName());
 
 	//Unroot package at this point, we're going to process it this tick anyway, so it doesn't need to be kept anymore
 	Package->RemoveFromRoot();
@@ -15,6 +15,7 @@ FSerializationContext::FSerializationContext(const FString& RootOutputDirectory,
 	this->ObjectHierarchySerializer->Initialize(Package, PropertySerializer);
 	this->Package = Package;
 	this->AssetData = AssetData;
+	this->RenderDataPackage = NULL;
 
 	this->RootOutputDirectory = RootOutputDirectory;
 	this->PackageBaseDirectory = FPaths::Combine(RootOutputDirectory, AssetData.PackagePath.ToString());
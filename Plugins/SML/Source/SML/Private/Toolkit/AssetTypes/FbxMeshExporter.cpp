@@ -16,10 +16,35 @@ FString GetNameForUVChannel(uint32 Index) {
     return FString::Printf(TEXT("uv%d"), Index + 1);
 }
 
+/** Names of the packages which static meshes are loaded with forced CPU access. Meshes can be serialized outside of the game thread */
+static FCriticalSection GForcedCPUAccessPackagesCriticalSection;
+static TSet<FName> GForcedCPUAccessPackages;
+
+static bool IsStaticMeshCPUAccessForced(FName PackageName) {
+	FScopeLock ScopeLock(&GForcedCPUAccessPackagesCriticalSection);
+	return GForcedCPUAccessPackages.Num() && GForcedCPUAccessPackages.Contains(PackageName);
+}
+
 void FFbxMeshExporter::RegisterStaticMeshCPUAccessHook() {
-	//UObject system should be initialized at this point so we can change UStaticMesh CDO
+	//UObject system should be initialized at this point so we can use UStaticMesh CDO as a sample instance
 	check(UObjectInitialized());
-	GetMutableDefault<UStaticMesh>()->bAllowCPUAccess = true;
+	SUBSCRIBE_METHOD_VIRTUAL(UStaticMesh::Serialize, GetMutableDefault<UStaticMesh>(), [](auto& Call, UStaticMesh* StaticMesh, FArchive& Ar) {
+		//Render data is serialized after tagged properties, so it will pick up the flag set here
+		//bAllowCPUAccess is only tagged when mesh enables it itself, so it will never be reset back to false
+		if (Ar.IsLoading() && IsStaticMeshCPUAccessForced(StaticMesh->GetOutermost()->GetFName())) {
+			StaticMesh->bAllowCPUAccess = true;
+		}
+	});
+}
+
+void FFbxMeshExporter::BeginForceStaticMeshCPUAccess(FName PackageName) {
+	FScopeLock ScopeLock(&GForcedCPUAccessPackagesCriticalSection);
+	GForcedCPUAccessPackages.Add(PackageName);
+}
+
+void FFbxMeshExporter::EndForceStaticMeshCPUAccess(FName PackageName) {
+	FScopeLock ScopeLock(&GForcedCPUAccessPackagesCriticalSection);
+	GForcedCPUAccessPackages.Remove(PackageName);
 }
 
 FbxManager* AllocateFbxManagerForExport() {
@@ -98,8 +123,13 @@ bool ExportFbxSceneToFileByPath(const FString& OutFileName, FbxScene* Scene, boo
 }
 
 bool FFbxMeshExporter::ExportStaticMeshIntoFbxFile(UStaticMesh* StaticMesh, const FString& OutFileName, const bool bExportAsText, FString* OutErrorMessage) {
-    //Make sure we either force static mesh data on CPU globally or mesh has it set locally
-    check(StaticMesh->bAllowCPUAccess);
+    //Make sure mesh has been loaded with CPU access forced by the dumper or has it set locally
+    if (!StaticMesh->bAllowCPUAccess) {
+        if (OutErrorMessage) {
+            *OutErrorMessage = TEXT("Static mesh has been loaded without CPU access to render data");
+        }
+        return false;
+    }
     FbxManager* FbxManager = AllocateFbxManagerForExport();
     check(FbxManager);
 
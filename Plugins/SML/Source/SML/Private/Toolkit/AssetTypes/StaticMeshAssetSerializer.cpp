@@ -7,6 +7,7 @@
 #include "Toolkit/ObjectHierarchySerializer.h"
 #include "Toolkit/AssetDumping/AssetTypeSerializerMacros.h"
 #include "Toolkit/AssetDumping/SerializationContext.h"
+#include "SatisfactoryModLoader.h"
 
 void UStaticMeshAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext> Context) const {
     BEGIN_ASSET_SERIALIZATION(UStaticMesh)
@@ -27,10 +28,19 @@ void UStaticMeshAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext
     Data->SetObjectField(TEXT("BodySetup"), BodySetupObject);
 
     //Export raw mesh data into separate FBX file that can be imported back into UE
-    const FString OutFbxMeshFileName = Context->GetDumpFilePath(TEXT(""), TEXT("fbx"));
-    FString OutErrorMessage;
-    const bool bSuccess = FFbxMeshExporter::ExportStaticMeshIntoFbxFile(Asset, OutFbxMeshFileName, false, &OutErrorMessage);
-    checkf(bSuccess, TEXT("Failed to export static mesh %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
+    //Unless mesh keeps CPU data itself, geometry is read from the copy of the package loaded with CPU access forced
+    UStaticMesh* RenderDataMesh = Asset;
+    if (!Asset->bAllowCPUAccess && Context->GetRenderDataPackage() != NULL) {
+        RenderDataMesh = FindObject<UStaticMesh>(Context->GetRenderDataPackage(), *Asset->GetName());
+    }
+    if (RenderDataMesh != NULL && RenderDataMesh->bAllowCPUAccess) {
+        const FString OutFbxMeshFileName = Context->GetDumpFilePath(TEXT(""), TEXT("fbx"));
+        FString OutErrorMessage;
+        const bool bSuccess = FFbxMeshExporter::ExportStaticMeshIntoFbxFile(RenderDataMesh, OutFbxMeshFileName, false, &OutErrorMessage);
+        checkf(bSuccess, TEXT("Failed to export static mesh %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
+    } else {
+        UE_LOG(LogSatisfactoryModLoader, Warning, TEXT("Skipping FBX export of static mesh %s, it has been loaded without CPU access to render data"), *Asset->GetPathName());
+    }
     
     END_ASSET_SERIALIZATION
 }
@@ -0,0 +1,381 @@
+#include "Toolkit/KismetBytecodeScanner.h"
+#include "UObject/Script.h"
+
+//Maximum nesting depth of expressions, used to avoid stack overflows on malformed bytecode
+#define MAX_EXPRESSION_NESTING_DEPTH 1024
+
+/** Walks kismet bytecode in place, advancing script index over expressions without decoding their contents */
+class FKismetBytecodeWalker {
+public:
+	FKismetBytecodeWalker(const uint8* InScript, int32 InScriptSize, TArray<int32>* InJumpTargets = NULL) : Script(InScript), ScriptSize(InScriptSize), NestingDepth(0), JumpTargets(InJumpTargets) {}
+
+	/** Skips a single expression with all of it's operands. Returns false if bytecode is malformed */
+	bool SkipExpression(int32& ScriptIndex) {
+		if (ScriptIndex >= ScriptSize || NestingDepth >= MAX_EXPRESSION_NESTING_DEPTH) {
+			return false;
+		}
+		NestingDepth++;
+		const bool bResult = SkipExpressionInternal(ScriptIndex);
+		NestingDepth--;
+		return bResult;
+	}
+private:
+	const uint8* Script;
+	int32 ScriptSize;
+	int32 NestingDepth;
+	/** When set, receives absolute script offsets of all jump instructions walked, including nested ones */
+	TArray<int32>* JumpTargets;
+
+	FORCEINLINE bool Skip(int32& ScriptIndex, int32 NumBytes) const {
+		if (ScriptIndex + NumBytes > ScriptSize) {
+			return false;
+		}
+		ScriptIndex += NumBytes;
+		return true;
+	}
+
+	FORCEINLINE bool ReadByte(int32& ScriptIndex, uint8& OutValue) const {
+		if (ScriptIndex >= ScriptSize) {
+			return false;
+		}
+		OutValue = Script[ScriptIndex++];
+		return true;
+	}
+
+	FORCEINLINE bool ReadWord(int32& ScriptIndex, uint16& OutValue) const {
+		if (ScriptIndex + 2 > ScriptSize) {
+			return false;
+		}
+		OutValue = Script[ScriptIndex] | ((uint16) Script[ScriptIndex + 1] << 8);
+		ScriptIndex += 2;
+		return true;
+	}
+
+	FORCEINLINE bool SkipPointer(int32& ScriptIndex) const { return Skip(ScriptIndex, sizeof(ScriptPointerType)); }
+	FORCEINLINE bool SkipName(int32& ScriptIndex) const { return Skip(ScriptIndex, sizeof(FScriptName)); }
+	FORCEINLINE bool SkipSkipCount(int32& ScriptIndex) const { return Skip(ScriptIndex, sizeof(CodeSkipSizeType)); }
+
+	/** Skips code offset which is a jump target, recording it if requested */
+	FORCEINLINE bool SkipJumpTarget(int32& ScriptIndex) const {
+		if (ScriptIndex + (int32) sizeof(CodeSkipSizeType) > ScriptSize) {
+			return false;
+		}
+		if (JumpTargets) {
+			JumpTargets->Add((int32) FPlatformMemory::ReadUnaligned<CodeSkipSizeType>(Script + ScriptIndex));
+		}
+		ScriptIndex += sizeof(CodeSkipSizeType);
+		return true;
+	}
+
+	/** Skips NULL-terminated ANSI string */
+	bool SkipString8(int32& ScriptIndex) const {
+		while (ScriptIndex < ScriptSize) {
+			if (Script[ScriptIndex++] == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Skips NULL-terminated UTF-16 string */
+	bool SkipString16(int32& ScriptIndex) const {
+		while (ScriptIndex + 2 <= ScriptSize) {
+			const bool bIsTerminator = Script[ScriptIndex] == 0 && Script[ScriptIndex + 1] == 0;
+			ScriptIndex += 2;
+			if (bIsTerminator) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Skips string constant expression, as used by text literals */
+	bool SkipString(int32& ScriptIndex) const {
+		uint8 Opcode;
+		if (!ReadByte(ScriptIndex, Opcode)) {
+			return false;
+		}
+		if (Opcode == EX_StringConst) {
+			return SkipString8(ScriptIndex);
+		}
+		if (Opcode == EX_UnicodeStringConst) {
+			return SkipString16(ScriptIndex);
+		}
+		return false;
+	}
+
+	/** Skips expressions until the given terminator opcode is encountered, and then terminator itself */
+	bool SkipExpressionsUntil(int32& ScriptIndex, uint8 TerminatorOpcode) {
+		while (ScriptIndex < ScriptSize && Script[ScriptIndex] != TerminatorOpcode) {
+			if (!SkipExpression(ScriptIndex)) {
+				return false;
+			}
+		}
+		return Skip(ScriptIndex, 1);
+	}
+
+	bool SkipExpressionInternal(int32& ScriptIndex) {
+		const EExprToken Opcode = (EExprToken) Script[ScriptIndex++];
+
+		switch (Opcode) {
+		//Single byte instructions without any operands
+		case EX_DeprecatedOp4A:
+		case EX_Nothing:
+		case EX_EndOfScript:
+		case EX_IntZero:
+		case EX_IntOne:
+		case EX_True:
+		case EX_False:
+		case EX_NoObject:
+		case EX_NoInterface:
+		case EX_Self:
+		case EX_PopExecutionFlow:
+		case EX_Breakpoint:
+		case EX_WireTracepoint:
+		case EX_Tracepoint:
+			return true;
+
+		//Instructions with a single pointer operand
+		case EX_LocalVariable:
+		case EX_DefaultVariable:
+		case EX_InstanceVariable:
+		case EX_LocalOutVariable:
+		case EX_ClassSparseDataVariable:
+		case EX_ObjectConst:
+		case EX_PropertyConst:
+			return SkipPointer(ScriptIndex);
+
+		//Instructions with a single name operand
+		case EX_NameConst:
+		case EX_InstanceDelegate:
+			return SkipName(ScriptIndex);
+
+		//Instructions with a single code offset operand
+		case EX_Jump:
+		case EX_PushExecutionFlow:
+			return SkipJumpTarget(ScriptIndex);
+		case EX_SkipOffsetConst:
+			return SkipSkipCount(ScriptIndex);
+
+		//Fixed size constants
+		case EX_ByteConst:
+		case EX_IntConstByte:
+			return Skip(ScriptIndex, sizeof(uint8));
+		case EX_IntConst:
+		case EX_FloatConst:
+			return Skip(ScriptIndex, sizeof(int32));
+		case EX_Int64Const:
+		case EX_UInt64Const:
+			return Skip(ScriptIndex, sizeof(int64));
+		case EX_RotationConst:
+		case EX_VectorConst:
+			return Skip(ScriptIndex, sizeof(float) * 3);
+		case EX_TransformConst:
+			return Skip(ScriptIndex, sizeof(float) * 10);
+		case EX_StringConst:
+			return SkipString8(ScriptIndex);
+		case EX_UnicodeStringConst:
+			return SkipString16(ScriptIndex);
+
+		//Instructions wrapping a single expression
+		case EX_ComputedJump:
+		case EX_InterfaceContext:
+		case EX_Return:
+		case EX_SoftObjectConst:
+		case EX_FieldPathConst:
+		case EX_ClearMulticastDelegate:
+		case EX_PopExecutionFlowIfNot:
+			return SkipExpression(ScriptIndex);
+
+		//Instructions with a pointer followed by a single expression
+		case EX_ObjToInterfaceCast:
+		case EX_CrossInterfaceCast:
+		case EX_InterfaceToObjCast:
+		case EX_LetValueOnPersistentFrame:
+		case EX_StructMemberContext:
+		case EX_MetaCast:
+		case EX_DynamicCast:
+			return SkipPointer(ScriptIndex) && SkipExpression(ScriptIndex);
+
+		//Instructions with a code offset followed by a single expression
+		case EX_JumpIfNot:
+			return SkipJumpTarget(ScriptIndex) && SkipExpression(ScriptIndex);
+		case EX_Skip:
+			return SkipSkipCount(ScriptIndex) && SkipExpression(ScriptIndex);
+
+		//Instructions with two expressions
+		case EX_LetObj:
+		case EX_LetWeakObjPtr:
+		case EX_LetBool:
+		case EX_LetDelegate:
+		case EX_LetMulticastDelegate:
+		case EX_AddMulticastDelegate:
+		case EX_RemoveMulticastDelegate:
+		case EX_ArrayGetByRef:
+			return SkipExpression(ScriptIndex) && SkipExpression(ScriptIndex);
+		case EX_Let:
+			return SkipPointer(ScriptIndex) && SkipExpression(ScriptIndex) && SkipExpression(ScriptIndex);
+		case EX_BindDelegate:
+			return SkipName(ScriptIndex) && SkipExpression(ScriptIndex) && SkipExpression(ScriptIndex);
+
+		//Function calls with parameter lists
+		case EX_LocalVirtualFunction:
+		case EX_VirtualFunction:
+			return SkipName(ScriptIndex) && SkipExpressionsUntil(ScriptIndex, EX_EndFunctionParms);
+		case EX_LocalFinalFunction:
+		case EX_CallMath:
+		case EX_FinalFunction:
+			return SkipPointer(ScriptIndex) && SkipExpressionsUntil(ScriptIndex, EX_EndFunctionParms);
+		case EX_CallMulticastDelegate:
+			return SkipPointer(ScriptIndex) && SkipExpression(ScriptIndex) && SkipExpressionsUntil(ScriptIndex, EX_EndFunctionParms);
+
+		//Context switching instructions
+		case EX_ClassContext:
+		case EX_Context:
+		case EX_Context_FailSilent:
+			return SkipExpression(ScriptIndex) && SkipSkipCount(ScriptIndex) && SkipPointer(ScriptIndex) && SkipExpression(ScriptIndex);
+
+		//Container literals
+		case EX_SetArray:
+			return SkipExpression(ScriptIndex) && SkipExpressionsUntil(ScriptIndex, EX_EndArray);
+		case EX_SetSet:
+			return SkipExpression(ScriptIndex) && Skip(ScriptIndex, sizeof(int32)) && SkipExpressionsUntil(ScriptIndex, EX_EndSet);
+		case EX_SetMap:
+			return SkipExpression(ScriptIndex) && Skip(ScriptIndex, sizeof(int32)) && SkipExpressionsUntil(ScriptIndex, EX_EndMap);
+		case EX_ArrayConst:
+			return SkipPointer(ScriptIndex) && Skip(ScriptIndex, sizeof(int32)) && SkipExpressionsUntil(ScriptIndex, EX_EndArrayConst);
+		case EX_SetConst:
+			return SkipPointer(ScriptIndex) && Skip(ScriptIndex, sizeof(int32)) && SkipExpressionsUntil(ScriptIndex, EX_EndSetConst);
+		case EX_MapConst:
+			return SkipPointer(ScriptIndex) && SkipPointer(ScriptIndex) && Skip(ScriptIndex, sizeof(int32)) && SkipExpressionsUntil(ScriptIndex, EX_EndMapConst);
+		case EX_StructConst:
+			//Struct constant has one expression per serialized property, terminated by EX_EndStructConst
+			//We rely on the terminator instead of walking struct properties, so struct pointer is never dereferenced
+			return SkipPointer(ScriptIndex) && Skip(ScriptIndex, sizeof(int32)) && SkipExpressionsUntil(ScriptIndex, EX_EndStructConst);
+
+		case EX_PrimitiveCast:
+			{
+				uint8 ConversionType;
+				if (!ReadByte(ScriptIndex, ConversionType)) {
+					return false;
+				}
+				if (ConversionType == ECastToken::CST_ObjectToInterface) {
+					if (!SkipPointer(ScriptIndex)) {
+						return false;
+					}
+				} else if (ConversionType != ECastToken::CST_InterfaceToBool && ConversionType != ECastToken::CST_ObjectToBool) {
+					return false;
+				}
+				return SkipExpression(ScriptIndex);
+			}
+		case EX_TextConst:
+			{
+				uint8 TextLiteralType;
+				if (!ReadByte(ScriptIndex, TextLiteralType)) {
+					return false;
+				}
+				switch ((EBlueprintTextLiteralType) TextLiteralType) {
+				case EBlueprintTextLiteralType::Empty:
+					return true;
+				case EBlueprintTextLiteralType::LocalizedText:
+					return SkipString(ScriptIndex) && SkipString(ScriptIndex) && SkipString(ScriptIndex);
+				case EBlueprintTextLiteralType::InvariantText:
+				case EBlueprintTextLiteralType::LiteralString:
+					return SkipString(ScriptIndex);
+				case EBlueprintTextLiteralType::StringTableEntry:
+					return SkipPointer(ScriptIndex) && SkipString(ScriptIndex) && SkipString(ScriptIndex);
+				default:
+					return false;
+				}
+			}
+		case EX_Assert:
+			return Skip(ScriptIndex, sizeof(uint16) + sizeof(uint8)) && SkipExpression(ScriptIndex);
+		case EX_InstrumentationEvent:
+			{
+				uint8 EventType;
+				if (!ReadByte(ScriptIndex, EventType)) {
+					return false;
+				}
+				if (EventType == EScriptInstrumentation::InlineEvent) {
+					return SkipName(ScriptIndex);
+				}
+				return true;
+			}
+		case EX_SwitchValue:
+			{
+				uint16 NumCases;
+				//Offsets of the switch end and of the next case are absolute script offsets the VM jumps to
+				if (!ReadWord(ScriptIndex, NumCases) || !SkipJumpTarget(ScriptIndex) || !SkipExpression(ScriptIndex)) {
+					return false;
+				}
+				for (uint16 CaseIndex = 0; CaseIndex < NumCases; ++CaseIndex) {
+					if (!SkipExpression(ScriptIndex) || !SkipJumpTarget(ScriptIndex) || !SkipExpression(ScriptIndex)) {
+						return false;
+					}
+				}
+				//Default result expression
+				return SkipExpression(ScriptIndex);
+			}
+		default:
+			//Unknown opcode or terminator token outside of the list it terminates
+			return false;
+		}
+	}
+};
+
+bool FKismetBytecodeScanner::GetExpressionSize(const TArray<uint8>& Script, int32 ExpressionIndex, int32& OutExpressionSize, TArray<int32>* OutJumpTargets) {
+	if (ExpressionIndex < 0) {
+		OutExpressionSize = -1;
+		return false;
+	}
+	FKismetBytecodeWalker Walker(Script.GetData(), Script.Num(), OutJumpTargets);
+	int32 ScriptIndex = ExpressionIndex;
+
+	if (!Walker.SkipExpression(ScriptIndex)) {
+		OutExpressionSize = -1;
+		return false;
+	}
+	OutExpressionSize = ScriptIndex - ExpressionIndex;
+	return true;
+}
+
+bool FKismetBytecodeScanner::IsStatementIndex(const TArray<uint8>& Script, int32 ExpectedStatementIndex) {
+	FKismetBytecodeWalker Walker(Script.GetData(), Script.Num());
+	int32 ScriptIndex = 0;
+
+	//Statements can only be found by walking from the start of the script, because arbitrary
+	//script index can be inside of some statement and still be decoded as a valid expression
+	while (ScriptIndex < ExpectedStatementIndex) {
+		if (!Walker.SkipExpression(ScriptIndex)) {
+			return false;
+		}
+	}
+	return ScriptIndex == ExpectedStatementIndex && ScriptIndex < Script.Num();
+}
+
+bool FKismetBytecodeScanner::GetStatementLength(const TArray<uint8>& Script, int32 ExpectedStatementIndex, int32& OutStatementLength) {
+	if (!IsStatementIndex(Script, ExpectedStatementIndex)) {
+		//We haven't found a statement with expected index, so input is probably invalid
+		OutStatementLength = -1;
+		return false;
+	}
+	return GetExpressionSize(Script, ExpectedStatementIndex, OutStatementLength);
+}
+
+bool FKismetBytecodeScanner::FindFirstStatementOfType(const TArray<uint8>& Script, int32 StartIndex, uint8 ExpectedStatementOpcode, int32& OutStatementIndex) {
+	FKismetBytecodeWalker Walker(Script.GetData(), Script.Num());
+	int32 ScriptIndex = FMath::Max(StartIndex, 0);
+
+	while (ScriptIndex < Script.Num()) {
+		if (Script[ScriptIndex] == ExpectedStatementOpcode) {
+			OutStatementIndex = ScriptIndex;
+			return true;
+		}
+		if (!Walker.SkipExpression(ScriptIndex)) {
+			break;
+		}
+	}
+	//We haven't found any statement with matching opcode
+	OutStatementIndex = -1;
+	return false;
+}
@@ -0,0 +1,99 @@
+#include "Toolkit/KismetBytecodeStatementIndex.h"
+#include "Toolkit/KismetBytecodeScanner.h"
+#include "Algo/BinarySearch.h"
+#include "UObject/Class.h"
+#include "UObject/Script.h"
+
+FCriticalSection FKismetBytecodeStatementIndex::CachedIndicesCriticalSection;
+TMap<TWeakObjectPtr<UFunction>, TSharedPtr<const FKismetBytecodeStatementIndex>> FKismetBytecodeStatementIndex::CachedIndices;
+int32 FKismetBytecodeStatementIndex::NextStaleIndicesPruneSize = 64;
+
+TSharedRef<const FKismetBytecodeStatementIndex> FKismetBytecodeStatementIndex::GetStatementIndex(UFunction* Function) {
+	check(Function);
+	FScopeLock ScopeLock(&CachedIndicesCriticalSection);
+
+	//Entries of garbage collected functions are never looked up again, so drop them once the cache has grown enough
+	if (CachedIndices.Num() >= NextStaleIndicesPruneSize) {
+		for (auto It = CachedIndices.CreateIterator(); It; ++It) {
+			if (!It.Key().IsValid()) {
+				It.RemoveCurrent();
+			}
+		}
+		NextStaleIndicesPruneSize = FMath::Max(CachedIndices.Num() * 2, 64);
+	}
+	TSharedPtr<const FKismetBytecodeStatementIndex>& CachedIndex = CachedIndices.FindOrAdd(Function);
+
+	//Rebuild index if it has not been built yet, or if script has been reallocated or resized since it was built
+	if (!CachedIndex.IsValid() ||
+		CachedIndex->SourceScriptData != Function->Script.GetData() ||
+		CachedIndex->SourceScriptSize != Function->Script.Num()) {
+		CachedIndex = MakeShareable(new FKismetBytecodeStatementIndex(Function->Script));
+	}
+	return CachedIndex.ToSharedRef();
+}
+
+void FKismetBytecodeStatementIndex::InvalidateStatementIndex(UFunction* Function) {
+	FScopeLock ScopeLock(&CachedIndicesCriticalSection);
+	CachedIndices.Remove(Function);
+}
+
+FKismetBytecodeStatementIndex::FKismetBytecodeStatementIndex(const TArray<uint8>& Script) {
+	this->SourceScriptData = Script.GetData();
+	this->SourceScriptSize = Script.Num();
+	this->bIsComplete = true;
+
+	int32 ScriptIndex = 0;
+	TArray<int32> StatementJumpTargets;
+	while (ScriptIndex < Script.Num()) {
+		int32 StatementLength;
+		//Jump targets are collected from nested expressions too, not only from top level jump statements
+		StatementJumpTargets.Reset();
+		if (!FKismetBytecodeScanner::GetExpressionSize(Script, ScriptIndex, StatementLength, &StatementJumpTargets)) {
+			//Malformed statement, we cannot reliably index anything past it
+			this->bIsComplete = false;
+			break;
+		}
+		StatementOffsets.Add(ScriptIndex);
+		JumpTargets.Append(StatementJumpTargets);
+		
+		if (Script[ScriptIndex] == EX_Return) {
+			ReturnStatementOffsets.Add(ScriptIndex);
+		}
+		ScriptIndex += StatementLength;
+	}
+	this->EndOfStatements = ScriptIndex;
+
+	//Statement and return offsets are sorted by construction, jump targets need to be sorted and deduplicated
+	JumpTargets.Sort();
+	int32 NumUniqueJumpTargets = 0;
+	for (int32 i = 0; i < JumpTargets.Num(); i++) {
+		if (NumUniqueJumpTargets == 0 || JumpTargets[NumUniqueJumpTargets - 1] != JumpTargets[i]) {
+			JumpTargets[NumUniqueJumpTargets++] = JumpTargets[i];
+		}
+	}
+	JumpTargets.SetNum(NumUniqueJumpTargets);
+}
+
+bool FKismetBytecodeStatementIndex::IsStatementIndex(int32 ScriptOffset) const {
+	return Algo::BinarySearch(StatementOffsets, ScriptOffset) != INDEX_NONE;
+}
+
+bool FKismetBytecodeStatementIndex::IsJumpTarget(int32 ScriptOffset) const {
+	return Algo::BinarySearch(JumpTargets, ScriptOffset) != INDEX_NONE;
+}
+
+bool FKismetBytecodeStatementIndex::GetStatementLength(int32 StatementIndex, int32& OutStatementLength) const {
+	const int32 ElementIndex = Algo::BinarySearch(StatementOffsets, StatementIndex);
+	if (ElementIndex == INDEX_NONE) {
+		OutStatementLength = -1;
+		return false;
+	}
+	const int32 NextStatementOffset = ElementIndex + 1 < StatementOffsets.Num() ? StatementOffsets[ElementIndex + 1] : EndOfStatements;
+	OutStatementLength = NextStatementOffset - StatementIndex;
+	return true;
+}
+
+int32 FKismetBytecodeStatementIndex::FindStatementAtOrAfter(int32 ScriptOffset) const {
+	const int32 ElementIndex = Algo::LowerBound(StatementOffsets, ScriptOffset);
+	return ElementIndex < StatementOffsets.Num() ? StatementOffsets[ElementIndex] : INDEX_NONE;
+}
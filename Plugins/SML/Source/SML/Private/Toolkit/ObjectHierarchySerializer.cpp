@@ -7,6 +7,7 @@
 DECLARE_LOG_CATEGORY_CLASS(LogObjectHierarchySerializer, Warning, Log);
 
 TSet<FName> UObjectHierarchySerializer::UnhandledNativeClasses;
+FCriticalSection UObjectHierarchySerializer::UnhandledNativeClassesCriticalSection;
 
 UObjectHierarchySerializer::UObjectHierarchySerializer() {
     bAllowExportObjectSerialization = true;
@@ -130,13 +131,7 @@ TSharedRef<FJsonObject> UObjectHierarchySerializer::SerializeObjectProperties(UO
 
 void UObjectHierarchySerializer::SerializeObjectPropertiesIntoObject(UObject* Object, TSharedPtr<FJsonObject> Properties) {
     UClass* ObjectClass = Object->GetClass();
-    for (UProperty* Property = ObjectClass->PropertyLink; Property; Property = Property->PropertyLinkNext) {
-        if (PropertySerializer->ShouldSerializeProperty(Property)) {
-            const void* PropertyValue = Property->ContainerPtrToValuePtr<void>(Object);
-            TSharedRef<FJsonValue> PropertyValueJson = PropertySerializer->SerializePropertyValue(Property, PropertyValue);
-            Properties->SetField(Property->GetName(), PropertyValueJson);
-        }
-    }
+    PropertySerializer->SerializeStructProperties(ObjectClass, Object, Properties, true);
 }
 
 void UObjectHierarchySerializer::DeserializeObjectProperties(const TSharedRef<FJsonObject>& Properties, UObject* Object) {
@@ -298,6 +293,8 @@ void UObjectHierarchySerializer::SerializeExportedObject(TSharedPtr<FJsonObject>
     //checkf(AllowedNativeSerializeClasses.Contains(ClassWithSerialize), TEXT("Attempt to serialize object of class %s (%s) which has custom Serialize"),
     //    *ClassWithSerialize->GetPathName(), *Object->GetPathName());
     if (!AllowedNativeSerializeClasses.Contains(ClassWithSerialize)) {
+        //Packages are dumped on multiple threads at once, and this set is shared between them
+        FScopeLock ScopeLock(&UnhandledNativeClassesCriticalSection);
         UnhandledNativeClasses.Add(ClassWithSerialize->GetFName());
     }
         
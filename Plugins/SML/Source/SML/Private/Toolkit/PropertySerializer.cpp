@@ -209,6 +209,7 @@ void UPropertySerializer::DisablePropertySerialization(UStruct* Struct, FName Pr
 	FProperty* Property = Struct->FindPropertyByName(PropertyName);
 	check(Property);
 	this->BlacklistedProperties.Add(Property);
+	InvalidateSerializationPlans();
 }
 
 void UPropertySerializer::SetCustomSerializer(UStruct* Struct, FName PropertyName, FPropertySerializer Serializer) {
@@ -216,6 +217,7 @@ void UPropertySerializer::SetCustomSerializer(UStruct* Struct, FName PropertyNam
 	check(Property);
 	this->PinnedStructs.Add(Struct);
 	this->CustomPropertySerializers.Add(Property, Serializer);
+	InvalidateSerializationPlans();
 }
 
 void UPropertySerializer::SetCustomDeserializer(UStruct* Struct, FName PropertyName, FPropertyDeserializer Deserializer) {
@@ -244,18 +246,136 @@ bool UPropertySerializer::ShouldSerializeProperty(FProperty* Property) const {
     return true;
 }
 
+void UPropertySerializer::InvalidateSerializationPlans() {
+	//Plans have blacklist decisions and custom serializer pointers baked in, so they need to be recompiled
+	this->FilteredSerializationPlans.Empty();
+	this->UnfilteredSerializationPlans.Empty();
+}
+
+EPropertyValueKind UPropertySerializer::ResolvePropertyValueKind(FProperty* Property) {
+	//Order of the checks matters here, because some property types are subclasses of other ones
+	if (Property->IsA<FMapProperty>()) {
+		return EPropertyValueKind::Map;
+	}
+	if (Property->IsA<FSetProperty>()) {
+		return EPropertyValueKind::Set;
+	}
+	if (Property->IsA<FArrayProperty>()) {
+		return EPropertyValueKind::Array;
+	}
+	if (Property->IsA<FMulticastDelegateProperty>()) {
+		return EPropertyValueKind::MulticastDelegate;
+	}
+	if (Property->IsA<FDelegateProperty>()) {
+		return EPropertyValueKind::Delegate;
+	}
+	if (Property->IsA<FInterfaceProperty>()) {
+		return EPropertyValueKind::Interface;
+	}
+	if (Property->IsA<FClassProperty>()) {
+		return EPropertyValueKind::Class;
+	}
+	if (Property->IsA<FSoftObjectProperty>()) {
+		return EPropertyValueKind::SoftObject;
+	}
+	if (Property->IsA<FObjectPropertyBase>()) {
+		return EPropertyValueKind::Object;
+	}
+	if (Property->IsA<FStructProperty>()) {
+		return EPropertyValueKind::Struct;
+	}
+	//If Enum is NULL, byte property will be handled as standard FNumericProperty
+	const FByteProperty* ByteProperty = CastField<const FByteProperty>(Property);
+	if (ByteProperty && ByteProperty->Enum) {
+		return EPropertyValueKind::EnumByte;
+	}
+	if (const FNumericProperty* NumberProperty = CastField<const FNumericProperty>(Property)) {
+		return NumberProperty->IsFloatingPoint() ? EPropertyValueKind::FloatingPoint : EPropertyValueKind::Integer;
+	}
+	if (Property->IsA<FBoolProperty>()) {
+		return EPropertyValueKind::Bool;
+	}
+	if (Property->IsA<FStrProperty>()) {
+		return EPropertyValueKind::String;
+	}
+	if (Property->IsA<FEnumProperty>()) {
+		return EPropertyValueKind::Enum;
+	}
+	if (Property->IsA<FNameProperty>()) {
+		return EPropertyValueKind::Name;
+	}
+	if (Property->IsA<FTextProperty>()) {
+		return EPropertyValueKind::Text;
+	}
+	if (Property->IsA<FFieldPathProperty>()) {
+		return EPropertyValueKind::FieldPath;
+	}
+	return EPropertyValueKind::Unsupported;
+}
+
+TSharedRef<const FStructSerializationPlan> UPropertySerializer::GetSerializationPlan(UStruct* Struct, bool bFilterProperties) {
+	TMap<UStruct*, TSharedPtr<const FStructSerializationPlan>>& SerializationPlans = bFilterProperties ? FilteredSerializationPlans : UnfilteredSerializationPlans;
+	if (const TSharedPtr<const FStructSerializationPlan>* ExistingPlan = SerializationPlans.Find(Struct)) {
+		return ExistingPlan->ToSharedRef();
+	}
+
+	const TSharedRef<FStructSerializationPlan> NewPlan = MakeShareable(new FStructSerializationPlan());
+	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext) {
+		if (bFilterProperties && !ShouldSerializeProperty(Property)) {
+			continue;
+		}
+		FPropertySerializationStep& Step = NewPlan->Steps.AddDefaulted_GetRef();
+		Step.Property = Property;
+		Step.Offset = Property->GetOffset_ForInternal();
+		Step.ValueKind = ResolvePropertyValueKind(Property);
+		Step.Name = Property->GetName();
+		Step.CustomSerializer = CustomPropertySerializers.Find(Property);
+	}
+	SerializationPlans.Add(Struct, NewPlan);
+	return NewPlan;
+}
+
+void UPropertySerializer::SerializeStructProperties(UStruct* Struct, const void* Container, const TSharedPtr<FJsonObject>& OutObject, bool bFilterProperties) {
+	//Keep plan referenced while we are executing it, because nested structs can add new plans into the cache
+	const TSharedRef<const FStructSerializationPlan> Plan = GetSerializationPlan(Struct, bFilterProperties);
+
+	for (const FPropertySerializationStep& Step : Plan->Steps) {
+		const uint8* PropertyValue = (const uint8*) Container + Step.Offset;
+		FProperty* Property = Step.Property;
+		TSharedPtr<FJsonValue> PropertyValueJson;
+
+		if (Step.CustomSerializer) {
+			//Use custom property serializer when it is available
+			PropertyValueJson = (*Step.CustomSerializer)(Property, PropertyValue);
+			
+		} else if (Property->ArrayDim != 1) {
+			//Serialize statically sized array properties
+			TArray<TSharedPtr<FJsonValue>> OutJsonValueArray;
+			for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++) {
+				const uint8* ArrayPropertyValue = PropertyValue + Property->ElementSize * ArrayIndex;
+				OutJsonValueArray.Add(SerializePropertyValueOfKind(Step.ValueKind, Property, ArrayPropertyValue));
+			}
+			PropertyValueJson = MakeShareable(new FJsonValueArray(OutJsonValueArray));
+		} else {
+			PropertyValueJson = SerializePropertyValueOfKind(Step.ValueKind, Property, PropertyValue);
+		}
+		OutObject->SetField(Step.Name, PropertyValueJson);
+	}
+}
+
 TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValue(FProperty* Property, const void* Value) {
-	if (CustomPropertySerializers.Contains(Property)) {
+	if (const FPropertySerializer* CustomSerializer = CustomPropertySerializers.Find(Property)) {
 		//Use custom property serializer when it is available
-		return CustomPropertySerializers.FindChecked(Property)(Property, Value);
+		return (*CustomSerializer)(Property, Value);
 	}
 	
 	//Serialize statically sized array properties
 	if (Property->ArrayDim != 1) {
+		const EPropertyValueKind ValueKind = ResolvePropertyValueKind(Property);
 		TArray<TSharedPtr<FJsonValue>> OutJsonValueArray;
 		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++) {
 			const uint8* ArrayPropertyValue = (const uint8*) Value + Property->ElementSize * ArrayIndex;
-			const TSharedRef<FJsonValue> ElementValue = SerializePropertyValueInner(Property, ArrayPropertyValue);
+			const TSharedRef<FJsonValue> ElementValue = SerializePropertyValueOfKind(ValueKind, Property, ArrayPropertyValue);
 			OutJsonValueArray.Add(ElementValue);
 		}
 		return MakeShareable(new FJsonValueArray(OutJsonValueArray));
@@ -265,18 +385,34 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValue(FProperty* Pr
 }
 
 TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FProperty* Property, const void* Value) {
-	const FMapProperty* MapProperty = CastField<const FMapProperty>(Property);
-	const FSetProperty* SetProperty = CastField<const FSetProperty>(Property);
-	const FArrayProperty* ArrayProperty = CastField<const FArrayProperty>(Property);
-	
-	if (MapProperty) {
+	return SerializePropertyValueOfKind(ResolvePropertyValueKind(Property), Property, Value);
+}
+
+TSharedRef<FJsonValue> UPropertySerializer::SerializeContainerElement(FProperty* ElementProperty, const FPropertySerializer* CustomSerializer, EPropertyValueKind ElementKind, const void* Value) {
+	if (CustomSerializer) {
+		return (*CustomSerializer)(ElementProperty, Value);
+	}
+	//Container elements can never be statically sized arrays
+	return SerializePropertyValueOfKind(ElementKind, ElementProperty, Value);
+}
+
+TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueOfKind(EPropertyValueKind ValueKind, FProperty* Property, const void* Value) {
+	switch (ValueKind) {
+	case EPropertyValueKind::Map: {
+		const FMapProperty* MapProperty = static_cast<const FMapProperty*>(Property);
 		FProperty* KeyProperty = MapProperty->KeyProp;
 		FProperty* ValueProperty = MapProperty->ValueProp;
+		const FPropertySerializer* KeyCustomSerializer = CustomPropertySerializers.Find(KeyProperty);
+		const FPropertySerializer* ValueCustomSerializer = CustomPropertySerializers.Find(ValueProperty);
+		const EPropertyValueKind KeyKind = ResolvePropertyValueKind(KeyProperty);
+		const EPropertyValueKind ValueValueKind = ResolvePropertyValueKind(ValueProperty);
+		
 		FScriptMapHelper MapHelper(MapProperty, Value);
 		TArray<TSharedPtr<FJsonValue>> ResultArray;
+		ResultArray.Reserve(MapHelper.Num());
 		for (int32 i = 0; i < MapHelper.Num(); i++) {
-			TSharedPtr<FJsonValue> EntryKey = SerializePropertyValue(KeyProperty, MapHelper.GetKeyPtr(i));
-			TSharedPtr<FJsonValue> EntryValue = SerializePropertyValue(ValueProperty, MapHelper.GetValuePtr(i));
+			TSharedPtr<FJsonValue> EntryKey = SerializeContainerElement(KeyProperty, KeyCustomSerializer, KeyKind, MapHelper.GetKeyPtr(i));
+			TSharedPtr<FJsonValue> EntryValue = SerializeContainerElement(ValueProperty, ValueCustomSerializer, ValueValueKind, MapHelper.GetValuePtr(i));
 			TSharedRef<FJsonObject> Pair = MakeShareable(new FJsonObject());
 			Pair->SetField(TEXT("Key"), EntryKey);
 			Pair->SetField(TEXT("Value"), EntryValue);
@@ -284,30 +420,35 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FPropert
 		}
 		return MakeShareable(new FJsonValueArray(ResultArray));
 	}
-	
-	if (SetProperty) {
+	case EPropertyValueKind::Set: {
+		const FSetProperty* SetProperty = static_cast<const FSetProperty*>(Property);
 		FProperty* ElementProperty = SetProperty->ElementProp;
+		const FPropertySerializer* ElementCustomSerializer = CustomPropertySerializers.Find(ElementProperty);
+		const EPropertyValueKind ElementKind = ResolvePropertyValueKind(ElementProperty);
+		
 		FScriptSetHelper SetHelper(SetProperty, Value);
 		TArray<TSharedPtr<FJsonValue>> ResultArray;
+		ResultArray.Reserve(SetHelper.Num());
 		for (int32 i = 0; i < SetHelper.Num(); i++) {
-			TSharedPtr<FJsonValue> Element = SerializePropertyValue(ElementProperty, SetHelper.GetElementPtr(i));
-			ResultArray.Add(Element);
+			ResultArray.Add(SerializeContainerElement(ElementProperty, ElementCustomSerializer, ElementKind, SetHelper.GetElementPtr(i)));
 		}
 		return MakeShareable(new FJsonValueArray(ResultArray));
 	}
-	
-	if (ArrayProperty) {
+	case EPropertyValueKind::Array: {
+		const FArrayProperty* ArrayProperty = static_cast<const FArrayProperty*>(Property);
 		FProperty* ElementProperty = ArrayProperty->Inner;
+		const FPropertySerializer* ElementCustomSerializer = CustomPropertySerializers.Find(ElementProperty);
+		const EPropertyValueKind ElementKind = ResolvePropertyValueKind(ElementProperty);
+		
 		FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
 		TArray<TSharedPtr<FJsonValue>> ResultArray;
+		ResultArray.Reserve(ArrayHelper.Num());
 		for (int32 i = 0; i < ArrayHelper.Num(); i++) {
-			TSharedPtr<FJsonValue> Element = SerializePropertyValue(ElementProperty, ArrayHelper.GetRawPtr(i));
-			ResultArray.Add(Element);
+			ResultArray.Add(SerializeContainerElement(ElementProperty, ElementCustomSerializer, ElementKind, ArrayHelper.GetRawPtr(i)));
 		}
 		return MakeShareable(new FJsonValueArray(ResultArray));
 	}
-
-	if (Property->IsA<FMulticastDelegateProperty>()) {
+	case EPropertyValueKind::MulticastDelegate: {
 		FMulticastScriptDelegate* MulticastScriptDelegate = (FMulticastScriptDelegate*) Value;
 		TArray<TSharedPtr<FJsonValue>> DelegatesArray;
 
@@ -325,8 +466,7 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FPropert
 		
 		return MakeShareable(new FJsonValueArray(DelegatesArray));
 	}
-	
-	if (Property->IsA<FDelegateProperty>()) {
+	case EPropertyValueKind::Delegate: {
 		FScriptDelegate* ScriptDelegate = (FScriptDelegate*) Value;
 		TSharedPtr<FJsonObject> DelegateObject = MakeShareable(new FJsonObject());
 
@@ -340,88 +480,85 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FPropert
 		
 		return MakeShareable(new FJsonValueObject(DelegateObject));
 	}
-	
-	if (Property->IsA<FInterfaceProperty>()) {
+	case EPropertyValueKind::Interface: {
 		//UObject is enough to re-create value, since we known property on deserialization
 		const FScriptInterface* Interface = reinterpret_cast<const FScriptInterface*>(Value);
 		int32 ObjectIndex = ObjectHierarchySerializer ? ObjectHierarchySerializer->SerializeObject(Interface->GetObject()) : 0;
 		return MakeShareable(new FJsonValueNumber(ObjectIndex));
 	}
-	
-	if (const FClassProperty* ClassProperty = CastField<const FClassProperty>(Property)) {
+	case EPropertyValueKind::Class: {
+		const FClassProperty* ClassProperty = static_cast<const FClassProperty*>(Property);
 		UClass* ClassObject = Cast<UClass>(ClassProperty->GetObjectPropertyValue(Value));
 		//For class it's enough just to have it's path name for deserialization
 		return MakeShareable(new FJsonValueString(ClassObject->GetPathName()));
 	}
-	
-	if (Property->IsA<FSoftObjectProperty>()) {
+	case EPropertyValueKind::SoftObject: {
 		//For soft object reference, path is enough too for deserialization.
 		const FSoftObjectPtr* ObjectPtr = reinterpret_cast<const FSoftObjectPtr*>(Value);
 		return MakeShareable(new FJsonValueString(ObjectPtr->ToSoftObjectPath().ToString()));
 	}
-
-	if (const FObjectPropertyBase* ObjectProperty = CastField<const FObjectPropertyBase>(Property)) {
+	case EPropertyValueKind::Object: {
 		//Need to serialize full UObject for object property
+		const FObjectPropertyBase* ObjectProperty = static_cast<const FObjectPropertyBase*>(Property);
 		UObject* ObjectPointer = ObjectProperty->GetObjectPropertyValue(Value);
 		int32 ObjectIndex = ObjectHierarchySerializer ? ObjectHierarchySerializer->SerializeObject(ObjectPointer) : 0;
 		return MakeShareable(new FJsonValueNumber(ObjectIndex));
 	}
-
-	if (const FStructProperty* StructProperty = CastField<const FStructProperty>(Property)) {
+	case EPropertyValueKind::Struct: {
 		//To serialize struct, we need it's type and value pointer, because struct value doesn't contain type information
+		const FStructProperty* StructProperty = static_cast<const FStructProperty*>(Property);
 		return MakeShareable(new FJsonValueObject(SerializeStruct(StructProperty->Struct, Value)));
 	}
-
-	if (const FByteProperty* ByteProperty = CastField<const FByteProperty>(Property)) {
-		//If Enum is NULL, property will be handled as standard UNumericProperty
-		if (ByteProperty->Enum) {
-			const int64 UnderlyingValue = ByteProperty->GetSignedIntPropertyValue(Value);
-			const FString EnumName = ByteProperty->Enum->GetNameByValue(UnderlyingValue).ToString();
-			return MakeShareable(new FJsonValueString(EnumName));
-		}
+	case EPropertyValueKind::EnumByte: {
+		const FByteProperty* ByteProperty = static_cast<const FByteProperty*>(Property);
+		const int64 UnderlyingValue = ByteProperty->GetSignedIntPropertyValue(Value);
+		const FString EnumName = ByteProperty->Enum->GetNameByValue(UnderlyingValue).ToString();
+		return MakeShareable(new FJsonValueString(EnumName));
 	}
-	
-	if (const FNumericProperty* NumberProperty = CastField<const FNumericProperty>(Property)) {
-		double ResultValue;
-		if (NumberProperty->IsFloatingPoint())
-			ResultValue = NumberProperty->GetFloatingPointPropertyValue(Value);
-		else ResultValue = NumberProperty->GetSignedIntPropertyValue(Value);
+	case EPropertyValueKind::FloatingPoint: {
+		const FNumericProperty* NumberProperty = static_cast<const FNumericProperty*>(Property);
+		const double ResultValue = NumberProperty->GetFloatingPointPropertyValue(Value);
 		return MakeShareable(new FJsonValueNumber(ResultValue));
 	}
-	
-	if (const FBoolProperty* BoolProperty = CastField<const FBoolProperty>(Property)) {
+	case EPropertyValueKind::Integer: {
+		const FNumericProperty* NumberProperty = static_cast<const FNumericProperty*>(Property);
+		const double ResultValue = NumberProperty->GetSignedIntPropertyValue(Value);
+		return MakeShareable(new FJsonValueNumber(ResultValue));
+	}
+	case EPropertyValueKind::Bool: {
+		const FBoolProperty* BoolProperty = static_cast<const FBoolProperty*>(Property);
 		const bool bBooleanValue = BoolProperty->GetPropertyValue(Value);
 		return MakeShareable(new FJsonValueBoolean(bBooleanValue));
 	}
-	
-	if (Property->IsA<FStrProperty>()) {
+	case EPropertyValueKind::String: {
 		const FString& StringValue = *reinterpret_cast<const FString*>(Value);
 		return MakeShareable(new FJsonValueString(StringValue));
 	}
-	
-	if (const FEnumProperty* EnumProperty = CastField<const FEnumProperty>(Property)) {
+	case EPropertyValueKind::Enum: {
+		const FEnumProperty* EnumProperty = static_cast<const FEnumProperty*>(Property);
 		const int64 UnderlyingValue = EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value);
 		const FString EnumName = EnumProperty->GetEnum()->GetNameByValue(UnderlyingValue).ToString();
 		return MakeShareable(new FJsonValueString(EnumName));
 	}
-	
-	if (Property->IsA<FNameProperty>()) {
+	case EPropertyValueKind::Name: {
 		//Name is perfectly representable as string
 		FName* Temp = ((FName*) Value);
 		return MakeShareable(new FJsonValueString(Temp->ToString()));
 	}
-
-	if (const FTextProperty* TextProperty = CastField<const FTextProperty>(Property)) {
+	case EPropertyValueKind::Text: {
+		const FTextProperty* TextProperty = static_cast<const FTextProperty*>(Property);
 		FString ResultValue;
 		const FText& TextValue = TextProperty->GetPropertyValue(Value);
 		FTextStringHelper::WriteToBuffer(ResultValue, TextValue);
 		return MakeShareable(new FJsonValueString(ResultValue));
 	}
-
-	if (Property->IsA<FFieldPathProperty>()) {
+	case EPropertyValueKind::FieldPath: {
 		FFieldPath* Temp = ((FFieldPath*) Value);
 		return MakeShareable(new FJsonValueString(Temp->ToString()));
 	}
+	default:
+		break;
+	}
 	
 	UE_LOG(LogPropertySerializer, Fatal, TEXT("Found unsupported property type when serializing value: %s"), *Property->GetClass()->GetName());
 	return MakeShareable(new FJsonValueString(TEXT("#ERROR#")));
@@ -430,13 +567,7 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FPropert
 TSharedRef<FJsonObject> UPropertySerializer::SerializeStruct(UScriptStruct* Struct, const void* Value) {
 	//checkf((Struct->StructFlags & EStructFlags::STRUCT_SerializeNative) == 0, TEXT("Attempt to serialize struct with native Serialize: %s"), *Struct->GetPathName());
 	TSharedRef<FJsonObject> Properties = MakeShareable(new FJsonObject());
-	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext) {
-		if (ObjectHierarchySerializer == NULL || ShouldSerializeProperty(Property)) {
-			const void* PropertyValue = Property->ContainerPtrToValuePtr<void>(Value);
-			TSharedRef<FJsonValue> PropertyValueJson = SerializePropertyValue(Property, PropertyValue);
-			Properties->SetField(Property->GetName(), PropertyValueJson);
-		}
-	}
+	SerializeStructProperties(Struct, Value, Properties, ObjectHierarchySerializer != NULL);
 	return Properties;
 }
 
@@ -6,6 +6,16 @@
 #include "Tooltip/ItemStackContextWidget.h"
 #include "Tooltip/SMLItemDisplayInterface.h"
 #include "Tooltip/SMLItemTooltipProvider.h"
+#include "Internationalization/Internationalization.h"
+
+void UItemTooltipSubsystem::Initialize(FSubsystemCollectionBase& Collection) {
+    //Cached descriptions are localized into the culture they have been composed in
+    FInternationalization::Get().OnCultureChanged().AddUObject(this, &UItemTooltipSubsystem::InvalidateDescriptionCache);
+}
+
+void UItemTooltipSubsystem::Deinitialize() {
+    FInternationalization::Get().OnCultureChanged().RemoveAll(this);
+}
 
 //Overwrites delegates bound to title & description widgets to use FTooltipHookHelper, add custom item widget
 void UItemTooltipSubsystem::ApplyItemOverridesToTooltip(UWidget* TooltipWidget, APlayerController* OwningPlayer, const FInventoryStack& InventoryStack) {
@@ -82,9 +92,18 @@ void UItemTooltipSubsystem::InitializePatches() {
 void UItemTooltipSubsystem::RegisterGlobalTooltipProvider(const FString& ModReference, UObject* ItemTooltipProvider) {
     if (ItemTooltipProvider->Implements<USMLItemTooltipProvider>()) {
         GlobalTooltipProviders.AddUnique(ItemTooltipProvider);
+        if (!ISMLItemTooltipProvider::Execute_IsDescriptionStateIndependent(ItemTooltipProvider)) {
+            bAnyProviderStateDependent = true;
+        }
+        //Cached descriptions do not include text of the new provider
+        InvalidateDescriptionCache();
     }
 }
 
+void UItemTooltipSubsystem::InvalidateDescriptionCache() {
+    DescriptionCache.Empty();
+}
+
 FText UItemTooltipSubsystem::GetItemName(APlayerController* OwningPlayer, const FInventoryStack& InventoryStack) {
     UClass* ItemClass = InventoryStack.Item.ItemClass;
     if (ItemClass != NULL) {
@@ -96,7 +115,58 @@ FText UItemTooltipSubsystem::GetItemName(APlayerController* OwningPlayer, const
     return UFGItemDescriptor::GetItemName(ItemClass);
 }
 
+bool UItemTooltipSubsystem::ComputeItemStateHash(const FInventoryStack& InventoryStack, uint32& OutStateHash) {
+    uint32 StateHash = GetTypeHash(InventoryStack.NumItems);
+    AActor* ItemState = InventoryStack.Item.ItemState.Get();
+    
+    if (ItemState != NULL) {
+        UClass* StateClass = ItemState->GetClass();
+        StateHash = HashCombine(StateHash, GetTypeHash(StateClass));
+        //Mutable item state is kept in the SaveGame properties of the state actor, since that is what the game persists
+        for (TFieldIterator<FProperty> It(StateClass); It; ++It) {
+            FProperty* Property = *It;
+            if (!Property->HasAnyPropertyFlags(CPF_SaveGame)) {
+                continue;
+            }
+            if (!Property->HasAnyPropertyFlags(CPF_HasGetValueTypeHash)) {
+                return false;
+            }
+            for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++) {
+                StateHash = HashCombine(StateHash, Property->GetValueTypeHash(Property->ContainerPtrToValuePtr<void>(ItemState, ArrayIndex)));
+            }
+        }
+    }
+    OutStateHash = StateHash;
+    return true;
+}
+
 FText UItemTooltipSubsystem::GetItemDescription(APlayerController* OwningPlayer, const FInventoryStack& InventoryStack) {
+    UClass* ItemClass = InventoryStack.Item.ItemClass;
+    FItemDescriptionCacheKey CacheKey{FObjectKey(ItemClass), FObjectKey(), 0};
+    
+    //Item display interface receives stack too, so it is always considered state dependent
+    const bool bItemStateDependent = ItemClass != NULL && ItemClass->ImplementsInterface(USMLItemDisplayInterface::StaticClass());
+    if (bAnyProviderStateDependent || bItemStateDependent) {
+        //State which cannot be hashed cannot be tracked by the cache, so such descriptions are composed every time
+        if (!ComputeItemStateHash(InventoryStack, CacheKey.StateHash)) {
+            return ComposeItemDescription(OwningPlayer, InventoryStack);
+        }
+        CacheKey.OwningPlayer = FObjectKey(OwningPlayer);
+    }
+    
+    const FText* CachedDescription = DescriptionCache.Find(CacheKey);
+    if (CachedDescription != NULL) {
+        return *CachedDescription;
+    }
+    if (DescriptionCache.Num() >= MaxCachedDescriptions) {
+        DescriptionCache.Empty();
+    }
+    const FText ItemDescription = ComposeItemDescription(OwningPlayer, InventoryStack);
+    DescriptionCache.Add(CacheKey, ItemDescription);
+    return ItemDescription;
+}
+
+FText UItemTooltipSubsystem::ComposeItemDescription(APlayerController* OwningPlayer, const FInventoryStack& InventoryStack) {
     UClass* ItemClass = InventoryStack.Item.ItemClass;
     TArray<FString> DescriptionText;
 
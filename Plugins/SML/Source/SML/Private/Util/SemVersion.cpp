@@ -1,29 +1,7 @@
 #pragma once
 #include "Util/SemVersion.h"
-#include <regex>
-
-//Use stdlib regex here because UE Regex(which is ICU regex wrapper) requires initialized localization system, and our versioning can be called much earlier than that
-std::wregex VersionRegex(TEXT("^(~|v|=|<=|<|>|>=|\\^)?(X|x|\\*|0|[1-9]\\d*)(?:\\.(X|x|\\*|0|[1-9]\\d*)(?:\\.(X|x|\\*|0|[1-9]\\d*)(?:-((?:0|[1-9]\\d*|\\d*[a-zA-Z-][0-9a-zA-Z-]*)(?:\\.(?:0|[1-9]\\d*|\\d*[a-zA-Z-][0-9a-zA-Z-]*))*))?(?:\\+([0-9a-zA-Z-]+(?:\\.[0-9a-zA-Z-]+)*))?)?)?$"), std::regex::ECMAScript | std::regex::optimize);
-
-FString ParseVersionTemplate(const FString& string, FVersion& version, EVersionComparisonOp& Comparison);
-
-EVersionComparisonOp ParseComparisonOp(const FString& type) {
-	if (type == TEXT("<="))
-		return EVersionComparisonOp::LESS_EQUALS;
-	if (type == TEXT("<"))
-		return EVersionComparisonOp::LESS;
-	if (type == TEXT(">="))
-		return EVersionComparisonOp::GREATER_EQUALS;
-	if (type == TEXT(">"))
-		return EVersionComparisonOp::GREATER;
-	if (type == TEXT("^"))
-		return EVersionComparisonOp::CARET;
-	if (type == TEXT("~"))
-		return EVersionComparisonOp::TILDE;
-	if (type == TEXT("=") || type == TEXT("v") || type == TEXT(""))
-		return EVersionComparisonOp::EQUALS;
-	return EVersionComparisonOp::INVALID;
-}
+
+FString ParseVersionTemplate(const TCHAR* String, int32 Length, FVersion& version, EVersionComparisonOp& Comparison);
 
 const TCHAR* ComparisonString(const EVersionComparisonOp op) {
 	switch (op) {
@@ -45,7 +23,7 @@ FVersion::FVersion(int64 MyMajor, int64 MyMinor, int64 MyPatch) : Major(MyMajor)
 bool FVersion::ParseVersion(const FString& String, FString& OutErrorMessage) {
 	FVersion ResultVersion{};
 	EVersionComparisonOp ComparisonOp = EVersionComparisonOp::EQUALS;
-	FString ErrorMessage = ParseVersionTemplate(String, ResultVersion, ComparisonOp);
+	FString ErrorMessage = ParseVersionTemplate(*String, String.Len(), ResultVersion, ComparisonOp);
 	if (ErrorMessage.IsEmpty()) {
 		if (ComparisonOp != EVersionComparisonOp::EQUALS) {
 			ErrorMessage = TEXT("Unexpected version comparator");
@@ -96,10 +74,10 @@ FVersionComparator::FVersionComparator() : Op(EVersionComparisonOp::EQUALS) {}
 
 FVersionComparator::FVersionComparator(EVersionComparisonOp Operator, FVersion Version) : Op(Operator), MyVersion(Version) {}
 
-bool FVersionComparator::ParseVersionComparator(const FString& String, FString& OutErrorMessage) {
+bool ParseVersionComparatorString(const TCHAR* String, int32 Length, FVersionComparator& OutComparator, FString& OutErrorMessage) {
 	FVersion ResultVersion{};
 	EVersionComparisonOp ComparisonOp = EVersionComparisonOp::EQUALS;
-	FString ErrorMessage = ParseVersionTemplate(String, ResultVersion, ComparisonOp);
+	FString ErrorMessage = ParseVersionTemplate(String, Length, ResultVersion, ComparisonOp);
 	if (ErrorMessage.IsEmpty()) {
 		if (ComparisonOp == EVersionComparisonOp::EQUALS || ComparisonOp == EVersionComparisonOp::CARET) {
 			//Replace all unspecified version characters with wildcard
@@ -122,14 +100,83 @@ bool FVersionComparator::ParseVersionComparator(const FString& String, FString&
 	}
 	//If failure reason is empty, set version and operator
 	if (ErrorMessage.IsEmpty()) {
-		this->MyVersion = ResultVersion;
-		this->Op = ComparisonOp;
+		OutComparator.MyVersion = ResultVersion;
+		OutComparator.Op = ComparisonOp;
 		return true;
 	}
 	OutErrorMessage = ErrorMessage;
 	return false;
 }
 
+bool FVersionComparator::ParseVersionComparator(const FString& String, FString& OutErrorMessage) {
+	return ParseVersionComparatorString(*String, String.Len(), *this, OutErrorMessage);
+}
+
+//Computes exclusive upper bound of the caret (^) or tilde (~) comparator. Returns false if comparator has no upper bound
+bool GetComparatorExclusiveUpperBound(const FVersionComparator& Comparator, FVersion& MaxVersion) {
+	const FVersion& MyVersion = Comparator.MyVersion;
+	MaxVersion = FVersion{};
+	
+	//Caret version range can have wildcards and need to handle them
+	if (Comparator.Op == EVersionComparisonOp::CARET) {
+		//Check if we have any wildcards we need to handle
+		if (MyVersion.ContainsSpecialVersionNumbers()) {
+			//If major version is wildcard, there is no upper bound set
+			//Although i'm not sure if ^X is even legal semver comparator
+			if (MyVersion.Major == SEMVER_VERSION_NUMBER_WILDCARD) {
+				return false;
+			}
+			//If minor version is wildcard, upper bound is major + 1
+			if (MyVersion.Minor == SEMVER_VERSION_NUMBER_WILDCARD) {
+				MaxVersion.Major = MyVersion.Major + 1;
+			}
+			//If patch version is wildcard, upper bound is either major or minor, but patch can be any
+			if (MyVersion.Patch == SEMVER_VERSION_NUMBER_WILDCARD) {
+				if (MyVersion.Major == 0) {
+					MaxVersion.Minor = MyVersion.Minor + 1;
+				} else {
+					MaxVersion.Major = MyVersion.Major + 1;
+				}
+			}
+		} else {
+			//No special version numbers, fallback to normal first-non-zero handling
+			if (MyVersion.Major == 0) {
+				if(MyVersion.Minor == 0) {
+					//Minor is zero, allow up to next patch version
+					MaxVersion.Patch = MyVersion.Patch + 1;
+				} else {
+					//Major is zero, allow up to next minor version update
+					MaxVersion.Minor = MyVersion.Minor + 1;
+				}
+			} else {
+				//Major is not zero, allow up to next major version update
+				MaxVersion.Major = MyVersion.Major + 1;
+			}
+		}
+		return true;
+	}
+	
+	//Tilde version ranges can have unspecified numbers, and need to handle them
+	//Major version number is not specified, no upper bounds
+	//Although it's impossible to encounter under normal conditions, let's handle it for sake of completeness
+	if (MyVersion.Major == SEMVER_VERSION_NUMBER_UNSPECIFIED) {
+		return false;
+		//Minor is unspecified, maximum version is Major + 1
+	} else if (MyVersion.Minor == SEMVER_VERSION_NUMBER_UNSPECIFIED) {
+		MaxVersion.Major = MyVersion.Major + 1;
+	//Patch version is unspecified, maximum version is Minor + 1 while keeping normal Major
+	} else if (MyVersion.Patch == SEMVER_VERSION_NUMBER_UNSPECIFIED) {
+		MaxVersion.Major = MyVersion.Major;
+		MaxVersion.Minor = MyVersion.Minor + 1;
+	//Version contains no unspecified numbers, so maximum version is Patch + 1 while keeping Major and Minor
+	} else {
+		MaxVersion.Major = MyVersion.Major;
+		MaxVersion.Minor = MyVersion.Minor;
+		MaxVersion.Patch = MyVersion.Patch + 1;
+	}
+	return true;
+}
+
 bool FVersionComparator::Matches(const FVersion& version) const {
 	//Clear version used for comparison purposes
 	const FVersion CleanVersion = MyVersion.RemoveSpecialNumbers();
@@ -141,74 +188,16 @@ bool FVersionComparator::Matches(const FVersion& version) const {
 		case EVersionComparisonOp::LESS_EQUALS: return Result <= 0;
 		case EVersionComparisonOp::LESS: return Result < 0;
 		
-		//Caret version range can have wildcards and need to handle them
-		case EVersionComparisonOp::CARET: {
-			//Lower bound is zeroed version we represent for caret range
-			if(Result < 0) {
-				return false;
-			}
-			FVersion MaxVersion{};
-			//Check if we have any wildcards we need to handle
-			if (MyVersion.ContainsSpecialVersionNumbers()) {
-				//If major version is wildcard, there is no upper bound set
-				//Although i'm not sure if ^X is even legal semver comparator
-	            if (MyVersion.Major == SEMVER_VERSION_NUMBER_WILDCARD) {
-            		return true;
-	            }
-	            //If minor version is wildcard, upper bound is major + 1
-	            if (MyVersion.Minor == SEMVER_VERSION_NUMBER_WILDCARD) {
-            		MaxVersion.Major = MyVersion.Major + 1;
-	            }
-	            //If patch version is wildcard, upper bound is either major or minor, but patch can be any
-	            if (MyVersion.Patch == SEMVER_VERSION_NUMBER_WILDCARD) {
-            		if (MyVersion.Major == 0) {
-            			MaxVersion.Minor = MyVersion.Minor + 1;
-            		} else {
-            			MaxVersion.Major = MyVersion.Major + 1;
-            		}
-	            }
-			} else {
-				//No special version numbers, fallback to normal first-non-zero handling
-				if (MyVersion.Major == 0) {
-					if(MyVersion.Minor == 0) {
-						//Minor is zero, allow up to next patch version
-						MaxVersion.Patch = MyVersion.Patch + 1;
-					} else {
-						//Major is zero, allow up to next minor version update
-						MaxVersion.Minor = MyVersion.Minor + 1;
-					}
-				} else {
-					//Major is not zero, allow up to next major version update
-					MaxVersion.Major = MyVersion.Major + 1;
-				}
-			}
-			//We pass if we are below max version required, exclusive
-			return version.Compare(MaxVersion) < 0;
-		}
-		
-		//Tilde version ranges can have unspecified numbers, and need to handle them
+		//Caret and tilde version ranges have upper bound depending on the wildcards and unspecified numbers
+		case EVersionComparisonOp::CARET:
 		case EVersionComparisonOp::TILDE: {
-			//Lower bound is zeroed version we represent for tilde version range
+			//Lower bound is zeroed version we represent for caret or tilde range
 			if(Result < 0) {
 				return false;
 			}
-			FVersion MaxVersion{};
-			//Major version number is not specified, no upper bounds
-			//Although it's impossible to encounter under normal conditions, let's handle it for sake of completeness
-			if (MyVersion.Major == SEMVER_VERSION_NUMBER_UNSPECIFIED) {
+			FVersion MaxVersion;
+			if (!GetComparatorExclusiveUpperBound(*this, MaxVersion)) {
 				return true;
-				//Minor is unspecified, maximum version is Major + 1
-			} else if (MyVersion.Minor == SEMVER_VERSION_NUMBER_UNSPECIFIED) {
-				MaxVersion.Major = MyVersion.Major + 1;
-			//Patch version is unspecified, maximum version is Minor + 1 while keeping normal Major
-			} else if (MyVersion.Patch == SEMVER_VERSION_NUMBER_UNSPECIFIED) {
-				MaxVersion.Major = MyVersion.Major;
-				MaxVersion.Minor = MyVersion.Minor + 1;
-			//Version contains no unspecified numbers, so maximum version is Patch + 1 while keeping Major and Minor
-			} else {
-				MaxVersion.Major = MyVersion.Major;
-				MaxVersion.Minor = MyVersion.Minor;
-				MaxVersion.Patch = MyVersion.Patch + 1;
 			}
 			//We pass if we are below max version required, exclusive
 			return version.Compare(MaxVersion) < 0;
@@ -242,9 +231,9 @@ bool FVersionComparator::Matches(const FVersion& version) const {
 
 FVersionComparatorCollection::FVersionComparatorCollection() {}
 
-bool ParseVersionForHyphenRange(const FString& String, FVersion& Version, FString& OutErrorMessage) {
+bool ParseVersionForHyphenRange(const TCHAR* String, int32 Length, FVersion& Version, FString& OutErrorMessage) {
 	EVersionComparisonOp ComparisonOp = EVersionComparisonOp::EQUALS;
-	const FString ParseErrorMessage = ParseVersionTemplate(String, Version, ComparisonOp);
+	const FString ParseErrorMessage = ParseVersionTemplate(String, Length, Version, ComparisonOp);
 	//Basic version parsing failed, pass failure code
 	if (!ParseErrorMessage.IsEmpty()) {
 		OutErrorMessage = ParseErrorMessage;
@@ -266,12 +255,12 @@ bool ParseVersionForHyphenRange(const FString& String, FVersion& Version, FStrin
 	return true;
 }
 
-bool ParseHyphenVersionRange(const FString& LeftSideString, const FString& RightSideString, TArray<FVersionComparator>& OutComparators, FString& OutErrorMessage) {
+bool ParseHyphenVersionRange(const TCHAR* LeftSideString, int32 LeftSideLength, const TCHAR* RightSideString, int32 RightSideLength, TArray<FVersionComparator>& OutComparators, FString& OutErrorMessage) {
 	//Parse version strings according to hyphen version range rules
 	FVersion LeftSideVersion;
-	const bool bSuccessLeft = ParseVersionForHyphenRange(LeftSideString, LeftSideVersion, OutErrorMessage);
+	const bool bSuccessLeft = ParseVersionForHyphenRange(LeftSideString, LeftSideLength, LeftSideVersion, OutErrorMessage);
 	FVersion RightSideVersion;
-	const bool bSuccessRight = ParseVersionForHyphenRange(RightSideString, RightSideVersion, OutErrorMessage);
+	const bool bSuccessRight = ParseVersionForHyphenRange(RightSideString, RightSideLength, RightSideVersion, OutErrorMessage);
 	//Parsing of one of the versions failed
 	if (!bSuccessLeft || !bSuccessRight) {
 		return false;
@@ -309,17 +298,20 @@ bool ParseHyphenVersionRange(const FString& LeftSideString, const FString& Right
 	return true;
 }
 
-bool FVersionComparatorCollection::ParseVersionCollection(const FString& String, FString& OutErrorMessage) {
+//Version strings are tracked as ranges inside of the source string instead of being copied into separate strings
+bool ParseVersionCollectionString(const TCHAR* String, int32 Length, TArray<FVersionComparator>& OutComparators, FString& OutErrorMessage) {
 	//Result comparator list
 	TArray<FVersionComparator> ResultArray;
 	//Keep last matched version string without making comparator out of it for hyphen ranges
-	FString LastMatchedVersionString;
+	int32 LastMatchedVersionStart = 0;
+	int32 LastMatchedVersionLength = 0;
 	//Keep left side string of hyphen range we currently process
-	FString CachedLeftSideHyphenRangeString;
+	int32 CachedLeftSideHyphenRangeStart = 0;
+	int32 CachedLeftSideHyphenRangeLength = 0;
 	int32 CurrentIndex = 0;
 	bool bIsCurrentlyInString = true;
 	bool bHaveHyphenAfterLastString = false;
-	while (CurrentIndex < String.Len()) {
+	while (CurrentIndex < Length) {
 		const TCHAR CurrentChar = String[CurrentIndex++];
 		if (CurrentChar == TEXT(' ')) {
 			//Current character is space. If we're inside string, reset flag
@@ -335,7 +327,7 @@ bool FVersionComparatorCollection::ParseVersionCollection(const FString& String,
 			bHaveHyphenAfterLastString = true;
 			//Last matched string shouldn't be empty, otherwise we have hyphen at the start
 			//If we have cached left side hyphen range, we shouldn't encounter hyphen before we complete it too
-			if (LastMatchedVersionString.IsEmpty() || !CachedLeftSideHyphenRangeString.IsEmpty()) {
+			if (LastMatchedVersionLength == 0 || CachedLeftSideHyphenRangeLength != 0) {
 				OutErrorMessage = TEXT("Unexpected hyphen");
 				return false;
 			}
@@ -344,20 +336,22 @@ bool FVersionComparatorCollection::ParseVersionCollection(const FString& String,
 			if (!bIsCurrentlyInString) {
 				//We are not inside string right now, but it's first character of other string
 				//Skip handling code if last matched string is empty (can happen due to excessive spaces)
-				if (!LastMatchedVersionString.IsEmpty()) {
-					if (!CachedLeftSideHyphenRangeString.IsEmpty()) {
+				if (LastMatchedVersionLength != 0) {
+					if (CachedLeftSideHyphenRangeLength != 0) {
 						//We have cached left side hyphen range string, join it with last string and process as hyphen version range
-						const bool bSuccess = ParseHyphenVersionRange(CachedLeftSideHyphenRangeString, LastMatchedVersionString, ResultArray, OutErrorMessage);
-						CachedLeftSideHyphenRangeString.Empty();
+						const bool bSuccess = ParseHyphenVersionRange(String + CachedLeftSideHyphenRangeStart, CachedLeftSideHyphenRangeLength,
+							String + LastMatchedVersionStart, LastMatchedVersionLength, ResultArray, OutErrorMessage);
+						CachedLeftSideHyphenRangeLength = 0;
 						if (!bSuccess) {
 							return false;
 						}
 					} else if (bHaveHyphenAfterLastString) {
 						//We had hyphen before current string. Cache last string into separate field, and continue normally
-						CachedLeftSideHyphenRangeString = LastMatchedVersionString;
+						CachedLeftSideHyphenRangeStart = LastMatchedVersionStart;
+						CachedLeftSideHyphenRangeLength = LastMatchedVersionLength;
 					} else {
 						FVersionComparator Comparator{};
-						const bool bSuccess = Comparator.ParseVersionComparator(LastMatchedVersionString, OutErrorMessage);
+						const bool bSuccess = ParseVersionComparatorString(String + LastMatchedVersionStart, LastMatchedVersionLength, Comparator, OutErrorMessage);
 						ResultArray.Add(Comparator);
 						if (!bSuccess) {
 							return false;
@@ -365,19 +359,23 @@ bool FVersionComparatorCollection::ParseVersionCollection(const FString& String,
 					}
 				}
 				//Set inString to true, clear last string, and reset hyphen flag now
-				LastMatchedVersionString.Empty();
+				LastMatchedVersionLength = 0;
 				bIsCurrentlyInString = true;
 				bHaveHyphenAfterLastString = false;
 			}
-			LastMatchedVersionString.AppendChar(CurrentChar);
+			//Characters of the string are always contiguous, so appending just extends the range
+			if (LastMatchedVersionLength == 0) {
+				LastMatchedVersionStart = CurrentIndex - 1;
+			}
+			LastMatchedVersionLength++;
 		}
 	}
 	//Process last cached string if it's not empty
-	if (!LastMatchedVersionString.IsEmpty()) {
-		if (!CachedLeftSideHyphenRangeString.IsEmpty()) {
+	if (LastMatchedVersionLength != 0) {
+		if (CachedLeftSideHyphenRangeLength != 0) {
 			//We have cached left side hyphen range string, join it with last string and process as hyphen version range
-			const bool bSuccess = ParseHyphenVersionRange(CachedLeftSideHyphenRangeString, LastMatchedVersionString, ResultArray, OutErrorMessage);
-			CachedLeftSideHyphenRangeString.Empty();
+			const bool bSuccess = ParseHyphenVersionRange(String + CachedLeftSideHyphenRangeStart, CachedLeftSideHyphenRangeLength,
+				String + LastMatchedVersionStart, LastMatchedVersionLength, ResultArray, OutErrorMessage);
 			if (!bSuccess) {
 				return false;
 			}
@@ -388,7 +386,7 @@ bool FVersionComparatorCollection::ParseVersionCollection(const FString& String,
 		} else {
 			//Otherwise it is a normal version comparator
 			FVersionComparator Comparator{};
-			const bool bSuccess = Comparator.ParseVersionComparator(LastMatchedVersionString, OutErrorMessage);
+			const bool bSuccess = ParseVersionComparatorString(String + LastMatchedVersionStart, LastMatchedVersionLength, Comparator, OutErrorMessage);
 			ResultArray.Add(Comparator);
 			if (!bSuccess) {
 				return false;
@@ -401,10 +399,14 @@ bool FVersionComparatorCollection::ParseVersionCollection(const FString& String,
 		OutErrorMessage = TEXT("Version Comparator Collection cannot be empty");
 		return false;
 	}
-	this->Comparators = ResultArray;
+	OutComparators = MoveTemp(ResultArray);
 	return true;
 }
 
+bool FVersionComparatorCollection::ParseVersionCollection(const FString& String, FString& OutErrorMessage) {
+	return ParseVersionCollectionString(*String, String.Len(), Comparators, OutErrorMessage);
+}
+
 FString FVersionComparatorCollection::ToString() const {
 	TArray<FString> ResultString;
 	for (const FVersionComparator& Comparator : Comparators) {
@@ -425,6 +427,126 @@ bool FVersionComparatorCollection::Matches(const FVersion& version) const {
 
 FVersionRange::FVersionRange() {}
 
+//Version numbers are packed into the key from major to patch, so keys are ordered the same way as versions without type
+static constexpr int32 VersionKeyNumberBits = 20;
+static constexpr int64 VersionKeyMaxNumber = (1ll << VersionKeyNumberBits) - 1;
+static constexpr int64 VersionKeyMaxValue = (1ll << (VersionKeyNumberBits * 3)) - 1;
+
+FORCEINLINE bool IsPackableVersionNumber(const int64 Number) {
+	return Number >= 0 && Number <= VersionKeyMaxNumber;
+}
+
+FORCEINLINE int64 PackVersionNumbers(const int64 Major, const int64 Minor, const int64 Patch) {
+	return (Major << (VersionKeyNumberBits * 2)) | (Minor << VersionKeyNumberBits) | Patch;
+}
+
+bool FCompiledVersionRange::PackVersion(const FVersion& Version, uint64& OutVersionKey) {
+	//Pre-release type takes part in version comparison, so such versions cannot be represented by the key
+	if (!Version.Type.IsEmpty() ||
+		!IsPackableVersionNumber(Version.Major) ||
+		!IsPackableVersionNumber(Version.Minor) ||
+		!IsPackableVersionNumber(Version.Patch)) {
+		return false;
+	}
+	OutVersionKey = PackVersionNumbers(Version.Major, Version.Minor, Version.Patch);
+	return true;
+}
+
+//Computes inclusive interval of the version keys matched by the comparator, following FVersionComparator::Matches
+//Resulting interval is empty when lower key is greater than upper one. Returns false if comparator cannot be represented by the interval
+bool CompileVersionComparator(const FVersionComparator& Comparator, int64& OutLowerKey, int64& OutUpperKey) {
+	const FVersion& MyVersion = Comparator.MyVersion;
+	uint64 CleanVersionKey;
+	if (!FCompiledVersionRange::PackVersion(MyVersion.RemoveSpecialNumbers(), CleanVersionKey)) {
+		return false;
+	}
+	const int64 VersionKey = (int64) CleanVersionKey;
+	OutLowerKey = 0;
+	OutUpperKey = VersionKeyMaxValue;
+	
+	switch (Comparator.Op) {
+		case EVersionComparisonOp::GREATER_EQUALS: OutLowerKey = VersionKey; return true;
+		case EVersionComparisonOp::GREATER: OutLowerKey = VersionKey + 1; return true;
+		case EVersionComparisonOp::LESS_EQUALS: OutUpperKey = VersionKey; return true;
+		case EVersionComparisonOp::LESS: OutUpperKey = VersionKey - 1; return true;
+		case EVersionComparisonOp::CARET:
+		case EVersionComparisonOp::TILDE: {
+			OutLowerKey = VersionKey;
+			FVersion MaxVersion;
+			if (GetComparatorExclusiveUpperBound(Comparator, MaxVersion)) {
+				uint64 MaxVersionKey;
+				if (!FCompiledVersionRange::PackVersion(MaxVersion, MaxVersionKey)) {
+					return false;
+				}
+				OutUpperKey = (int64) MaxVersionKey - 1;
+			}
+			return true;
+		}
+		case EVersionComparisonOp::EQUALS: {
+			if (MyVersion.Major == SEMVER_VERSION_NUMBER_WILDCARD) {
+				return true;
+			}
+			if (MyVersion.Minor == SEMVER_VERSION_NUMBER_WILDCARD) {
+				if (!IsPackableVersionNumber(MyVersion.Major)) {
+					return false;
+				}
+				OutLowerKey = PackVersionNumbers(MyVersion.Major, 0, 0);
+				OutUpperKey = PackVersionNumbers(MyVersion.Major, VersionKeyMaxNumber, VersionKeyMaxNumber);
+				return true;
+			}
+			if (MyVersion.Patch == SEMVER_VERSION_NUMBER_WILDCARD) {
+				if (!IsPackableVersionNumber(MyVersion.Major) || !IsPackableVersionNumber(MyVersion.Minor)) {
+					return false;
+				}
+				OutLowerKey = PackVersionNumbers(MyVersion.Major, MyVersion.Minor, 0);
+				OutUpperKey = PackVersionNumbers(MyVersion.Major, MyVersion.Minor, VersionKeyMaxNumber);
+				return true;
+			}
+			OutLowerKey = OutUpperKey = VersionKey;
+			return true;
+		}
+		default: {
+			OutLowerKey = OutUpperKey = VersionKey;
+			return true;
+		}
+	}
+}
+
+TSharedPtr<const FCompiledVersionRange, ESPMode::ThreadSafe> FCompiledVersionRange::Compile(const TArray<FVersionComparatorCollection>& Collections) {
+	TArray<TPair<uint64, uint64>> Intervals;
+	
+	for (const FVersionComparatorCollection& Collection : Collections) {
+		//Comparators inside of the collection are AND-joined, so their intervals are intersected
+		int64 LowerKey = 0;
+		int64 UpperKey = VersionKeyMaxValue;
+		for (const FVersionComparator& Comparator : Collection.Comparators) {
+			int64 ComparatorLowerKey;
+			int64 ComparatorUpperKey;
+			if (!CompileVersionComparator(Comparator, ComparatorLowerKey, ComparatorUpperKey)) {
+				return NULL;
+			}
+			LowerKey = FMath::Max(LowerKey, ComparatorLowerKey);
+			UpperKey = FMath::Min(UpperKey, ComparatorUpperKey);
+		}
+		if (LowerKey <= UpperKey) {
+			Intervals.Add(TPair<uint64, uint64>(LowerKey, UpperKey));
+		}
+	}
+	
+	//Collections are OR-joined, so merge overlapping and adjacent intervals
+	Intervals.Sort([](const TPair<uint64, uint64>& A, const TPair<uint64, uint64>& B) { return A.Key < B.Key; });
+	
+	const TSharedRef<FCompiledVersionRange, ESPMode::ThreadSafe> CompiledRange = MakeShared<FCompiledVersionRange, ESPMode::ThreadSafe>();
+	for (const TPair<uint64, uint64>& Interval : Intervals) {
+		if (CompiledRange->Intervals.Num() && Interval.Key <= CompiledRange->Intervals.Last().Value + 1) {
+			CompiledRange->Intervals.Last().Value = FMath::Max(CompiledRange->Intervals.Last().Value, Interval.Value);
+		} else {
+			CompiledRange->Intervals.Add(Interval);
+		}
+	}
+	return CompiledRange;
+}
+
 FVersionRange FVersionRange::CreateAnyVersionRange() {
 	FVersionRange VersionRange{};
 	FVersionComparatorCollection VersionComparatorCollection{};
@@ -432,6 +554,7 @@ FVersionRange FVersionRange::CreateAnyVersionRange() {
 	const FVersionComparator Comparator(EVersionComparisonOp::EQUALS, AnyVersion);
 	VersionComparatorCollection.Comparators.Add(Comparator);
 	VersionRange.Collections.Add(VersionComparatorCollection);
+	VersionRange.UpdateCompiledRange();
 	return VersionRange;
 }
 
@@ -441,31 +564,112 @@ FVersionRange FVersionRange::CreateRangeWithMinVersion(const FVersion& MinVersio
 	const FVersionComparator Comparator(EVersionComparisonOp::GREATER_EQUALS, MinVersion);
 	VersionComparatorCollection.Comparators.Add(Comparator);
 	VersionRange.Collections.Add(VersionComparatorCollection);
+	VersionRange.UpdateCompiledRange();
 	return VersionRange;
 }
 
-bool FVersionRange::ParseVersionRange(const FString& String, FString& OutErrorMessage) {
+void FVersionRange::UpdateCompiledRange() {
+	CompiledRange = FCompiledVersionRange::Compile(Collections);
+}
+
+bool ParseVersionRangeString(const FString& String, TArray<FVersionComparatorCollection>& OutCollections, FString& OutErrorMessage) {
 	//Just split input string by || and evaluate each piece as individual collection
+	//Empty pieces are skipped, same as FString::ParseIntoArray with culling would do
 	TArray<FVersionComparatorCollection> ResultCollections;
-	TArray<FString> CollectionStrings;
-	String.ParseIntoArray(CollectionStrings, TEXT("||"));
+	const TCHAR* StringData = *String;
+	const int32 StringLength = String.Len();
+	int32 PieceStart = 0;
+	int32 CurrentIndex = 0;
+	
+	while (CurrentIndex <= StringLength) {
+		const bool bIsEndOfString = CurrentIndex == StringLength;
+		if (!bIsEndOfString && !(StringData[CurrentIndex] == TEXT('|') && CurrentIndex + 1 < StringLength && StringData[CurrentIndex + 1] == TEXT('|'))) {
+			CurrentIndex++;
+			continue;
+		}
+		//Evaluate each non-empty piece as collection
+		if (CurrentIndex > PieceStart) {
+			FVersionComparatorCollection& Collection = ResultCollections.AddDefaulted_GetRef();
+			if (!ParseVersionCollectionString(StringData + PieceStart, CurrentIndex - PieceStart, Collection.Comparators, OutErrorMessage)) {
+				return false;
+			}
+		}
+		if (bIsEndOfString) {
+			break;
+		}
+		CurrentIndex += 2;
+		PieceStart = CurrentIndex;
+	}
 	
 	//Version range cannot be empty
-	if (CollectionStrings.Num() == 0) {
+	if (ResultCollections.Num() == 0) {
 		OutErrorMessage = TEXT("Version range cannot be empty");
 		return false;
 	}
+	OutCollections = MoveTemp(ResultCollections);
+	return true;
+}
+
+/** Result of parsing the version range string, shared between all ranges parsed from the same string */
+struct FInternedVersionRange {
+	bool bIsValid;
+	FString ErrorMessage;
+	TArray<FVersionComparatorCollection> Collections;
+	TSharedPtr<const FCompiledVersionRange, ESPMode::ThreadSafe> CompiledRange;
+};
+
+typedef TSharedPtr<const FInternedVersionRange, ESPMode::ThreadSafe> FInternedVersionRangePtr;
+
+//Pre-release types are compared case-sensitively, so range strings differing only in case cannot share the parsing result
+struct FInternedVersionRangeKeyFuncs : BaseKeyFuncs<TPair<FString, FInternedVersionRangePtr>, FString, false> {
+	static FORCEINLINE const FString& GetSetKey(const TPair<FString, FInternedVersionRangePtr>& Element) {
+		return Element.Key;
+	}
+	static FORCEINLINE bool Matches(const FString& A, const FString& B) {
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+	static FORCEINLINE uint32 GetKeyHash(const FString& Key) {
+		return FCrc::StrCrc32(*Key);
+	}
+};
+
+//Same range strings are parsed over and over again for dependencies of different mods, so parsing results are interned
+static FCriticalSection InternedVersionRangesCriticalSection;
+static TMap<FString, FInternedVersionRangePtr, FDefaultSetAllocator, FInternedVersionRangeKeyFuncs> InternedVersionRanges;
+//Range strings normally come from mod descriptors, so the limit is only hit when ranges are parsed from arbitrary input
+static constexpr int32 MaxInternedVersionRanges = 4096;
+
+bool FVersionRange::ParseVersionRange(const FString& String, FString& OutErrorMessage) {
+	FInternedVersionRangePtr InternedRange;
+	{
+		FScopeLock ScopeLock(&InternedVersionRangesCriticalSection);
+		InternedRange = InternedVersionRanges.FindRef(String);
+	}
 	
-	//Evaluate each string as collection
-	for (const FString& CollectionString : CollectionStrings) {
-		FVersionComparatorCollection Collection{};
-		const bool bSuccess = Collection.ParseVersionCollection(CollectionString, OutErrorMessage);
-		ResultCollections.Add(Collection);
-		if (!bSuccess) {
-			return false;
+	if (!InternedRange.IsValid()) {
+		const TSharedRef<FInternedVersionRange, ESPMode::ThreadSafe> NewInternedRange = MakeShared<FInternedVersionRange, ESPMode::ThreadSafe>();
+		NewInternedRange->bIsValid = ParseVersionRangeString(String, NewInternedRange->Collections, NewInternedRange->ErrorMessage);
+		if (NewInternedRange->bIsValid) {
+			NewInternedRange->CompiledRange = FCompiledVersionRange::Compile(NewInternedRange->Collections);
 		}
+		//Another thread could have interned the same string in the meantime, in that case use the existing result
+		FScopeLock ScopeLock(&InternedVersionRangesCriticalSection);
+		if (const FInternedVersionRangePtr* ExistingRange = InternedVersionRanges.Find(String)) {
+			InternedRange = *ExistingRange;
+		} else {
+			if (InternedVersionRanges.Num() < MaxInternedVersionRanges) {
+				InternedVersionRanges.Add(String, NewInternedRange);
+			}
+			InternedRange = NewInternedRange;
+		}
+	}
+	
+	if (!InternedRange->bIsValid) {
+		OutErrorMessage = InternedRange->ErrorMessage;
+		return false;
 	}
-	this->Collections = ResultCollections;
+	this->Collections = InternedRange->Collections;
+	this->CompiledRange = InternedRange->CompiledRange;
 	return true;
 }
 
@@ -479,6 +683,11 @@ FString FVersionRange::ToString() const {
 }
 
 bool FVersionRange::Matches(const FVersion& Version) const {
+	//Use compiled intervals when both range and version can be represented by them
+	uint64 VersionKey;
+	if (CompiledRange.IsValid() && FCompiledVersionRange::PackVersion(Version, VersionKey)) {
+		return CompiledRange->Matches(VersionKey);
+	}
 	//Either of collections should match for range to match
 	for (const FVersionComparatorCollection& CollectionElement : Collections) {
 		if (CollectionElement.Matches(Version)) {
@@ -489,36 +698,155 @@ bool FVersionRange::Matches(const FVersion& Version) const {
 	return false;
 }
 
-bool IsWildcardVersionNumber(const std::wstring& Number) {
-	return Number == TEXT("X") || Number == TEXT("x") || Number == TEXT("*");
+//Version template grammar, parsed by hand in a single pass instead of using regex, because it runs for every dependency
+//of every mod during verification and during network handshakes:
+//  [~|v|=|<=|<|>|>=|^] NUMBER [.NUMBER [.NUMBER [-PRERELEASE] [+BUILD]]]
+//NUMBER is X, x, * or decimal number without leading zeros
+//PRERELEASE is dot-separated identifiers made of [0-9a-zA-Z-], purely numeric ones cannot have leading zeros
+//BUILD is dot-separated non-empty identifiers made of [0-9a-zA-Z-]
+
+FORCEINLINE bool IsVersionDigitChar(const TCHAR Char) {
+	return Char >= TEXT('0') && Char <= TEXT('9');
+}
+
+FORCEINLINE bool IsVersionIdentifierChar(const TCHAR Char) {
+	return IsVersionDigitChar(Char) ||
+		(Char >= TEXT('a') && Char <= TEXT('z')) ||
+		(Char >= TEXT('A') && Char <= TEXT('Z')) ||
+		Char == TEXT('-');
 }
 
-//Parses version number, taking care of wildcard characters and empty string
-int64 ParseVersionNumber(const std::wstring& Number) {
-	if (IsWildcardVersionNumber(Number)) {
-		return SEMVER_VERSION_NUMBER_WILDCARD;
+//Parses version number starting at the given index, taking care of wildcard characters
+//Returns false if there is no version number at the index. Leading zeros are left for the caller to reject
+bool ParseVersionNumber(const TCHAR* String, int32 Length, int32& Index, int64& OutNumber, bool& bOutNumberTooLarge) {
+	if (Index >= Length) {
+		return false;
 	}
-	if (Number == TEXT("")) {
-		return SEMVER_VERSION_NUMBER_UNSPECIFIED;
+	const TCHAR FirstChar = String[Index];
+	if (FirstChar == TEXT('X') || FirstChar == TEXT('x') || FirstChar == TEXT('*')) {
+		Index++;
+		OutNumber = SEMVER_VERSION_NUMBER_WILDCARD;
+		return true;
+	}
+	if (FirstChar == TEXT('0')) {
+		Index++;
+		OutNumber = 0;
+		return true;
+	}
+	if (!IsVersionDigitChar(FirstChar)) {
+		return false;
+	}
+	int64 ResultNumber = 0;
+	while (Index < Length && IsVersionDigitChar(String[Index])) {
+		ResultNumber = ResultNumber * 10 + (String[Index++] - TEXT('0'));
+		//Version numbers were always limited to 32-bit unsigned integers
+		if (ResultNumber > MAX_uint32) {
+			bOutNumberTooLarge = true;
+			ResultNumber = MAX_uint32;
+		}
+	}
+	OutNumber = ResultNumber;
+	return true;
+}
+
+//Skips identifier made of [0-9a-zA-Z-] characters. Returns false if identifier is empty or is numeric with leading zeros when it is not allowed
+bool SkipVersionIdentifier(const TCHAR* String, int32 Length, int32& Index, bool bAllowNumericLeadingZeros) {
+	const int32 IdentifierStart = Index;
+	bool bIsNumericIdentifier = true;
+	while (Index < Length && IsVersionIdentifierChar(String[Index])) {
+		bIsNumericIdentifier &= IsVersionDigitChar(String[Index]);
+		Index++;
+	}
+	const int32 IdentifierLength = Index - IdentifierStart;
+	if (IdentifierLength == 0) {
+		return false;
+	}
+	if (!bAllowNumericLeadingZeros && bIsNumericIdentifier && IdentifierLength > 1 && String[IdentifierStart] == TEXT('0')) {
+		return false;
+	}
+	return true;
+}
+
+//Skips dot-separated identifier list. Returns false if any of the identifiers is invalid
+bool SkipVersionIdentifierList(const TCHAR* String, int32 Length, int32& Index, bool bAllowNumericLeadingZeros) {
+	while (true) {
+		if (!SkipVersionIdentifier(String, Length, Index, bAllowNumericLeadingZeros)) {
+			return false;
+		}
+		if (Index >= Length || String[Index] != TEXT('.')) {
+			return true;
+		}
+		Index++;
 	}
-	return std::stoul(Number);
 }
 
-FString ParseVersionTemplate(const FString& string, FVersion& version, EVersionComparisonOp& Comparison) {
-	std::wsmatch Match;
-	const std::wstring WideString(*string);
-	if (!std::regex_match(WideString, Match, VersionRegex)) {
+EVersionComparisonOp ParseComparisonOp(const TCHAR* String, int32 Length, int32& Index) {
+	if (Length == 0) {
+		return EVersionComparisonOp::EQUALS;
+	}
+	const bool bFollowedByEquals = Length > 1 && String[1] == TEXT('=');
+	switch (String[0]) {
+		case TEXT('~'): Index = 1; return EVersionComparisonOp::TILDE;
+		case TEXT('^'): Index = 1; return EVersionComparisonOp::CARET;
+		case TEXT('v'):
+		case TEXT('='): Index = 1; return EVersionComparisonOp::EQUALS;
+		case TEXT('<'): Index = bFollowedByEquals ? 2 : 1; return bFollowedByEquals ? EVersionComparisonOp::LESS_EQUALS : EVersionComparisonOp::LESS;
+		case TEXT('>'): Index = bFollowedByEquals ? 2 : 1; return bFollowedByEquals ? EVersionComparisonOp::GREATER_EQUALS : EVersionComparisonOp::GREATER;
+		default: return EVersionComparisonOp::EQUALS;
+	}
+}
+
+FString ParseVersionTemplate(const TCHAR* String, int32 Length, FVersion& version, EVersionComparisonOp& Comparison) {
+	int32 Index = 0;
+	bool bNumberTooLarge = false;
+	Comparison = ParseComparisonOp(String, Length, Index);
+
+	version.Major = SEMVER_VERSION_NUMBER_UNSPECIFIED;
+	version.Minor = SEMVER_VERSION_NUMBER_UNSPECIFIED;
+	version.Patch = SEMVER_VERSION_NUMBER_UNSPECIFIED;
+	int32 TypeStart = 0;
+	int32 TypeLength = 0;
+	int32 BuildInfoStart = 0;
+	int32 BuildInfoLength = 0;
+
+	if (!ParseVersionNumber(String, Length, Index, version.Major, bNumberTooLarge)) {
 		return TEXT("Version doesn't match SemVer pattern");
 	}
-	const std::wstring& FirstMatch = Match[1];
-	Comparison = ParseComparisonOp(FirstMatch.c_str());
-	
-	if (Comparison == EVersionComparisonOp::INVALID) {
-		return TEXT("Invalid version comparator");
+	if (Index < Length && String[Index] == TEXT('.')) {
+		Index++;
+		if (!ParseVersionNumber(String, Length, Index, version.Minor, bNumberTooLarge)) {
+			return TEXT("Version doesn't match SemVer pattern");
+		}
+		if (Index < Length && String[Index] == TEXT('.')) {
+			Index++;
+			if (!ParseVersionNumber(String, Length, Index, version.Patch, bNumberTooLarge)) {
+				return TEXT("Version doesn't match SemVer pattern");
+			}
+			//Pre-release type and build info are only allowed after complete version
+			if (Index < Length && String[Index] == TEXT('-')) {
+				TypeStart = ++Index;
+				if (!SkipVersionIdentifierList(String, Length, Index, false)) {
+					return TEXT("Version doesn't match SemVer pattern");
+				}
+				TypeLength = Index - TypeStart;
+			}
+			if (Index < Length && String[Index] == TEXT('+')) {
+				BuildInfoStart = ++Index;
+				if (!SkipVersionIdentifierList(String, Length, Index, true)) {
+					return TEXT("Version doesn't match SemVer pattern");
+				}
+				BuildInfoLength = Index - BuildInfoStart;
+			}
+		}
+	}
+	//Anything left means the version is malformed, including numbers with leading zeros
+	if (Index != Length) {
+		return TEXT("Version doesn't match SemVer pattern");
 	}
-	version.Major = ParseVersionNumber(Match[2]);
-	version.Minor = ParseVersionNumber(Match[3]);
-	version.Patch = ParseVersionNumber(Match[4]);
+	if (bNumberTooLarge) {
+		return TEXT("Version number is too large");
+	}
+	
 	//Make sure patch is always not specified or wildcard if major/minor are wildcard
 	if (version.Major == SEMVER_VERSION_NUMBER_WILDCARD || version.Minor == SEMVER_VERSION_NUMBER_WILDCARD) {
 		if (version.Patch != SEMVER_VERSION_NUMBER_WILDCARD &&
@@ -533,8 +861,8 @@ FString ParseVersionTemplate(const FString& string, FVersion& version, EVersionC
 			return TEXT("Wildcard cannot be followed by version number");
         }
 	}
-	version.Type = Match[5].str().c_str();
-	version.BuildInfo = Match[6].str().c_str();
+	version.Type = TypeLength ? FString(TypeLength, String + TypeStart) : FString();
+	version.BuildInfo = BuildInfoLength ? FString(BuildInfoLength, String + BuildInfoStart) : FString();
 	return TEXT("");
 }
 
@@ -575,3 +903,17 @@ int FVersion::Compare(const FVersion& other) const {
 		return Patch > other.Patch ? 1 : -1;
 	return Type.Compare(other.Type);
 }
+
+bool FVersion::operator==(const FVersion& Other) const {
+	return Major == Other.Major && Minor == Other.Minor && Patch == Other.Patch &&
+		Type.Equals(Other.Type, ESearchCase::CaseSensitive) &&
+		BuildInfo.Equals(Other.BuildInfo, ESearchCase::CaseSensitive);
+}
+
+bool FVersionComparator::operator==(const FVersionComparator& Other) const {
+	return Op == Other.Op && MyVersion == Other.MyVersion;
+}
+
+bool FVersionComparatorCollection::operator==(const FVersionComparatorCollection& Other) const {
+	return Comparators == Other.Comparators;
+}
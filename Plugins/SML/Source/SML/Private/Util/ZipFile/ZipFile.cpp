@@ -3,6 +3,10 @@
 #include "Misc/FileHelper.h"
 #include "miniz.h"
 #include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/Paths.h"
 
 #define ZipArchive static_cast<mz_zip_archive*>(ZipArchiveHandle)
 
@@ -38,46 +42,124 @@ size_t ExtractZipArchiveFunc(void *Opaque, mz_uint64 FileOffset, const void* Wri
 	return Result ? WriteAmount : 0;
 }
 
-FZipFile::FZipFile(TUniquePtr<IFileHandle> Handle) : FileHandle(std::move(Handle)), InitSuccess(false) {
-	const SIZE_T ZipStructSize = sizeof(mz_zip_archive);
-	this->ZipArchiveHandle = FMemory::Malloc(ZipStructSize);
-	FMemory::Memzero(ZipArchiveHandle, ZipStructSize);
+//Zip local file header is followed by the file name and extra field, and then by the file data
+static constexpr uint32 ZIP_LOCAL_HEADER_SIGNATURE = 0x04034b50;
+static constexpr uint64 ZIP_LOCAL_HEADER_SIZE = 30;
+static constexpr uint64 ZIP_LOCAL_HEADER_FILE_NAME_LENGTH_OFFSET = 26;
+static constexpr uint64 ZIP_LOCAL_HEADER_EXTRA_LENGTH_OFFSET = 28;
 
+static FORCEINLINE uint32 ReadZipUInt16(const uint8* Data) {
+	return Data[0] | (Data[1] << 8);
+}
+
+static FORCEINLINE uint32 ReadZipUInt32(const uint8* Data) {
+	return Data[0] | (Data[1] << 8) | (Data[2] << 16) | (static_cast<uint32>(Data[3]) << 24);
+}
+
+FZipFile::FZipFile(TUniquePtr<IFileHandle> Handle) : FileHandle(std::move(Handle)), InitSuccess(false) {
+	AllocateZipArchive();
 	ZipArchive->m_pIO_opaque = FileHandle.Get();
 	ZipArchive->m_pRead = &ReadZipArchiveFunc;
 }
 
+FZipFile::FZipFile(TUniquePtr<IMappedFileHandle> MappedHandle, TUniquePtr<IMappedFileRegion> MappedRegion) :
+	MappedFileHandle(std::move(MappedHandle)), MappedFileRegion(std::move(MappedRegion)), InitSuccess(false) {
+	//IO callbacks are setup by miniz itself when archive is initialized from memory
+	AllocateZipArchive();
+}
+
 FZipFile::~FZipFile() {
 	if (InitSuccess) {
 		mz_zip_reader_end(ZipArchive);
 	}
 	FMemory::Free(this->ZipArchiveHandle);
 	this->ZipArchiveHandle = NULL;
+	//Region has to be unmapped before the file handle is closed
+	MappedFileRegion.Reset();
+	MappedFileHandle.Reset();
+}
+
+void FZipFile::AllocateZipArchive() {
+	const SIZE_T ZipStructSize = sizeof(mz_zip_archive);
+	this->ZipArchiveHandle = FMemory::Malloc(ZipStructSize);
+	FMemory::Memzero(ZipArchiveHandle, ZipStructSize);
 }
 
 bool FZipFile::InitArchive() {
-	InitSuccess = static_cast<bool>(mz_zip_reader_init(ZipArchive, FileHandle->Size(), 0));
+	if (IsMemoryMapped()) {
+		InitSuccess = static_cast<bool>(mz_zip_reader_init_mem(ZipArchive, MappedFileRegion->GetMappedPtr(), MappedFileRegion->GetMappedSize(), 0));
+	} else {
+		InitSuccess = static_cast<bool>(mz_zip_reader_init(ZipArchive, FileHandle->Size(), 0));
+	}
+	if (InitSuccess) {
+		BuildCentralDirectoryIndex();
+	}
 	return InitSuccess;
 }
 
-uint32 FZipFile::ComputeFileIndex(const ANSICHAR* FileName) const {
-	uint32 ResultFileIndex;
-	const bool Result = static_cast<bool>(mz_zip_reader_locate_file_v2(ZipArchive, FileName, NULL, 0, &ResultFileIndex));
-	return Result ? ResultFileIndex : ZIP_NO_FILE_INDEX;
+static FString GetZipEntryFileName(mz_zip_archive* ZipArchiveHandle, uint32 FileIndex, TArray<ANSICHAR>& FileNameBuffer) {
+	//Returned length includes null terminator, make sure the buffer can fit the whole name
+	const uint32 FileNameLength = mz_zip_reader_get_filename(ZipArchiveHandle, FileIndex, NULL, 0);
+	if (FileNameLength == 0) {
+		return FString();
+	}
+	if (FileNameLength > static_cast<uint32>(FileNameBuffer.Num())) {
+		FileNameBuffer.SetNumUninitialized(FileNameLength);
+	}
+	mz_zip_reader_get_filename(ZipArchiveHandle, FileIndex, FileNameBuffer.GetData(), FileNameBuffer.Num());
+	return UTF8_TO_TCHAR(FileNameBuffer.GetData());
 }
+
+void FZipFile::BuildCentralDirectoryIndex() {
+	const uint32 NumFiles = mz_zip_reader_get_num_files(ZipArchive);
+	FileNameToIndex.Empty(NumFiles);
 	
-uint32 FZipFile::LocateFileIndex(const FString& FilePath) {
-	uint32* ExistingIndex = FileNameToIndex.Find(FilePath);
-	if (ExistingIndex)
-		return *ExistingIndex;
-	const uint32 NewIndex = ComputeFileIndex(TCHAR_TO_ANSI(*FilePath));
-	FileNameToIndex.Add(FilePath, NewIndex);
-	return NewIndex;
+	TArray<ANSICHAR> FileNameBuffer;
+	FileNameBuffer.SetNumUninitialized(MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE);
+	
+	for (uint32 FileIndex = 0; FileIndex < NumFiles; FileIndex++) {
+		const FString FileName = GetZipEntryFileName(ZipArchive, FileIndex, FileNameBuffer);
+		//Keep the first entry for duplicate names, FString keys are case insensitive just like miniz lookups were
+		if (!FileName.IsEmpty() && !FileNameToIndex.Contains(FileName)) {
+			FileNameToIndex.Add(FileName, FileIndex);
+		}
+	}
 }
 
-bool FZipFile::FileExists(const FString& FilePath) {
+uint32 FZipFile::LocateFileIndex(const FString& FilePath) const {
+	const uint32* ExistingIndex = FileNameToIndex.Find(FilePath);
+	return ExistingIndex ? *ExistingIndex : ZIP_NO_FILE_INDEX;
+}
+
+bool FZipFile::FileExists(const FString& FilePath) const {
 	return LocateFileIndex(FilePath) != ZIP_NO_FILE_INDEX;
 }
+
+bool FZipFile::GetStoredFileView(const FString& FilePath, TArrayView<const uint8>& OutFileData) const {
+	const uint32 FileIndex = LocateFileIndex(FilePath);
+	if (FileIndex == ZIP_NO_FILE_INDEX || !IsMemoryMapped())
+		return false;
+	mz_zip_archive_file_stat FileStat;
+	if (!mz_zip_reader_file_stat(ZipArchive, FileIndex, &FileStat))
+		return false;
+	//Only uncompressed and unencrypted files can be viewed directly
+	if (FileStat.m_method != 0 || FileStat.m_is_encrypted || FileStat.m_comp_size != FileStat.m_uncomp_size)
+		return false;
+
+	const uint8* ArchiveData = MappedFileRegion->GetMappedPtr();
+	const uint64 ArchiveSize = MappedFileRegion->GetMappedSize();
+	const uint64 HeaderOffset = FileStat.m_local_header_ofs;
+	if (HeaderOffset + ZIP_LOCAL_HEADER_SIZE > ArchiveSize || ReadZipUInt32(ArchiveData + HeaderOffset) != ZIP_LOCAL_HEADER_SIGNATURE)
+		return false;
+	
+	const uint64 FileDataOffset = HeaderOffset + ZIP_LOCAL_HEADER_SIZE +
+		ReadZipUInt16(ArchiveData + HeaderOffset + ZIP_LOCAL_HEADER_FILE_NAME_LENGTH_OFFSET) +
+		ReadZipUInt16(ArchiveData + HeaderOffset + ZIP_LOCAL_HEADER_EXTRA_LENGTH_OFFSET);
+	if (FileDataOffset + FileStat.m_uncomp_size > ArchiveSize || FileStat.m_uncomp_size > MAX_int32)
+		return false;
+	OutFileData = TArrayView<const uint8>(ArchiveData + FileDataOffset, static_cast<int32>(FileStat.m_uncomp_size));
+	return true;
+}
 	
 FZipFileStat FZipFile::StatFile(const FString& FilePath) {
 	mz_zip_archive_file_stat FileStat{};
@@ -119,6 +201,146 @@ bool FZipFile::ReadFileToString(const FString& FilePath, FString& OutString) {
 	return Success;
 }
 
+bool FZipFile::CanOpenWorkerArchives() const {
+	return IsMemoryMapped() || !ArchiveFilePath.IsEmpty();
+}
+
+bool FZipFile::OpenWorkerArchive(void* OutWorkerArchive, TUniquePtr<IFileHandle>& OutWorkerFileHandle) const {
+	mz_zip_archive* WorkerArchive = static_cast<mz_zip_archive*>(OutWorkerArchive);
+	FMemory::Memzero(WorkerArchive, sizeof(mz_zip_archive));
+	//Workers only access files by their index, so there is no need to sort central directory again
+	const mz_uint InitFlags = MZ_ZIP_FLAG_DO_NOT_SORT_CENTRAL_DIRECTORY;
+	
+	if (IsMemoryMapped()) {
+		return static_cast<bool>(mz_zip_reader_init_mem(WorkerArchive, MappedFileRegion->GetMappedPtr(), MappedFileRegion->GetMappedSize(), InitFlags));
+	}
+	OutWorkerFileHandle = TUniquePtr<IFileHandle>(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*ArchiveFilePath));
+	if (!OutWorkerFileHandle.IsValid()) {
+		return false;
+	}
+	WorkerArchive->m_pIO_opaque = OutWorkerFileHandle.Get();
+	WorkerArchive->m_pRead = &ReadZipArchiveFunc;
+	return static_cast<bool>(mz_zip_reader_init(WorkerArchive, OutWorkerFileHandle->Size(), InitFlags));
+}
+
+bool FZipFile::ExtractAll(const FString& OutputDirectory, TArray<FZipExtractionError>& OutErrors, bool bForceSingleThread) {
+	struct FExtractedFileEntry {
+		uint32 FileIndex;
+		FString OutputFilePath;
+	};
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	
+	FString BaseDirectory = FPaths::ConvertRelativePathToFull(OutputDirectory);
+	FPaths::NormalizeDirectoryName(BaseDirectory);
+	const FString BaseDirectoryPrefix = BaseDirectory + TEXT("/");
+	
+	const uint32 NumFiles = mz_zip_reader_get_num_files(ZipArchive);
+	TArray<FZipExtractionError> EntryErrors;
+	EntryErrors.SetNum(NumFiles);
+	TArray<FExtractedFileEntry> FileEntries;
+	TSet<FString> CreatedDirectories;
+	//FString keys are case insensitive, so entries differing only in case are treated as duplicates too
+	TSet<FString> ExtractedFilePaths;
+	TArray<ANSICHAR> FileNameBuffer;
+	FileNameBuffer.SetNumUninitialized(MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE);
+
+	//Resolve output paths and create directories serially first, so they are created in the archive order
+	for (uint32 FileIndex = 0; FileIndex < NumFiles; FileIndex++) {
+		FZipExtractionError& EntryError = EntryErrors[FileIndex];
+		EntryError.FilePath = GetZipEntryFileName(ZipArchive, FileIndex, FileNameBuffer);
+
+		FString OutputFilePath = BaseDirectory / EntryError.FilePath;
+		FPaths::NormalizeFilename(OutputFilePath);
+		if (EntryError.FilePath.IsEmpty() || !FPaths::CollapseRelativeDirectories(OutputFilePath) || !OutputFilePath.StartsWith(BaseDirectoryPrefix)) {
+			EntryError.ErrorMessage = TEXT("Entry path is outside of the output directory");
+			continue;
+		}
+
+		const bool bIsDirectory = static_cast<bool>(mz_zip_reader_is_file_a_directory(ZipArchive, FileIndex));
+		//Workers would write entries resolving to the same file concurrently, so only the first one of them is extracted
+		if (!bIsDirectory && ExtractedFilePaths.Contains(OutputFilePath)) {
+			EntryError.ErrorMessage = TEXT("Entry path duplicates path of another entry");
+			continue;
+		}
+		FString DirectoryPath = bIsDirectory ? OutputFilePath : FPaths::GetPath(OutputFilePath);
+		FPaths::NormalizeDirectoryName(DirectoryPath);
+		
+		if (!CreatedDirectories.Contains(DirectoryPath)) {
+			if (!PlatformFile.CreateDirectoryTree(*DirectoryPath)) {
+				EntryError.ErrorMessage = FString::Printf(TEXT("Cannot create directory %s"), *DirectoryPath);
+				continue;
+			}
+			CreatedDirectories.Add(DirectoryPath);
+		}
+		if (!bIsDirectory) {
+			ExtractedFilePaths.Add(OutputFilePath);
+			FileEntries.Add(FExtractedFileEntry{FileIndex, OutputFilePath});
+		}
+	}
+
+	//Entries are handed out to workers one by one, so large and small files get balanced between them automatically
+	FThreadSafeCounter NextFileEntry;
+	const auto ExtractFileEntries = [&](mz_zip_archive* SourceArchive) {
+		for (int32 EntryIndex = NextFileEntry.Increment() - 1; EntryIndex < FileEntries.Num(); EntryIndex = NextFileEntry.Increment() - 1) {
+			const FExtractedFileEntry& FileEntry = FileEntries[EntryIndex];
+			FZipExtractionError& EntryError = EntryErrors[FileEntry.FileIndex];
+			
+			TUniquePtr<IFileHandle> OutputFileHandle = TUniquePtr<IFileHandle>(PlatformFile.OpenWrite(*FileEntry.OutputFilePath));
+			if (!OutputFileHandle.IsValid()) {
+				EntryError.ErrorMessage = FString::Printf(TEXT("Cannot open output file %s"), *FileEntry.OutputFilePath);
+				continue;
+			}
+			const bool bExtracted = static_cast<bool>(mz_zip_reader_extract_to_callback(SourceArchive, FileEntry.FileIndex, &ExtractZipArchiveFunc, OutputFileHandle.Get(), 0));
+			const bool bSuccess = bExtracted && OutputFileHandle->Flush();
+			OutputFileHandle.Reset();
+			
+			if (!bSuccess) {
+				const FString ZipError = bExtracted ? TEXT("cannot write output file") : FString(mz_zip_get_error_string(mz_zip_get_last_error(SourceArchive)));
+				EntryError.ErrorMessage = FString::Printf(TEXT("Failed to extract file (%s)"), *ZipError);
+				PlatformFile.DeleteFile(*FileEntry.OutputFilePath);
+			}
+		}
+	};
+
+	//Every worker needs it's own archive reader, since miniz reader state and file handle cannot be shared between threads
+	const int32 NumWorkers = bForceSingleThread || !CanOpenWorkerArchives() ? 1 :
+		FMath::Min(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, FileEntries.Num());
+	if (NumWorkers > 1) {
+		ParallelFor(NumWorkers, [&](int32 WorkerIndex) {
+			mz_zip_archive WorkerArchive;
+			TUniquePtr<IFileHandle> WorkerFileHandle;
+			if (OpenWorkerArchive(&WorkerArchive, WorkerFileHandle)) {
+				ExtractFileEntries(&WorkerArchive);
+				mz_zip_reader_end(&WorkerArchive);
+			}
+		});
+	}
+	//Extract remaining entries on the calling thread, that covers single threaded extraction and workers failing to open archive
+	ExtractFileEntries(ZipArchive);
+
+	bool bAllExtracted = true;
+	for (FZipExtractionError& EntryError : EntryErrors) {
+		if (!EntryError.ErrorMessage.IsEmpty()) {
+			OutErrors.Add(MoveTemp(EntryError));
+			bAllExtracted = false;
+		}
+	}
+	return bAllExtracted;
+}
+
+TUniquePtr<FArchive> FZipFile::CreateFileReader(const FString& FilePath) {
+	const uint32 FileIndex = LocateFileIndex(FilePath);
+	if (FileIndex == ZIP_NO_FILE_INDEX || !CanOpenWorkerArchives())
+		return nullptr;
+	mz_zip_archive_file_stat FileStat;
+	if (!mz_zip_reader_file_stat(ZipArchive, FileIndex, &FileStat) || FileStat.m_uncomp_size > MAX_int64)
+		return nullptr;
+	TUniquePtr<FZipFileEntryReader> EntryReader = MakeUnique<FZipFileEntryReader>(AsShared(), FileIndex, static_cast<int64>(FileStat.m_uncomp_size), FilePath);
+	if (!EntryReader->Open())
+		return nullptr;
+	return EntryReader;
+}
+
 FString FZipFile::GetLastZipError() const{
 	const mz_zip_error LastErrorNumber = mz_zip_get_last_error(ZipArchive);
 	const char* ErrorString = mz_zip_get_error_string(LastErrorNumber);
@@ -126,12 +348,29 @@ FString FZipFile::GetLastZipError() const{
 }
 
 TSharedPtr<FZipFile> FZipFile::CreateZipArchiveReader(const FString& FilePath, FString& OutErrorMessage) {
-	TUniquePtr<IFileHandle> FileHandle = TUniquePtr<IFileHandle>(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
-	if (FileHandle == nullptr) {
-		OutErrorMessage = FString::Printf(TEXT("Cannot open source file at %s"), *FilePath);
-		return nullptr;
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TSharedPtr<FZipFile> ZipHandle;
+	
+	//Prefer reading archive straight from the memory mapped file, not all platforms support mapping files though
+	TUniquePtr<IMappedFileHandle> MappedFileHandle = TUniquePtr<IMappedFileHandle>(PlatformFile.OpenMapped(*FilePath));
+	if (MappedFileHandle.IsValid() && MappedFileHandle->GetFileSize() > 0) {
+		TUniquePtr<IMappedFileRegion> MappedFileRegion = TUniquePtr<IMappedFileRegion>(MappedFileHandle->MapRegion());
+		if (MappedFileRegion.IsValid()) {
+			ZipHandle = MakeShareable(new FZipFile(std::move(MappedFileHandle), std::move(MappedFileRegion)));
+		}
+	}
+
+	//Fallback to reading archive through the file handle
+	if (!ZipHandle.IsValid()) {
+		TUniquePtr<IFileHandle> FileHandle = TUniquePtr<IFileHandle>(PlatformFile.OpenRead(*FilePath));
+		if (FileHandle == nullptr) {
+			OutErrorMessage = FString::Printf(TEXT("Cannot open source file at %s"), *FilePath);
+			return nullptr;
+		}
+		ZipHandle = MakeShareable(new FZipFile(std::move(FileHandle)));
 	}
-	TSharedRef<FZipFile> ZipHandle = MakeShareable(new FZipFile(std::move(FileHandle)));
+	ZipHandle->ArchiveFilePath = FilePath;
+	
 	if (!ZipHandle->InitArchive()) {
 		const FString LastError = ZipHandle->GetLastZipError();
 		OutErrorMessage = FString::Printf(TEXT("Corrupted zip file (%s)"), *LastError);
@@ -139,3 +378,90 @@ TSharedPtr<FZipFile> FZipFile::CreateZipArchiveReader(const FString& FilePath, F
 	}
 	return ZipHandle;
 }
+
+FZipFileEntryReader::FZipFileEntryReader(TSharedRef<FZipFile> InZipFile, uint32 InFileIndex, int64 InEntrySize, const FString& InEntryName) :
+	ZipFile(InZipFile), bArchiveOpened(false), ExtractIterator(NULL), FileIndex(InFileIndex), Position(0), EntrySize(InEntrySize), EntryName(InEntryName) {
+	const SIZE_T ZipStructSize = sizeof(mz_zip_archive);
+	this->ZipArchiveHandle = FMemory::Malloc(ZipStructSize);
+	FMemory::Memzero(ZipArchiveHandle, ZipStructSize);
+	SetIsLoading(true);
+	SetIsPersistent(true);
+}
+
+FZipFileEntryReader::~FZipFileEntryReader() {
+	ReleaseIterator();
+	if (bArchiveOpened) {
+		mz_zip_reader_end(ZipArchive);
+	}
+	FMemory::Free(this->ZipArchiveHandle);
+	this->ZipArchiveHandle = NULL;
+	//Archive reader has to be closed before the file handle it reads from
+	FileHandle.Reset();
+}
+
+bool FZipFileEntryReader::Open() {
+	ReleaseIterator();
+	//Reader state is not shared with the zip file, so reading does not interfere with any other reads of the same archive
+	if (!bArchiveOpened) {
+		bArchiveOpened = ZipFile->OpenWorkerArchive(ZipArchiveHandle, FileHandle);
+		if (!bArchiveOpened) {
+			return false;
+		}
+	}
+	//Iterator keeps only the fixed size read buffer and inflate dictionary, regardless of the entry size
+	ExtractIterator = mz_zip_reader_extract_iter_new(ZipArchive, FileIndex, 0);
+	Position = 0;
+	return ExtractIterator != NULL;
+}
+
+void FZipFileEntryReader::ReleaseIterator() {
+	if (ExtractIterator != NULL) {
+		mz_zip_reader_extract_iter_free(static_cast<mz_zip_reader_extract_iter_state*>(ExtractIterator));
+		ExtractIterator = NULL;
+	}
+}
+
+void FZipFileEntryReader::Serialize(void* Data, int64 Length) {
+	if (Length <= 0 || IsError()) {
+		return;
+	}
+	if (ExtractIterator == NULL || Position + Length > EntrySize) {
+		SetError();
+		FMemory::Memzero(Data, Length);
+		return;
+	}
+	uint8* OutputData = static_cast<uint8*>(Data);
+	while (Length > 0) {
+		const size_t BytesToRead = static_cast<size_t>(FMath::Min<int64>(Length, MAX_int32));
+		const size_t BytesRead = mz_zip_reader_extract_iter_read(static_cast<mz_zip_reader_extract_iter_state*>(ExtractIterator), OutputData, BytesToRead);
+		if (BytesRead == 0) {
+			SetError();
+			FMemory::Memzero(OutputData, Length);
+			return;
+		}
+		OutputData += BytesRead;
+		Position += BytesRead;
+		Length -= BytesRead;
+	}
+}
+
+void FZipFileEntryReader::Seek(int64 InPos) {
+	if (InPos < 0 || InPos > EntrySize) {
+		SetError();
+		return;
+	}
+	//Deflate streams can only be decoded forward, so going back means starting over
+	if (InPos < Position && !Open()) {
+		SetError();
+		return;
+	}
+	uint8 SkipBuffer[4096];
+	while (Position < InPos && !IsError()) {
+		Serialize(SkipBuffer, FMath::Min<int64>(InPos - Position, sizeof(SkipBuffer)));
+	}
+}
+
+bool FZipFileEntryReader::Close() {
+	ReleaseIterator();
+	return !IsError();
+}
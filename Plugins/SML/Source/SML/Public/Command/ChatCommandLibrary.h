@@ -2,6 +2,7 @@
 #include "CoreMinimal.h"
 #include "FGSubsystem.h"
 #include "command/ChatCommandInstance.h"
+#include "Command/ChatCommandNameTrie.h"
 #include "ChatCommandLibrary.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogChatCommand, Log, Log);
@@ -13,9 +14,8 @@ private:
 	//Array of registered command actors
 	UPROPERTY()
 	TArray<AChatCommandInstance*> RegisteredCommands;
-	//Map to lookup command instances fast
-	UPROPERTY()
-	TMap<FString, AChatCommandInstance*> CommandByNameMap;
+	//Trie over command names and aliases, used for lookup and completion. Commands are kept alive by RegisteredCommands
+	FChatCommandNameTrie CommandNameTrie;
 public:
 	/**
 	 * Retrieves Chat Command Subsystem instance for a given world
@@ -33,6 +33,16 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Utilities|ChatCommand")
 	AChatCommandInstance* FindCommandByName(const FString& Name);
 
+	/**
+	 * Returns names and aliases of registered commands starting with the given prefix, ignoring case
+	 * Command names come before aliases, and short names before mod qualified ones, then shorter names come first
+	 *
+	 * @param Prefix Partially typed command name, without prefix slash
+	 * @param MaxResults Maximum amount of names to return
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities|ChatCommand")
+	TArray<FString> GetCommandCompletions(const FString& Prefix, int32 MaxResults = 10) const;
+
 	/*
 	 * Returns array of all registered commands
 	 */
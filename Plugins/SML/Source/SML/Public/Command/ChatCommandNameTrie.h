@@ -0,0 +1,56 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class AChatCommandInstance;
+
+/**
+ * Case-insensitive prefix trie over chat command names and aliases
+ * Used to dispatch commands by name in time proportional to the name length,
+ * and to complete partially typed command names
+ */
+class SML_API FChatCommandNameTrie {
+public:
+	FChatCommandNameTrie();
+
+	/**
+	 * Adds name pointing to the provided command, replacing command previously registered under the same name
+	 * Rank is used to order completions, names with lower ranks come first
+	 */
+	void Add(const FString& Name, AChatCommandInstance* Command, int32 Rank);
+
+	/** Returns command registered under the provided name, or nullptr if there is none */
+	AChatCommandInstance* Find(const FString& Name) const;
+
+	/**
+	 * Appends up to MaxResults names starting with the provided prefix to the array
+	 * Names are ordered by rank first, then by length, and alphabetically at last
+	 */
+	void FindCompletions(const FString& Prefix, int32 MaxResults, TArray<FString>& OutNames) const;
+
+	/** Removes all registered names */
+	void Empty();
+private:
+	struct FNameEntry {
+		/** Name in the original case, as it was registered */
+		FString Name;
+		AChatCommandInstance* Command;
+		int32 Rank;
+	};
+
+	struct FNode {
+		/** Pairs of case-folded character and child node index, sorted by the character */
+		TArray<TPair<TCHAR, int32>> Children;
+		/** Index of the name ending at this node, or INDEX_NONE */
+		int32 EntryIndex;
+	};
+
+	/** Returns index of the node child for the character, or INDEX_NONE. Sets OutInsertIndex to the position new child should be inserted at */
+	int32 FindChild(int32 NodeIndex, TCHAR Character, int32& OutInsertIndex) const;
+
+	/** Returns index of the node reached by walking the name, or INDEX_NONE if there is no such node */
+	int32 FindNode(const FString& Name) const;
+
+	/** Nodes of the trie, first node is the root */
+	TArray<FNode> Nodes;
+	TArray<FNameEntry> Entries;
+};
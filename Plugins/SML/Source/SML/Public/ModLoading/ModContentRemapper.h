@@ -1,23 +1,61 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Subsystems/EngineSubsystem.h"
+#include "UObject/CoreRedirects.h"
 #include "ModContentRemapper.generated.h"
 
 UCLASS()
 class SML_API UModContentRemapper : public UEngineSubsystem {
 	GENERATED_BODY()
 public:
+	UModContentRemapper();
+
+	/**
+	 * Redirects registered while module lifecycle events are dispatched are batched, and only become active once
+	 * all modules of the current dependency level have processed the event, before modules depending on them receive it
+	 */
 	UFUNCTION(BlueprintCallable)
 	void RegisterPackageRedirect(const FString& OriginalPackage, const FString& NewPackage, bool bMatchSubstring);
 
+	/** Class redirects are batched in the same way as package redirects */
 	UFUNCTION(BlueprintCallable)
 	void RegisterClassRedirect(const FString& OldClassName, const FString& NewClassName);
 
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/**
+	 * Starts collecting registered redirects instead of adding them to the engine one by one,
+	 * since engine rebuilds redirect maps on every addition. Batches can be nested
+	 */
+	void BeginRedirectBatch();
+
+	/** Ends the batch, adding all redirects collected since the outermost BeginRedirectBatch call as a single list */
+	void EndRedirectBatch();
 private:
 	/** List of plugins which already have redirects applied to them */
 	TSet<FString> PluginsAlreadyHandled;
+
+	/** Depth of the currently open redirect batches */
+	int32 RedirectBatchDepth;
+
+	/** Redirects collected by the currently open batch */
+	TArray<FCoreRedirect> PendingRedirects;
 	
-	void OnNewPluginMounted(class IPlugin& Plugin);	
+	void OnNewPluginMounted(class IPlugin& Plugin);
+
+	/** Adds redirect to the engine, or to the pending list if batch is currently open */
+	void AddRedirect(const FCoreRedirect& Redirect, const TCHAR* SourceString);
+
+	/** Checks that targets of the package redirects exist on the background thread, logging the ones that don't */
+	static void ValidateRedirectTargetsAsync(const TArray<FCoreRedirect>& Redirects);
+};
+
+/** Collects content redirects registered during it's lifetime and adds them to the engine as a single list when it goes out of scope */
+class SML_API FScopedContentRedirectBatch {
+public:
+	FScopedContentRedirectBatch();
+	~FScopedContentRedirectBatch();
+private:
+	UModContentRemapper* ContentRemapper;
 };
\ No newline at end of file
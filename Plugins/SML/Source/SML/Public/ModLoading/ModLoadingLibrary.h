@@ -56,6 +56,24 @@ struct SML_API FModInfo {
     FVersionRange RemoteVersionRange;
 };
 
+/**
+ * Immutable snapshot of the loaded mods list
+ * Built once after plugins are mounted and rebuilt only when plugin manager reports new plugins,
+ * so callers can hold a reference to it instead of re-populating mod infos on every request
+ */
+struct SML_API FLoadedModList {
+    /** Information about loaded mods, FactoryGame mod info is always the first entry */
+    TArray<FModInfo> Mods;
+
+    /** Maps mod name to the index of it's info inside of the Mods array */
+    TMap<FString, int32> ModIndicesByName;
+
+    /** Returns information about the mod with the provided name, or NULL if it is not loaded */
+    FORCEINLINE const FModInfo* FindMod(const FString& Name) const {
+        const int32* ModIndex = ModIndicesByName.Find(Name);
+        return ModIndex ? &Mods[*ModIndex] : NULL;
+    }
+};
 
 /** Contains plugin descriptor metadata read and used by SML to provide extra functionality */
 struct SML_API FSMLPluginDescriptorMetadata {
@@ -75,8 +93,8 @@ struct SML_API FSMLPluginDescriptorMetadata {
     /** Setups defaults for metadata from normal plugin descriptor */
     void SetupDefaults(const struct FPluginDescriptor& PluginDescriptor);
 
-    /** Initializes metadata from plugin info object */
-    void Load(const FString& PluginName, const TSharedPtr<FJsonObject> Source);
+    /** Initializes metadata from plugin info object, returns false if any of the version fields failed to parse */
+    bool Load(const FString& PluginName, const TSharedPtr<FJsonObject> Source);
 };
 
 /** Provides access to the mod loading functionality for blueprints and allows accessing loaded mods list in implementation-agnostic manner */
@@ -98,6 +116,12 @@ public:
     UFUNCTION(BlueprintPure, Category = "SML|Mod Loading", meta = (BlueprintThreadSafe))
     bool GetLoadedModInfo(const FString& Name, FModInfo& OutModInfo);
 
+    /**
+     * Returns shared snapshot of the loaded mods list. Prefer it over GetLoadedMods in native code,
+     * because it does not copy mod infos. Snapshot is never modified, a new one is created when mod list changes
+     */
+    TSharedRef<const FLoadedModList, ESPMode::ThreadSafe> GetLoadedModList();
+
     /** Tries to load mod icon and returns pointer to the loaded texture, or FallbackIcon if icon cannot be loaded */
     UFUNCTION(BlueprintCallable, Category = "SML|Mod Loading")
     UTexture2D* LoadModIconTexture(const FString& Name, UTexture2D* FallbackIcon);
@@ -146,11 +170,30 @@ private:
 
     /** Makes sure metadata is loaded for the provided plugin and attempts to load it if it's not */
     void LoadMetadataForPlugin(IPlugin& Plugin);
+
+    /** Rebuilds loaded mod list snapshot from the currently enabled plugins */
+    void RebuildLoadedModList();
+
+    /** Creates new loaded mod list snapshot from the currently enabled plugins. Has to be called with the mod list lock held */
+    TSharedRef<const FLoadedModList, ESPMode::ThreadSafe> BuildLoadedModList();
+
+    /** Writes metadata cache back to the disk if it has been changed */
+    void SaveMetadataCache();
     
     UPROPERTY()
     class UModIconStorage* ModIconStorage;
     
     TMap<FString, FSMLPluginDescriptorMetadata> PluginMetadata;
+
+    /** Cache of the metadata parsed during previous launches. Not used in the editor */
+    TSharedPtr<class FPluginMetadataCache> MetadataCache;
+
+    /**
+     * Current loaded mod list snapshot. Swapped under the lock since it can be requested from any thread
+     * Lock also guards plugin metadata, since snapshot requested before initialization loads it on demand
+     */
+    TSharedPtr<const FLoadedModList, ESPMode::ThreadSafe> LoadedModList;
+    FCriticalSection LoadedModListCriticalSection;
 };
 
 /** Holds mod icons and manages their loading */
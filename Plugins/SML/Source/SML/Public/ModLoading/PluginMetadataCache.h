@@ -0,0 +1,54 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "ModLoading/ModLoadingLibrary.h"
+
+/**
+ * Persistent cache of the SML metadata parsed from plugin descriptors, stored in a compact binary form
+ * Entries are keyed by descriptor file path and validated by descriptor file size and modification time,
+ * falling back to the descriptor contents hash, so only changed descriptors have to be parsed again on startup
+ */
+class SML_API FPluginMetadataCache {
+public:
+	FPluginMetadataCache();
+
+	/** Returns path to the cache file used by the mod loading library */
+	static FString GetDefaultCacheFilePath();
+
+	/** Loads cache from the file. Returns false and leaves cache empty if file is missing, corrupted or has outdated schema */
+	bool LoadFromFile(const FString& CacheFilePath);
+
+	/** Saves entries used by this session into the file, if any of them has changed or any loaded entry has not been used. Unused entries are dropped */
+	bool SaveToFile(const FString& CacheFilePath);
+
+	/** Returns cached metadata if the descriptor file still has the same size and modification time */
+	const FSMLPluginDescriptorMetadata* FindMetadata(const FString& DescriptorPath, const FFileStatData& DescriptorStat);
+
+	/** Returns cached metadata if the descriptor contents hash still matches, updating stored file size and modification time */
+	const FSMLPluginDescriptorMetadata* FindMetadataByHash(const FString& DescriptorPath, const FFileStatData& DescriptorStat, uint64 ContentHash);
+
+	/** Adds freshly parsed metadata into the cache, replacing existing entry for the descriptor */
+	void AddMetadata(const FString& DescriptorPath, const FFileStatData& DescriptorStat, uint64 ContentHash, const FSMLPluginDescriptorMetadata& Metadata);
+
+	/** Computes hash of the descriptor file contents */
+	static uint64 ComputeContentHash(const TArray<uint8>& FileContents);
+private:
+	/** Bump whenever entry layout or metadata parsing rules change, so outdated caches are discarded */
+	static constexpr int32 CacheSchemaVersion = 1;
+	static constexpr uint32 CacheFileMagic = 0x434D4C53;
+
+	struct FCacheEntry {
+		int64 FileSize;
+		FDateTime ModificationTime;
+		uint64 ContentHash;
+		FSMLPluginDescriptorMetadata Metadata;
+		/** Whenever entry has been accessed during this session. Only used entries are saved back */
+		bool bUsedThisSession;
+	};
+
+	static void SerializeEntry(FArchive& Ar, FString& DescriptorPath, FCacheEntry& Entry);
+
+	TMap<FString, FCacheEntry> Entries;
+	/** Whenever entries have been changed since the cache has been loaded */
+	bool bIsDirty;
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Module/ModModule.h"
+#include "ModLoading/ModContentRemapper.h"
+#include "Templates/Function.h"
 
 /** Describes a single discovered mod root module associated with it's owner plugin name */
 struct SML_API FDiscoveredModule {
@@ -15,4 +17,35 @@ public:
 
 	/** Determines whenever we want to load modules for the provided world. Generally, we want to load modules only for standalone and PIE worlds */
 	static bool ShouldLoadModulesForWorld(UWorld* World);
+
+	/**
+	 * Sorts discovered modules by the dependency level of their owner plugins, so modules of the plugin dependencies always come first
+	 * Modules of each level only depend on modules of the previous levels, and keep their discovery order inside of the level
+	 *
+	 * @param Modules modules to sort in place
+	 * @param OutLevelOffsets index of the first module of each dependency level in the sorted array
+	 */
+	static void SortModulesByDependencyLevel(TArray<FDiscoveredModule>& Modules, TArray<int32>& OutLevelOffsets);
+
+	/** Same as above, but retrieves direct dependencies of the plugins through the provided function instead of the plugin manager */
+	static void SortModulesByDependencyLevel(TArray<FDiscoveredModule>& Modules, TArray<int32>& OutLevelOffsets, TFunctionRef<TArray<FString>(const FString& PluginName)> GetPluginDependencies);
+
+	/**
+	 * Dispatches lifecycle event to the root modules sorted by SortModulesByDependencyLevel, one dependency level at a time
+	 * Content redirects registered by the modules of the level are added to the engine as a single batch once the whole level
+	 * has processed the event, so they are always active by the time modules of the dependent plugins receive it
+	 */
+	template<typename T>
+	static void DispatchLifecycleEventByLevel(const TArray<T*>& RootModules, const TArray<int32>& LevelOffsets, ELifecyclePhase Phase) {
+		check(IsInGameThread());
+		for (int32 LevelIndex = 0; LevelIndex < LevelOffsets.Num(); LevelIndex++) {
+			const int32 LevelStart = LevelOffsets[LevelIndex];
+			const int32 LevelEnd = LevelIndex + 1 < LevelOffsets.Num() ? LevelOffsets[LevelIndex + 1] : RootModules.Num();
+			FScopedContentRedirectBatch RedirectBatch;
+
+			for (int32 ModuleIndex = LevelStart; ModuleIndex < LevelEnd; ModuleIndex++) {
+				RootModules[ModuleIndex]->DispatchLifecycleEvent(Phase);
+			}
+		}
+	}
 };
\ No newline at end of file
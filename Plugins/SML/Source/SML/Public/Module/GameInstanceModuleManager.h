@@ -12,9 +12,12 @@ private:
     UPROPERTY()
     TMap<FName, UGameInstanceModule*> RootModuleMap;
 
-    /** Root module list for fast iteration according to order of registration */
+    /** Root module list for fast iteration according to order of registration, sorted by dependency level */
     UPROPERTY()
     TArray<UGameInstanceModule*> RootModuleList;
+
+    /** Index of the first module of each dependency level in the RootModuleList */
+    TArray<int32> RootModuleLevelOffsets;
 public:
     UGameInstanceModuleManager();
     
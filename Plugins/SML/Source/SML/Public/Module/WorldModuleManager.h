@@ -13,9 +13,12 @@ private:
     UPROPERTY()
     TMap<FName, UWorldModule*> RootModuleMap;
 
-    /** Root module list for fast iteration according to order of registration */
+    /** Root module list for fast iteration according to order of registration, sorted by dependency level */
     UPROPERTY()
     TArray<UWorldModule*> RootModuleList;
+
+    /** Index of the first module of each dependency level in the RootModuleList */
+    TArray<int32> RootModuleLevelOffsets;
 public:
     /** Retrieves world module manager for provided world */
     UFUNCTION(BlueprintPure)
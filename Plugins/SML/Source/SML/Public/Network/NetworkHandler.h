@@ -3,12 +3,16 @@
 #include "Subsystems/EngineSubsystem.h"
 #include "UObject/Object.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "Templates/Function.h"
 #include "NetworkHandler.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogModNetworkHandler, Log, Log);
 DECLARE_DELEGATE_TwoParams(FMessageReceived, class UNetConnection* /*Connection*/, FString /*Data*/);
+DECLARE_DELEGATE_TwoParams(FBinaryMessageReceived, class UNetConnection* /*Connection*/, const TArray<uint8>& /*Data*/);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FWelcomePlayer, UWorld* /*ServerWorld*/, class UNetConnection* /*Connection*/);
 DECLARE_MULTICAST_DELEGATE_OneParam(FClientInitialJoin, class UNetConnection* /*Connection*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FClientHelloReceived, class UNetConnection* /*Connection*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FServerChallengeReceived, class UNetConnection* /*Connection*/);
 
 struct FMessageType {
     FString ModReference;
@@ -19,6 +23,52 @@ struct FMessageEntry {
     bool bClientHandled;
     bool bServerHandled;
     FMessageReceived MessageReceived;
+    /** Called for messages sent through SendBinaryMessage */
+    FBinaryMessageReceived BinaryMessageReceived;
+};
+
+/** Large binary payload queued for sending in chunks */
+struct FOutgoingModTransfer {
+    int32 TransferId;
+    FMessageType MessageType;
+    TArray<uint8> Data;
+    /** Amount of payload bytes already sent to the remote side */
+    int32 BytesSent;
+    /** Whenever transfer has been announced to the remote side */
+    bool bStarted;
+};
+
+/** Large binary payload being reassembled from the received chunks */
+struct FIncomingModTransfer {
+    FString ModId;
+    int32 MessageId;
+    int32 TotalSize;
+    TArray<uint8> Data;
+};
+
+/** Network state of the single connection tracked by the mod network handler */
+struct FModConnectionState {
+    /** Indices assigned to mod IDs of the outgoing binary messages, announced to the remote side before first use */
+    TMap<FString, uint16> OutgoingModIdIndices;
+    /** Mod IDs announced by the remote side for incoming binary messages, indexed by their assigned index */
+    TArray<FString> IncomingModIds;
+    /** Outgoing chunked transfers, sent one after another in the order they were started */
+    TArray<FOutgoingModTransfer> OutgoingTransfers;
+    /** Incoming chunked transfers keyed by the transfer ID assigned by the remote side */
+    TMap<int32, FIncomingModTransfer> IncomingTransfers;
+    /** Sum of the announced sizes of the incoming transfers, upper bound of the memory they can buffer */
+    int64 IncomingTransferBytes = 0;
+    int32 NextTransferId = 0;
+
+    /**
+     * Sends next chunks of the outgoing transfers in the order they were started, until MaxBytes of payload have been sent
+     * CanSend is checked before every chunk, so sending stops as soon as the connection cannot take more data
+     * SendTransferStart is called once before the first chunk of every transfer, and the transfer is dropped if it returns false
+     * Returns amount of the payload bytes sent
+     */
+    int32 SendOutgoingTransferChunks(int32 MaxBytes, int32 ChunkSize, TFunctionRef<bool()> CanSend,
+        TFunctionRef<bool(const FOutgoingModTransfer& Transfer)> SendTransferStart,
+        TFunctionRef<void(int32 TransferId, const TArray<uint8>& Chunk)> SendTransferChunk);
 };
 
 /**
@@ -41,9 +91,46 @@ private:
     TMap<FString, TMap<int32, FMessageEntry>> MessageHandlers;
     FWelcomePlayer WelcomePlayerDelegate;
     FClientInitialJoin ClientLoginDelegate;
+    FClientHelloReceived ClientHelloDelegate;
+    FServerChallengeReceived ServerChallengeDelegate;
+    /** Per-connection state used for interning mod IDs of binary messages */
+    TMap<TWeakObjectPtr<class UNetConnection>, FModConnectionState> ConnectionStates;
+    /** Connections with messages queued since the last tick, which will be flushed once on the next tick */
+    TSet<TWeakObjectPtr<class UNetConnection>> ConnectionsPendingFlush;
 private:
+    const FMessageEntry* FindMessageEntry(class UNetConnection* Connection, const FString& ModId, int32 MessageId) const;
     void ReceiveMessage(class UNetConnection* Connection, const FString& ModId, int32 MessageId, const FString& Content) const;
+    void ReceiveBinaryMessage(class UNetConnection* Connection, uint16 ModIdIndex, int32 MessageId, const TArray<uint8>& Content);
+    void ReceiveModIdAssignment(class UNetConnection* Connection, uint16 ModIdIndex, const FString& ModId);
+    void ReceiveTransferStart(class UNetConnection* Connection, int32 TransferId, uint16 ModIdIndex, int32 MessageId, int32 TotalSize);
+    void ReceiveTransferChunk(class UNetConnection* Connection, int32 TransferId, const TArray<uint8>& Chunk);
+    void ReceiveTransferCancel(class UNetConnection* Connection, int32 TransferId);
+    /** Removes incoming transfer and releases its share of the per-connection transfer budget */
+    static void RemoveIncomingTransfer(FModConnectionState& ConnectionState, int32 TransferId);
+
+    /**
+     * Sends next chunks of the outgoing transfers of all connections, limited by MaxTransferBytesPerTick per connection
+     * Connections with control channel reliable buffer already filled up are skipped, so other control messages are never starved
+     */
+    void SendPendingTransferChunks();
+
+    /**
+     * Retrieves index of the mod ID for outgoing messages on the connection, announcing it to the remote side if it is new
+     * Returns false if all of the indices are already taken on the connection
+     */
+    bool GetOrAssignModIdIndex(class UNetConnection* Connection, const FString& ModId, uint16& OutModIdIndex);
+
+    /** Marks connection to be flushed on the next tick, so messages sent during the same frame share packets */
+    void QueueConnectionFlush(class UNetConnection* Connection);
+
+    /** Sends pending transfer chunks and flushes connections with pending messages, called once per engine tick */
+    bool FlushPendingConnections(float DeltaTime);
+
+    FDelegateHandle FlushTickerHandle;
 public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
     /**
      * Retrieves metadata object for given connection
      * Metadata object can be used to store information related to given connection before
@@ -64,6 +151,18 @@ public:
      */
     FORCEINLINE FClientInitialJoin& OnClientInitialJoin() { return ClientLoginDelegate; }
 
+    /**
+     * Delegate called on server when client NMT_Hello is received, before server replies with the challenge
+     * Messages sent here are guaranteed to reach the client before it sends its login request
+     */
+    FORCEINLINE FClientHelloReceived& OnClientHelloReceived() { return ClientHelloDelegate; }
+
+    /**
+     * Delegate called on client when server challenge is received, before client replies with its login request
+     * Messages sent here are guaranteed to reach the server before it welcomes the player
+     */
+    FORCEINLINE FServerChallengeReceived& OnServerChallengeReceived() { return ServerChallengeDelegate; }
+
     /**
      * Register new mod message type and return message entry which can be used
      * to set message processing preferences and siding
@@ -74,8 +173,51 @@ public:
     
     /**
      * Send registered mod message to this connection to be processed on the remote side
+     * Messages are not flushed immediately, all messages sent to the connection during the frame are flushed together on the next tick
      */
     static void SendMessage(class UNetConnection* Connection, FMessageType MessageType, FString Data);
+
+    /**
+     * Send registered mod message with binary payload to this connection, handled by BinaryMessageReceived on the remote side
+     * Mod ID is only sent once per connection, subsequent messages refer to it by the index
+     * Payload should not exceed MaxBinaryMessageSize, since it has to fit into a single control channel bunch
+     * Returns false without sending anything if payload is too large, or if connection has run out of mod ID indices
+     */
+    static bool SendBinaryMessage(class UNetConnection* Connection, const FMessageType& MessageType, const TArray<uint8>& Data);
+
+    /** Maximum size of the binary message payload in bytes */
+    static constexpr int32 MaxBinaryMessageSize = 32 * 1024;
+
+    /**
+     * Reads byte array serialized the same way as TArray<uint8>, but validates its size before allocating memory for it
+     * Payloads larger than MaxPayloadSize or than the amount of bytes left in the reader put the reader into the error state
+     */
+    static bool ReceiveBinaryPayload(class FBitReader& Reader, int32 MaxPayloadSize, TArray<uint8>& OutPayload);
+
+    /**
+     * Starts chunked transfer of the binary payload of any size, handled by BinaryMessageReceived on the remote side once fully received
+     * Payload is split into chunks, which are sent over the next ticks with the limited amount of bytes per tick,
+     * so large transfers do not block other control channel traffic
+     * Returns ID of the transfer which can be used to cancel it, or INDEX_NONE if payload exceeds MaxIncomingTransferSize
+     */
+    int32 StartTransfer(class UNetConnection* Connection, const FMessageType& MessageType, TArray<uint8> Data);
+
+    /** Cancels outgoing transfer, dropping already received chunks on the remote side. Does nothing if transfer has already finished */
+    void CancelTransfer(class UNetConnection* Connection, int32 TransferId);
+
+    /** Returns true if outgoing transfer has not been fully sent yet */
+    bool IsTransferInProgress(class UNetConnection* Connection, int32 TransferId) const;
+
+    /** Size of the single transfer chunk in bytes */
+    static constexpr int32 TransferChunkSize = 8 * 1024;
+    /** Maximum amount of transfer bytes sent to a single connection per tick */
+    static constexpr int32 MaxTransferBytesPerTick = 64 * 1024;
+    /** Maximum size of the incoming transfer accepted from the remote side */
+    static constexpr int32 MaxIncomingTransferSize = 256 * 1024 * 1024;
+    /** Maximum amount of incoming transfers in progress on a single connection */
+    static constexpr int32 MaxConcurrentIncomingTransfers = 16;
+    /** Maximum sum of the sizes of the incoming transfers in progress on a single connection */
+    static constexpr int64 MaxIncomingTransferBytesPerConnection = 256 * 1024 * 1024;
 private:
     friend class FSatisfactoryModLoader;
 
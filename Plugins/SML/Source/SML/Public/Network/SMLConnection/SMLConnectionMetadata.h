@@ -8,5 +8,11 @@ class SML_API USMLConnectionMetadata : public UObject {
     GENERATED_BODY()
 public:
     bool bIsInitialized;
+    /** Client side, whenever server has announced that it understands hash based mod list handshake */
+    bool bServerSupportsModListHash;
+    /** Whenever client mod list hash did not match and full mod list has been requested from the client */
+    bool bAwaitingFullModList;
+    /** Whenever connection validation has been postponed until full mod list is received */
+    bool bValidationDeferred;
     TMap<FString, FVersion> InstalledClientMods;    
 };
@@ -1,13 +1,17 @@
 #pragma once
 #include "CoreMinimal.h"
+#include "Util/SemVersion.h"
 
 class SML_API FSMLNetworkManager {
 public:
     /** Handles SML message being received on the server side */
     static void HandleMessageReceived(class UNetConnection* Connection, FString Data);
 
-    /** Handles Initial Join request on Client. Called after sending initial NMT_Hello message with endianness/basic network version to server */
-    static void HandleInitialClientJoin(UNetConnection* Connection);
+    /** Handles NMT_Hello received on Server, announces hash based mod list handshake support to the client before the challenge is sent */
+    static void HandleClientHello(class UNetConnection* Connection);
+
+    /** Handles NMT_Challenge received on Client. Sends json mod list if server has not announced hash handshake support, since it will not understand it */
+    static void HandleServerChallenge(class UNetConnection* Connection);
 
     /** Handles WelcomePlayer call on Server, which is called after key exchange and results in client getting NMT_Welcome */
     static void HandleWelcomePlayer(UWorld* World, UNetConnection* Connection);
@@ -15,17 +19,54 @@ public:
     /** Handles AGameModeBase::PostLogin call, which is the first place where APlayerController is available and is called after NMT_Join is received from client */
     static void HandleGameModePostLogin(class AGameModeBase* GameMode, class APlayerController* Controller);
 
-    /** Serializes mod list into packed json string */
+    /** Serializes local mod list into packed json string */
     static FString SerializeLocalModList();
 
+    /** Serializes provided mod list into packed json string */
+    static FString SerializeModList(const TMap<FString, FVersion>& ModVersions);
+
     /** Parses packaged json mod list string and sets relevant information on connection */
     static bool HandleModListObject(class USMLConnectionMetadata* Metadata, const FString& ModList);
 
+    /** Returns versions of the locally loaded mods, keyed by mod reference */
+    static TMap<FString, FVersion> GetLocalModVersions();
+
+    /** Computes hash of the mod list. Mods are hashed in the sorted order, so hash does not depend on the map order */
+    static uint64 ComputeModListHash(const TMap<FString, FVersion>& ModVersions);
+
+    /** Serializes hash of the mod list into the payload of the hash handshake message */
+    static TArray<uint8> SerializeModListHash(const TMap<FString, FVersion>& ModVersions);
+
+    /** Serializes mod list into compressed binary form, prefixed by the uncompressed size */
+    static TArray<uint8> SerializeCompressedModList(const TMap<FString, FVersion>& ModVersions);
+
+    /** Parses compressed binary mod list and sets relevant information on connection */
+    static bool HandleCompressedModList(class USMLConnectionMetadata* Metadata, const TArray<uint8>& CompressedModList);
+
     /** Ensures that Connection has required SML initialization data and kicks player off if it doesn't */
     static void ValidateSMLConnectionData(class UNetConnection* Connection);
 private:
     friend class FSatisfactoryModLoader;
     static TSharedPtr<struct FMessageType> MessageTypeModInit;
+    /** Client to server, hash of the client mod list */
+    static TSharedPtr<struct FMessageType> MessageTypeModListHash;
+    /** Server to client, sent when client mod list hash does not match the server one */
+    static TSharedPtr<struct FMessageType> MessageTypeModListRequest;
+    /** Client to server, compressed full mod list sent in response to the request */
+    static TSharedPtr<struct FMessageType> MessageTypeModListCompressed;
+    /** Server to client, announces that server understands hash based handshake. Sent before the challenge, so client knows about it before logging in */
+    static TSharedPtr<struct FMessageType> MessageTypeModListHashSupported;
+
+    /** Upper limit of the uncompressed mod list size accepted from the client */
+    static constexpr int32 MaxUncompressedModListSize = 1024 * 1024;
 
     static void RegisterMessageTypeAndHandlers();
+
+    static void HandleModListHashSupportedReceived(class UNetConnection* Connection, FString Data);
+    static void HandleModListHashReceived(class UNetConnection* Connection, const TArray<uint8>& Data);
+    static void HandleModListRequestReceived(class UNetConnection* Connection, const TArray<uint8>& Data);
+    static void HandleCompressedModListReceived(class UNetConnection* Connection, const TArray<uint8>& Data);
+
+    /** Marks mod list as received, running validation postponed by HandleWelcomePlayer, or closes connection if it was malformed */
+    static void FinishModListReceived(class UNetConnection* Connection, class USMLConnectionMetadata* Metadata, bool bModListValid);
 };
\ No newline at end of file
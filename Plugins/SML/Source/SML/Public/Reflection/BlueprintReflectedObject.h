@@ -3,6 +3,7 @@
 #include "BlueprintReflectedObject.generated.h"
 
 struct FReflectedPropertyInfo;
+class FReflectedFunctionCall;
 
 class SML_API FReflectedObjectState {
 public:
@@ -21,6 +22,8 @@ public:
     virtual bool ShouldStripPropertyNames() const;
     virtual UStruct* GetStructObject() const;
     virtual void* GetObjectData();
+    virtual bool RequiresBlueprintVisibleProperties() const;
+    virtual bool InvokeFunction();
     virtual void AddReferencedObjects(FReferenceCollector& ReferenceCollector) = 0;
 };
 
@@ -90,6 +93,15 @@ public:
     /** Setups this reflected object as an array propert of passed object */
     void SetupFromArray(const FReflectedObject& Object, const FName PropertyName);
 
+    /**
+     * Setups this reflected object as a prepared call of the object function with the provided name
+     * Function parameters are exposed as properties of this object, and keep their values between invocations
+     */
+    void SetupFromFunctionCall(UObject* Object, FName FunctionName);
+
+    /** Calls the function with current parameter values, if this object represents a function call. Returns true if function was called */
+    bool InvokeFunction() const;
+
     /** Returns pointer to the wrapped object, if it's an object wrapper */
     UObject* GetWrappedObject() const;
 
@@ -176,7 +188,7 @@ private:
     FORCEINLINE T* FindPropertyByName(FName PropertyName, const bool bCheckWriteable) const {
         FProperty* Property = State.IsValid() ? State->FindPropertyByName(PropertyName) : NULL;
         if (T* CastedProperty = Cast<T>(Property)) {
-            if (CastedProperty->HasAnyPropertyFlags(CPF_BlueprintVisible)) {
+            if (CastedProperty->HasAnyPropertyFlags(CPF_BlueprintVisible) || !State->RequiresBlueprintVisibleProperties()) {
                 if (bCheckWriteable) {
                     if (!CastedProperty->HasAnyPropertyFlags(CPF_BlueprintReadOnly)) {
                         return CastedProperty;
@@ -243,4 +255,24 @@ public:
 private:
     UScriptStruct* ScriptStruct;
     void* StructDataPointer;
+};
+
+class SML_API FReflectedObjectState_FunctionCall : public FReflectedObjectState {
+public:
+    FReflectedObjectState_FunctionCall(UObject* Object, UFunction* Function);
+    virtual ~FReflectedObjectState_FunctionCall() override;
+
+    virtual TArray<FReflectedPropertyInfo> GetAllProperties() const override;
+    virtual FProperty* FindPropertyByName(FName PropertyName) const override;
+    virtual void* GetPropertyValue(FName PropertyName) override;
+    virtual UObject* GetObjectPointer() const override;
+    virtual UStruct* GetStructObject() const override;
+    virtual void* GetObjectData() override;
+    virtual bool RequiresBlueprintVisibleProperties() const override;
+    virtual bool InvokeFunction() override;
+    virtual void AddReferencedObjects(FReferenceCollector& ReferenceCollector) override;
+private:
+    UObject* ReferencedObject;
+    UFunction* Function;
+    TUniquePtr<FReflectedFunctionCall> FunctionCall;
 };
\ No newline at end of file
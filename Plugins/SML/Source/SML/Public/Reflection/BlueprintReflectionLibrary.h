@@ -37,6 +37,18 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Reflection", CustomThunk, meta = (CustomStructureParam = "StructInfo"))
     static void DeflectStruct(const FReflectedObject& ReflectedObject, UPARAM(Ref) const FDynamicStructInfo& StructInfo);
 
+    /**
+     * Prepares a call of the object function with the provided name, or returns invalid object if there is no such function
+     * Parameters are accessed as properties of the returned object, and keep their values between invocations,
+     * so keep the prepared call around to call the same function repeatedly
+     */
+    UFUNCTION(BlueprintCallable, Category = "Reflection")
+    static FReflectedObject PrepareFunctionCall(UObject* Object, FName FunctionName);
+
+    /** Calls the function with current parameter values of the prepared call. Returns true if function was called */
+    UFUNCTION(BlueprintCallable, Category = "Reflection")
+    static bool InvokeFunctionCall(const FReflectedObject& FunctionCall);
+
     /** Returns a list of reflected properties for provided object */
     UFUNCTION(BlueprintPure, Category = "Reflection")
     static TArray<FReflectedPropertyInfo> GetReflectedProperties(const FReflectedObject& ReflectedObject);
@@ -0,0 +1,85 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+
+/**
+ * Prepared call of the UFunction, which resolves the parameter layout once and reuses the parameter buffer between calls
+ * Arguments are written and results are read by parameter index, so repeated calls cost about the same as a plain ProcessEvent
+ * Parameter values persist between calls, so only changed arguments need to be written again
+ * Parameter buffers are taken from a shared pool and returned to it on destruction, so short-lived calls do not allocate either
+ * Not thread safe, and cannot be invoked again while it is already being invoked
+ */
+class SML_API FReflectedFunctionCall {
+public:
+    explicit FReflectedFunctionCall(UFunction* Function);
+    ~FReflectedFunctionCall();
+
+    FReflectedFunctionCall(const FReflectedFunctionCall&) = delete;
+    FReflectedFunctionCall& operator=(const FReflectedFunctionCall&) = delete;
+
+    FORCEINLINE UFunction* GetFunction() const { return Function; }
+    FORCEINLINE int32 GetParameterCount() const { return Parameters.Num(); }
+    FORCEINLINE FProperty* GetParameter(int32 Index) const { return Parameters[Index].Property; }
+
+    /** Returns index of the parameter with the provided name, or INDEX_NONE. Resolve it once and reuse it for all calls */
+    int32 FindParameterIndex(FName ParameterName) const;
+
+    /** Returns index of the return value parameter, or INDEX_NONE if function does not return anything */
+    FORCEINLINE int32 GetReturnValueIndex() const { return ReturnValueIndex; }
+
+    /** Returns parameter buffer, which acts as a container of all parameter properties */
+    FORCEINLINE void* GetParameterBuffer() const { return ParameterBuffer; }
+
+    /** Returns pointer to the parameter value inside of the parameter buffer */
+    FORCEINLINE void* GetParameterValuePtr(int32 Index) const {
+        return ParameterBuffer + Parameters[Index].Offset;
+    }
+
+    /** Copies value of the parameter type into the parameter buffer */
+    void SetArgumentRaw(int32 Index, const void* Value);
+
+    /** Copies parameter value from the parameter buffer into the provided value of the parameter type */
+    void GetResultRaw(int32 Index, void* OutValue) const;
+
+    template<typename T>
+    FORCEINLINE void SetArgument(int32 Index, const typename T::TCppType& Value) {
+        checkf(Parameters[Index].Property->IsA<T>(), TEXT("Parameter %d of function %s has different type"), Index, *Function->GetName());
+        static_cast<T*>(Parameters[Index].Property)->SetPropertyValue(GetParameterValuePtr(Index), Value);
+    }
+
+    template<typename T>
+    FORCEINLINE typename T::TCppType GetResult(int32 Index) const {
+        checkf(Parameters[Index].Property->IsA<T>(), TEXT("Parameter %d of function %s has different type"), Index, *Function->GetName());
+        return static_cast<const T*>(Parameters[Index].Property)->GetPropertyValue(GetParameterValuePtr(Index));
+    }
+
+    /** Calls the function on the object with the current parameter values */
+    void Invoke(UObject* Object);
+
+    /** Resets all parameters to their default values */
+    void ResetParameters();
+private:
+    /** Returns buffer of at least the provided size from the pool, or allocates a new one */
+    static uint8* AllocateParameterBuffer(int32 BufferSize, uint32 BufferAlignment);
+
+    /** Returns buffer to the pool, or frees it if the pool is full */
+    static void ReleaseParameterBuffer(uint8* Buffer, int32 BufferSize, uint32 BufferAlignment);
+
+    /** Copy plan of the single parameter, resolved once on construction */
+    struct FParameterInfo {
+        FProperty* Property;
+        int32 Offset;
+        int32 Size;
+        /** Plain old data parameters are copied with memcpy, others go through the property */
+        bool bIsPlainOldData;
+    };
+
+    UFunction* Function;
+    TArray<FParameterInfo> Parameters;
+    int32 ReturnValueIndex;
+    uint8* ParameterBuffer;
+    /** True if any of the parameters needs to be destroyed before buffer is freed or reinitialized */
+    bool bNeedsDestruction;
+    bool bIsInvoking;
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/Atomic.h"
+
+/**
+ * Global cache of properties and functions resolved by name, used by reflection helpers instead of walking the field chain every time
+ * Misses are cached too, so repeated lookups of fields that do not exist are cheap as well
+ * Cache is invalidated when classes are reinstanced, e.g. after blueprint recompilation or hot reload
+ * Lookups are guarded by a read-write lock, so they can be done from any thread
+ */
+class SML_API FReflectedPropertyCache {
+public:
+    /** Returns property of the struct with the provided name, or NULL if it does not exist */
+    static FProperty* FindProperty(UStruct* Struct, FName PropertyName);
+
+    /** Returns function of the class or any of its super classes with the provided name, or NULL if it does not exist */
+    static UFunction* FindFunction(UClass* Class, FName FunctionName);
+
+    /** Discards all cached properties and functions, and makes existing property handles resolve their properties again */
+    static void Invalidate();
+
+    /** Returns current cache generation, which changes every time cache is invalidated */
+    FORCEINLINE static uint32 GetGeneration() { return CacheGeneration.Load(EMemoryOrder::Relaxed); }
+private:
+    friend class FSatisfactoryModLoader;
+
+    /** Registers delegates invalidating the cache */
+    static void RegisterDelegates();
+
+    /** Removes entries of structs which have been garbage collected */
+    static void RemoveStaleEntries();
+
+    static TMap<TPair<FObjectKey, FName>, FProperty*> CachedProperties;
+    static TMap<TPair<FObjectKey, FName>, UFunction*> CachedFunctions;
+    static FRWLock CacheLock;
+    static TAtomic<uint32> CacheGeneration;
+};
+
+/**
+ * Reusable handle to the property of the struct, resolved once and kept until the property cache is invalidated
+ * Store it to access the same property repeatedly without any name lookups
+ */
+class SML_API FReflectedPropertyHandle {
+public:
+    FReflectedPropertyHandle();
+    FReflectedPropertyHandle(UStruct* Struct, FName PropertyName);
+
+    /** Returns resolved property, or NULL if struct does not have it */
+    FORCEINLINE FProperty* GetProperty() const {
+        //Properties are owned by the struct, so they should not be used once it has been collected
+        if (ResolvedGeneration != FReflectedPropertyCache::GetGeneration() || !Struct.IsValid()) {
+            Resolve();
+        }
+        return Property;
+    }
+
+    /** Returns property cast to the provided type, or NULL if property is missing or has a different type */
+    template<typename T>
+    FORCEINLINE T* GetProperty() const {
+        return CastField<T>(GetProperty());
+    }
+
+    /** Returns pointer to the property value inside of the container, or NULL if property is missing */
+    FORCEINLINE void* GetValuePtr(void* ContainerData, int32 ArrayIndex = 0) const {
+        FProperty* ResolvedProperty = GetProperty();
+        return ResolvedProperty ? ResolvedProperty->ContainerPtrToValuePtr<void>(ContainerData, ArrayIndex) : NULL;
+    }
+
+    FORCEINLINE UStruct* GetStruct() const { return Struct.Get(); }
+    FORCEINLINE FName GetPropertyName() const { return PropertyName; }
+private:
+    void Resolve() const;
+
+    TWeakObjectPtr<UStruct> Struct;
+    FName PropertyName;
+    mutable FProperty* Property;
+    mutable uint32 ResolvedGeneration;
+};
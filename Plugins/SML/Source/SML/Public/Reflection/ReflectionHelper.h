@@ -2,6 +2,7 @@
 #include "CoreMinimal.h"
 #include "UObject/Class.h"
 #include "Templates/Casts.h"
+#include "Reflection/ReflectedPropertyCache.h"
 #include "ReflectionHelper.generated.h"
 
 USTRUCT(BlueprintInternalUseOnly)
@@ -41,7 +42,7 @@ public:
     
     template <typename T>
     static T* FindPropertyChecked(UStruct* Class, const TCHAR* PropertyName) {
-        T* Property = Cast<T>(Class->FindPropertyByName(PropertyName));
+        T* Property = Cast<T>(FReflectedPropertyCache::FindProperty(Class, PropertyName));
         checkf(Property, TEXT("Property with given name not found in class: %s"), PropertyName);
         return Property;
     }
@@ -61,7 +62,7 @@ public:
     
     template<typename T>
     static typename T::TCppType GetPropertyValue(const UObject* Object, const TCHAR* PropertyName, int32 ArrayIndex = 0) {
-        T* Property = Cast<T>(Object->GetClass()->FindPropertyByName(PropertyName));
+        T* Property = Cast<T>(FReflectedPropertyCache::FindProperty(Object->GetClass(), PropertyName));
         checkf(Property, TEXT("Property not found in class %s: %s"), *Object->GetClass()->GetPathName(), PropertyName);
         return Property->GetPropertyValue_InContainer(Object, ArrayIndex);
     }
@@ -75,7 +76,7 @@ public:
     }
 
     static void SetStructPropertyValue(UObject* Object, const TCHAR* PropertyName, const void* ValuePointer, int32 ArrayIndex = 0) {
-        FStructProperty* Property = CastField<FStructProperty>(Object->GetClass()->FindPropertyByName(PropertyName));
+        FStructProperty* Property = CastField<FStructProperty>(FReflectedPropertyCache::FindProperty(Object->GetClass(), PropertyName));
         checkf(Property, TEXT("Property not found in class %s: %s"), *Object->GetClass()->GetPathName(), PropertyName);
         void* DestAddress = Property->ContainerPtrToValuePtr<void>(Object, ArrayIndex);
         Property->CopyValuesInternal(DestAddress, ValuePointer, 1);
@@ -83,7 +84,7 @@ public:
 
     template<typename T>
     static void SetPropertyValue(UObject* Object, const TCHAR* PropertyName, const typename T::TCppType& Value, int32 ArrayIndex = 0) {
-        T* Property = CastField<T>(Object->GetClass()->FindPropertyByName(PropertyName));
+        T* Property = CastField<T>(FReflectedPropertyCache::FindProperty(Object->GetClass(), PropertyName));
         checkf(Property, TEXT("Property not found in class %s: %s"), *Object->GetClass()->GetPathName(), PropertyName);
         Property->SetPropertyValue_InContainer(Object, Value, ArrayIndex);
     }
@@ -99,7 +100,7 @@ public:
 
     template <typename T>
     static UFunction* CallScriptFunction(UObject* Object, const TCHAR* FunctionName, T* ParamStruct) {
-        UFunction* Function = Object->FindFunction(FunctionName);
+        UFunction* Function = FReflectedPropertyCache::FindFunction(Object->GetClass(), FunctionName);
         checkf(Function, TEXT("Function not found: %s"), FunctionName);
         checkf(Function->ParmsSize == static_cast<uint16>(sizeof(T)) || (Function->ParmsSize == 0 && ParamStruct == NULL),
             TEXT("Function parameter layout doesn't match provided parameter struct: Expected %d bytes, got %u"),
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "FGInputLibrary.h"
+#include "Components/InputComponent.h"
 #include "ModKeyBindRegistry.generated.h"
 
 UCLASS()
@@ -35,4 +36,54 @@ public:
      */
     UFUNCTION(BlueprintCallable)
     static void RegisterModAxisBind(const FString& ModReference, const FInputAxisKeyMapping& PositiveAxisMapping, const FInputAxisKeyMapping& NegativeAxisMapping, const FText& PositiveDisplayName, const FText& NegativeDisplayName);
+
+    /**
+     * Returns dense index assigned to the registered mod action on registration, or INDEX_NONE if it has not been registered
+     * Resolve it once and use it for all subsequent lookups and bindings instead of the action name
+     */
+    UFUNCTION(BlueprintPure)
+    static int32 FindModKeyBindIndex(FName ActionName);
+
+    /** Returns dense index assigned to the registered mod axis on registration, or INDEX_NONE if it has not been registered */
+    UFUNCTION(BlueprintPure)
+    static int32 FindModAxisBindIndex(FName AxisName);
+
+    /** Returns name of the mod action registered under the provided index, or None if index is invalid */
+    UFUNCTION(BlueprintPure)
+    static FName GetModKeyBindName(int32 KeyBindIndex);
+
+    /** Returns name of the mod axis registered under the provided index, or None if index is invalid */
+    UFUNCTION(BlueprintPure)
+    static FName GetModAxisBindName(int32 AxisBindIndex);
+
+    /** Returns amount of the registered mod actions. Valid indices are in the range [0; Num) */
+    FORCEINLINE static int32 GetNumModKeyBinds() { return RegisteredActionNames.Num(); }
+
+    /** Returns amount of the registered mod axes. Valid indices are in the range [0; Num) */
+    FORCEINLINE static int32 GetNumModAxisBinds() { return RegisteredAxisNames.Num(); }
+
+    /** Binds object method to the mod action with the provided index */
+    template<class UserClass>
+    static FInputActionBinding& BindModAction(UInputComponent* InputComponent, int32 KeyBindIndex, EInputEvent KeyEvent, UserClass* Object, typename FInputActionHandlerSignature::template TUObjectMethodDelegate<UserClass>::FMethodPtr Func) {
+        checkf(RegisteredActionNames.IsValidIndex(KeyBindIndex), TEXT("Invalid mod key bind index: %d"), KeyBindIndex);
+        return InputComponent->BindAction(RegisteredActionNames[KeyBindIndex], KeyEvent, Object, Func);
+    }
+
+    /** Binds object method to the mod axis with the provided index */
+    template<class UserClass>
+    static FInputAxisBinding& BindModAxis(UInputComponent* InputComponent, int32 AxisBindIndex, UserClass* Object, typename FInputAxisHandlerSignature::template TUObjectMethodDelegate<UserClass>::FMethodPtr Func) {
+        checkf(RegisteredAxisNames.IsValidIndex(AxisBindIndex), TEXT("Invalid mod axis bind index: %d"), AxisBindIndex);
+        return InputComponent->BindAxis(RegisteredAxisNames[AxisBindIndex], Object, Func);
+    }
+private:
+    /** Assigns dense index to the name if it does not have one yet and returns it */
+    static int32 AssignBindingIndex(FName BindingName, TArray<FName>& RegisteredNames, TMap<FName, int32>& NameIndices);
+
+    /** Names of the registered mod actions, indexed by their dense index */
+    static TArray<FName> RegisteredActionNames;
+    static TMap<FName, int32> ActionNameIndices;
+
+    /** Names of the registered mod axes, indexed by their dense index */
+    static TArray<FName> RegisteredAxisNames;
+    static TMap<FName, int32> AxisNameIndices;
 };
@@ -4,6 +4,13 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "RemoteCallObjectRegistry.generated.h"
 
+/** Remote call objects resolved for a single player controller */
+struct FControllerRemoteCallObjects {
+    TWeakObjectPtr<class AFGPlayerController> PlayerController;
+    /** Resolved remote call objects, indexed by the slot of their class */
+    TArray<TWeakObjectPtr<UFGRemoteCallObject>> RemoteCallObjects;
+};
+
 UCLASS()
 class SML_API URemoteCallObjectRegistry : public UGameInstanceSubsystem {
     GENERATED_BODY()
@@ -11,12 +18,56 @@ public:
     UFUNCTION(BlueprintCallable)
     void RegisterRemoteCallObject(TSubclassOf<UFGRemoteCallObject> RemoteCallObject);
 
+    /**
+     * Returns remote call object of the registered class for the player controller, or NULL if it is not available yet
+     * Objects are cached per controller in the slots assigned to classes on registration,
+     * so it is cheaper than AFGPlayerController::GetRemoteCallObjectOfClass when called often
+     */
+    UFUNCTION(BlueprintPure)
+    UFGRemoteCallObject* GetRemoteCallObject(class AFGPlayerController* PlayerController, TSubclassOf<UFGRemoteCallObject> RemoteCallObject);
+
+    /** Returns dense slot index assigned to the remote call object class on registration, or INDEX_NONE if it is not registered */
+    int32 GetRemoteCallObjectSlot(TSubclassOf<UFGRemoteCallObject> RemoteCallObject) const;
+
+    /** Returns remote call object stored in the slot for the player controller. Slot can be retrieved once and reused for all lookups */
+    UFGRemoteCallObject* GetRemoteCallObjectBySlot(class AFGPlayerController* PlayerController, int32 Slot);
+
+    template<typename T>
+    FORCEINLINE T* GetRemoteCallObject(class AFGPlayerController* PlayerController) {
+        return Cast<T>(GetRemoteCallObject(PlayerController, T::StaticClass()));
+    }
+
+    /** Returns remote call object registry of the game instance the object belongs to */
+    static URemoteCallObjectRegistry* Get(const UObject* WorldContext);
+
+    /**
+     * Returns remote call object of the class for the player controller through the registry of it's game instance
+     * Falls back to AFGPlayerController::GetRemoteCallObjectOfClass when controller does not belong to the game instance with the registry
+     */
+    static UFGRemoteCallObject* GetPlayerRemoteCallObject(class AFGPlayerController* PlayerController, TSubclassOf<UFGRemoteCallObject> RemoteCallObject);
+
+    template<typename T>
+    static FORCEINLINE T* GetPlayerRemoteCallObject(class AFGPlayerController* PlayerController) {
+        return Cast<T>(GetPlayerRemoteCallObject(PlayerController, T::StaticClass()));
+    }
+
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 private:
     friend class FSatisfactoryModLoader;
     
+    /** Registered remote call object classes. Index of the class in the array is it's slot */
     UPROPERTY()
     TArray<TSubclassOf<UFGRemoteCallObject>> RegisteredRCOs;
+    TMap<UClass*, int32> RemoteCallObjectSlots;
+    /** Remote call objects of each player controller resolved so far */
+    TArray<FControllerRemoteCallObjects> ControllerEntries;
+    /** Indices of the player controller entries in ControllerEntries */
+    TMap<TWeakObjectPtr<class AFGPlayerController>, int32> ControllerEntryIndices;
+    /** Index of the entry of the player controller looked up last */
+    int32 LastControllerEntry = INDEX_NONE;
+
+    /** Returns entry of the player controller, creating it if it does not exist yet */
+    FControllerRemoteCallObjects& FindOrAddControllerEntry(class AFGPlayerController* PlayerController);
 
     static void RegisterRCOsOnGameMode(class AGameModeBase* GameMode);
     
@@ -44,7 +44,7 @@ public:
 	
 	/**
 	 * Spawns subsystem instance and returns created actor
-	 * Store it in member variable for faster access
+	 * Spawned subsystem is added into the world UModSubsystemIndex, but storing it in member variable is still the fastest access
 	 * @return spawned subsystem instance, or nullptr if spawning failed
 	 */
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Spawn Subsystem", DeterminesOutputType = "SpawnClass"))
@@ -0,0 +1,57 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ModSubsystemIndex.generated.h"
+
+class AFGSubsystem;
+class UModSubsystemHolder;
+
+/**
+ * World scoped index of mod subsystem holders and subsystem actors, keyed by their class
+ * Holders are added when they are attached to the game state, and subsystems when they are spawned by holders.
+ * On clients subsystems are replicated instead of spawned, so they are indexed on the first lookup
+ * Index is discarded together with the world, so it never refers to subsystems of the previous world
+ */
+UCLASS()
+class SML_API UModSubsystemIndex : public UWorldSubsystem {
+	GENERATED_BODY()
+public:
+	/** Retrieves subsystem index of the provided world, or nullptr if world context has no world */
+	static UModSubsystemIndex* Get(const UObject* WorldContext);
+
+	virtual void Deinitialize() override;
+
+	/** Adds subsystem holder attached to the game state into the index */
+	void AddSubsystemHolder(UModSubsystemHolder* SubsystemHolder);
+
+	/** Adds spawned subsystem actor into the index */
+	void AddSubsystem(AFGSubsystem* Subsystem);
+
+	/** Returns subsystem holder of the provided class, or it's subclass */
+	UModSubsystemHolder* FindSubsystemHolder(UClass* HolderClass);
+
+	/** Returns subsystem actor of the provided class, or it's subclass */
+	AFGSubsystem* FindSubsystem(UClass* SubsystemClass);
+
+	/**
+	 * Retrieves spawned mod subsystem of the given class for the world context
+	 * In C++, use helper template function GetModSubsystem<T>()
+	 */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "GetModSubsystem", WorldContext = "WorldContextObject", DeterminesOutputType = "SubsystemClass"))
+	static AFGSubsystem* K2_GetModSubsystem(TSubclassOf<AFGSubsystem> SubsystemClass, UObject* WorldContextObject);
+
+	template<typename T>
+	static T* GetModSubsystem(const UObject* WorldContext) {
+		UModSubsystemIndex* SubsystemIndex = Get(WorldContext);
+		//Index only ever maps class to the actor of that class, so no checked cast is needed
+		return SubsystemIndex ? static_cast<T*>(SubsystemIndex->FindSubsystem(T::StaticClass())) : nullptr;
+	}
+private:
+	/** Subsystem holders keyed by the requested class, which is either their own class or one of their parents */
+	UPROPERTY()
+	TMap<UClass*, UModSubsystemHolder*> SubsystemHolders;
+
+	/** Subsystem actors keyed by the requested class, which is either their own class or one of their parents */
+	UPROPERTY()
+	TMap<UClass*, AFGSubsystem*> Subsystems;
+};
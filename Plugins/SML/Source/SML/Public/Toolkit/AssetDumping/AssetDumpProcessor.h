@@ -30,6 +30,8 @@ private:
 	int32 CurrentPackageToLoadIndex;
 	
 	FThreadSafeCounter PackageLoadRequestsInFlyCounter;
+	/** Copies of the static mesh packages loaded with forced CPU access to render data, keyed by the original package name */
+	TMap<FName, UPackage*> RenderDataPackages;
 
 	FCriticalSection LoadedPackagesCriticalSection;
 	TArray<UPackage*> LoadedPackages;
@@ -70,5 +72,12 @@ public:
 protected:
 	void InitializeAssetDump();
 	void OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+	void EnqueueLoadedPackage(UPackage* LoadedPackage);
+	
+	/** Loads copy of the package with CPU access to static mesh render data forced, so mesh geometry can be exported */
+	void LoadRenderDataPackage(UPackage* OriginalPackage);
+	void OnRenderDataPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result, UPackage* OriginalPackage);
+	/** Releases the package copy loaded for the provided package, so it can be garbage collected along with its render resources */
+	void ReleaseRenderDataPackage(FName PackageName);
 	void PerformAssetDumpForPackage(UPackage* Package);
 };
\ No newline at end of file
@@ -31,6 +31,8 @@ private:
 	UObjectHierarchySerializer* ObjectHierarchySerializer;
 	/** Additional data serialized by the asset type serializer */
 	TSharedPtr<FJsonObject> AssetSerializedData;
+	/** Copy of the package loaded by the dumper with CPU access to mesh render data forced, or NULL */
+	UPackage* RenderDataPackage;
 
 	/** Internal constructor */
 	FSerializationContext(const FString& RootOutputDirectory, const FAssetData& AssetData, UPackage* Package);
@@ -60,6 +62,14 @@ public:
 		return AssetData;
 	}
 
+	/**
+	 * Returns copy of the package loaded with CPU access to mesh render data forced, or NULL if it has not been loaded
+	 * Meshes in the package itself usually have their CPU data freed, so geometry should be exported from the copy
+	 */
+	FORCEINLINE UPackage* GetRenderDataPackage() const {
+		return RenderDataPackage;
+	}
+
 	/** Return property serializer usable for serializing UProperty values */
 	FORCEINLINE UPropertySerializer* GetPropertySerializer() const {
 		return PropertySerializer;
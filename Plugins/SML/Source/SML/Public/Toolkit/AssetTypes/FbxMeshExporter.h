@@ -16,12 +16,19 @@ class UAnimSequence;
 class SML_API FFbxMeshExporter {
 public:
     /**
-     * Hooks into UStaticMesh::Serialize to set bAllowCPUAccess to true
+     * Hooks into UStaticMesh::Serialize to set bAllowCPUAccess to true for meshes
+     * loaded from the packages passed to BeginForceStaticMeshCPUAccess
      * CPU access is needed to be able to dump meshes, because otherwise
      * their resources on CPU are freed once GPU resource is allocated
      */
     static void RegisterStaticMeshCPUAccessHook();
 
+    /** Begins forcing CPU access on static meshes loaded from the package with the provided name */
+    static void BeginForceStaticMeshCPUAccess(FName PackageName);
+
+    /** Stops forcing CPU access on static meshes loaded from the package with the provided name */
+    static void EndForceStaticMeshCPUAccess(FName PackageName);
+
     /**
      * Exports static mesh data into the FBX file using the specified path
      * If exporting fails, false is returned and error message is populated with error message
@@ -0,0 +1,29 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Lightweight kismet bytecode walker computing expression sizes and statement offsets
+ * Unlike FKismetBytecodeDisassemblerJson, it decodes opcodes directly in the script buffer
+ * without building any intermediate representation, and never allocates memory
+ *
+ * All methods are bounds checked and return false on malformed bytecode instead of crashing
+ * Object and property pointers embedded into the bytecode are skipped and never dereferenced
+ */
+class SML_API FKismetBytecodeScanner {
+public:
+	/**
+	 * Computes size of the expression starting at the given script index, including all nested expressions
+	 * When OutJumpTargets is provided, script offsets targeted by jump instructions inside of the expression are appended to it,
+	 * including the ones of nested expressions like EX_SwitchValue. Targets are appended even if expression later turns out to be malformed
+	 */
+	static bool GetExpressionSize(const TArray<uint8>& Script, int32 ExpressionIndex, int32& OutExpressionSize, TArray<int32>* OutJumpTargets = NULL);
+
+	/** Computes length of the statement in bytes. Returns false if given index does not correspond to any statement (e.g if it is inside of some statement) */
+	static bool GetStatementLength(const TArray<uint8>& Script, int32 StatementIndex, int32& OutStatementLength);
+
+	/** Returns index of the first statement using given opcode, starting at the provided statement index */
+	static bool FindFirstStatementOfType(const TArray<uint8>& Script, int32 StartIndex, uint8 StatementOpcode, int32& OutStatementIndex);
+
+	/** Returns true if given index corresponds to the start of the top level statement in the script */
+	static bool IsStatementIndex(const TArray<uint8>& Script, int32 StatementIndex);
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UFunction;
+
+/**
+ * Index of the top level statements inside of the function's script bytecode
+ * Holds sorted statement start offsets, jump targets and return sites, so offset queries are O(log n)
+ *
+ * Indices are built lazily on first request and cached per function
+ * Cached index is rebuilt automatically when script size or buffer changes, but code rewriting
+ * script bytecode in place should call InvalidateStatementIndex explicitly to be safe
+ */
+class SML_API FKismetBytecodeStatementIndex {
+public:
+	/** Returns statement index for the provided function, building it if it is not cached yet or is out of date */
+	static TSharedRef<const FKismetBytecodeStatementIndex> GetStatementIndex(UFunction* Function);
+
+	/** Drops cached statement index for the function. Should be called after rewriting function script */
+	static void InvalidateStatementIndex(UFunction* Function);
+
+	/** Builds statement index for the raw script bytecode without caching it */
+	explicit FKismetBytecodeStatementIndex(const TArray<uint8>& Script);
+
+	/** Returns true if the whole script has been successfully walked. Malformed scripts will only have statements up to the first malformed one */
+	FORCEINLINE bool IsComplete() const { return bIsComplete; }
+
+	/** Returns sorted offsets of all top level statements in the script */
+	FORCEINLINE const TArray<int32>& GetStatementOffsets() const { return StatementOffsets; }
+
+	/**
+	 * Returns sorted unique script offsets targeted by jump instructions anywhere in the script
+	 * Includes EX_Jump, EX_JumpIfNot and EX_PushExecutionFlow, as well as case offsets of nested EX_SwitchValue expressions
+	 */
+	FORCEINLINE const TArray<int32>& GetJumpTargets() const { return JumpTargets; }
+
+	/** Returns sorted offsets of the EX_Return statements in the script */
+	FORCEINLINE const TArray<int32>& GetReturnStatementOffsets() const { return ReturnStatementOffsets; }
+
+	/** Returns true if given offset corresponds to the start of the top level statement */
+	bool IsStatementIndex(int32 ScriptOffset) const;
+
+	/** Returns true if given script offset is targeted by any jump instruction in the script, including nested ones */
+	bool IsJumpTarget(int32 ScriptOffset) const;
+
+	/** Computes length of the statement in bytes. Returns false if given offset does not correspond to any statement */
+	bool GetStatementLength(int32 StatementIndex, int32& OutStatementLength) const;
+
+	/** Returns offset of the first statement starting at or after the given script offset, or INDEX_NONE if there are none */
+	int32 FindStatementAtOrAfter(int32 ScriptOffset) const;
+
+	/** Returns offset of the first EX_Return statement in the script, or INDEX_NONE if there are none */
+	FORCEINLINE int32 GetFirstReturnStatementOffset() const { return ReturnStatementOffsets.Num() ? ReturnStatementOffsets[0] : INDEX_NONE; }
+private:
+	/** Sorted offsets of the top level statements */
+	TArray<int32> StatementOffsets;
+	TArray<int32> JumpTargets;
+	TArray<int32> ReturnStatementOffsets;
+	/** Offset right after the last successfully walked statement */
+	int32 EndOfStatements;
+	bool bIsComplete;
+
+	/** Script buffer and size the index has been built from, used to detect script rewrites */
+	const uint8* SourceScriptData;
+	int32 SourceScriptSize;
+
+	static FCriticalSection CachedIndicesCriticalSection;
+	static TMap<TWeakObjectPtr<UFunction>, TSharedPtr<const FKismetBytecodeStatementIndex>> CachedIndices;
+	/** Cache size at which entries of garbage collected functions are pruned next time */
+	static int32 NextStaleIndicesPruneSize;
+};
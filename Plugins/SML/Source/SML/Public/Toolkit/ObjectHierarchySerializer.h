@@ -63,6 +63,7 @@ public:
     FORCEINLINE static const TSet<FName>& GetUnhandledNativeClasses() { return UnhandledNativeClasses; }
 private:
     static TSet<FName> UnhandledNativeClasses;
+    static FCriticalSection UnhandledNativeClassesCriticalSection;
     
     void SerializeImportedObject(TSharedPtr<FJsonObject> ResultJson, UObject* Object);
     void SerializeExportedObject(TSharedPtr<FJsonObject> ResultJson, UObject* Object);
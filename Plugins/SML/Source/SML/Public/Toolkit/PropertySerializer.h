@@ -5,6 +5,47 @@
 
 class UObjectHierarchySerializer;
 
+/** Kind of the property value, determines how it is serialized. Resolved once per property instead of casting on each value */
+enum class EPropertyValueKind : uint8 {
+    Map,
+    Set,
+    Array,
+    MulticastDelegate,
+    Delegate,
+    Interface,
+    Class,
+    SoftObject,
+    Object,
+    Struct,
+    EnumByte,
+    FloatingPoint,
+    Integer,
+    Bool,
+    String,
+    Enum,
+    Name,
+    Text,
+    FieldPath,
+    Unsupported
+};
+
+/** Single precompiled step of the struct serialization plan */
+struct FPropertySerializationStep {
+    FProperty* Property;
+    /** Offset of the property value inside of the container */
+    int32 Offset;
+    EPropertyValueKind ValueKind;
+    /** Name of the property as it is written into the resulting json object */
+    FString Name;
+    /** Custom serializer set for this property, or NULL if it is serialized normally */
+    const TFunction<TSharedRef<FJsonValue>(FProperty* Property, const void* Value)>* CustomSerializer;
+};
+
+/** Precompiled list of serialization steps for the struct, with property filtering already applied */
+struct FStructSerializationPlan {
+    TArray<FPropertySerializationStep> Steps;
+};
+
 UCLASS()
 class SML_API UPropertySerializer : public UObject {
     GENERATED_BODY()
@@ -22,7 +63,11 @@ private:
     
     TMap<FProperty*, FPropertySerializer> CustomPropertySerializers;
     TMap<FProperty*, FPropertyDeserializer> CustomPropertyDeserializers;
-    TArray<FProperty*> BlacklistedProperties;
+    TSet<FProperty*> BlacklistedProperties;
+
+    /** Cached serialization plans for structs, with and without ShouldSerializeProperty filtering applied */
+    TMap<UStruct*, TSharedPtr<const FStructSerializationPlan>> FilteredSerializationPlans;
+    TMap<UStruct*, TSharedPtr<const FStructSerializationPlan>> UnfilteredSerializationPlans;
 public:
     /** Disables property serialization entirely */
     void DisablePropertySerialization(UStruct* Struct, FName PropertyName);
@@ -38,10 +83,27 @@ public:
 
     TSharedRef<FJsonValue> SerializePropertyValue(FProperty* Property, const void* Value);
     TSharedRef<FJsonObject> SerializeStruct(UScriptStruct* Struct, const void* Value);
+
+    /**
+     * Serializes properties of the struct (or class) into the provided json object using precompiled plan
+     * When bFilterProperties is true, only properties passing ShouldSerializeProperty are serialized
+     */
+    void SerializeStructProperties(UStruct* Struct, const void* Container, const TSharedPtr<FJsonObject>& OutObject, bool bFilterProperties);
     
     void DeserializePropertyValue(FProperty* Property, const TSharedRef<FJsonValue>& Value, void* OutValue);
     void DeserializeStruct(UScriptStruct* Struct, const TSharedRef<FJsonObject>& Value, void* OutValue);
 private:
     void DeserializePropertyValueInner(FProperty* Property, const TSharedRef<FJsonValue>& Value, void* OutValue);
     TSharedRef<FJsonValue> SerializePropertyValueInner(FProperty* Property, const void* Value);
+    TSharedRef<FJsonValue> SerializePropertyValueOfKind(EPropertyValueKind ValueKind, FProperty* Property, const void* Value);
+    TSharedRef<FJsonValue> SerializeContainerElement(FProperty* ElementProperty, const FPropertySerializer* CustomSerializer, EPropertyValueKind ElementKind, const void* Value);
+
+    /** Returns cached serialization plan for the struct, compiling it if necessary */
+    TSharedRef<const FStructSerializationPlan> GetSerializationPlan(UStruct* Struct, bool bFilterProperties);
+
+    /** Drops all cached serialization plans, called when property serialization settings change */
+    void InvalidateSerializationPlans();
+
+    /** Determines how value of the provided property should be serialized */
+    static EPropertyValueKind ResolvePropertyValueKind(FProperty* Property);
 };
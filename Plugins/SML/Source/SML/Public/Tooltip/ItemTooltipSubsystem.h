@@ -4,12 +4,32 @@
 #include "Components/VerticalBox.h"
 #include "Components/Widget.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "UObject/ObjectKey.h"
 #include "ItemTooltipSubsystem.generated.h"
 
+/** Key of the cached item description */
+struct FItemDescriptionCacheKey {
+    FObjectKey ItemClass;
+    /** Owning player and state hash are only part of the key when description depends on the item stack */
+    FObjectKey OwningPlayer;
+    uint32 StateHash;
+
+    FORCEINLINE bool operator==(const FItemDescriptionCacheKey& Other) const {
+        return ItemClass == Other.ItemClass && OwningPlayer == Other.OwningPlayer && StateHash == Other.StateHash;
+    }
+
+    friend FORCEINLINE uint32 GetTypeHash(const FItemDescriptionCacheKey& Key) {
+        return HashCombine(HashCombine(GetTypeHash(Key.ItemClass), GetTypeHash(Key.OwningPlayer)), Key.StateHash);
+    }
+};
+
 UCLASS()
 class SML_API UItemTooltipSubsystem: public UGameInstanceSubsystem {
     GENERATED_BODY()
 public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
     /**
      * Register tooltip provider that will be called for all items registered
      * Please be careful with implementation as it will be called very often
@@ -34,6 +54,19 @@ public:
     FText GetItemDescription(APlayerController* OwningPlayer, const FInventoryStack& InventoryStack);
 
     TArray<UWidget*> CreateDescriptionWidgets(APlayerController* OwningPlayer, const FInventoryStack& InventoryStack);
+
+    /**
+     * Discards all cached item descriptions
+     * Call it when tooltip provider output changes because of something other than the item stack, e.g. mod configuration
+     */
+    UFUNCTION(BlueprintCallable)
+    void InvalidateDescriptionCache();
+
+    /**
+     * Computes hash of the item stack state, consisting of the item count and SaveGame properties of the item state actor
+     * Returns false if item state actor has SaveGame properties which cannot be hashed, so the state cannot be tracked
+     */
+    static bool ComputeItemStateHash(const FInventoryStack& InventoryStack, uint32& OutStateHash);
 private:
     friend class FSatisfactoryModLoader;
 
@@ -44,4 +77,19 @@ private:
     /** Array of registered tooltip providers, UPROPERTY to avoid garbage collection */
     UPROPERTY()
     TArray<UObject*> GlobalTooltipProviders;
+
+    /** True if any of the global tooltip providers depends on the item stack state */
+    bool bAnyProviderStateDependent;
+
+    /**
+     * Composed item descriptions. Description is called by the tooltip text binding every frame, so it is worth caching
+     * Descriptions depending on the item stack are keyed by the owning player and item state hash in addition to the item class
+     */
+    TMap<FItemDescriptionCacheKey, FText> DescriptionCache;
+
+    /** Upper limit of the cached descriptions, cache is discarded once it grows bigger */
+    static constexpr int32 MaxCachedDescriptions = 4096;
+
+    /** Composes item description from the vanilla description, item display interface and global providers */
+    FText ComposeItemDescription(APlayerController* OwningPlayer, const FInventoryStack& InventoryStack);
 };
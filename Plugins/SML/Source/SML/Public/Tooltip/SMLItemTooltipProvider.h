@@ -24,4 +24,13 @@ public:
 
     UFUNCTION(BlueprintNativeEvent)
     UWidget* CreateDescriptionWidget(APlayerController* OwningPlayer, const FInventoryStack& InventoryStack);
+
+    /**
+     * Return true if description returned by this provider only depends on the item class,
+     * and not on the stack contents, item state or the player, so it can be cached per item class
+     * Queried once on provider registration. If any provider returns false, descriptions are cached
+     * per owning player and hash of the item count and SaveGame properties of the item state actor
+     */
+    UFUNCTION(BlueprintNativeEvent)
+    bool IsDescriptionStateIndependent();
 };
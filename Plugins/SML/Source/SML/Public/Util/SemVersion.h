@@ -54,6 +54,8 @@ public:
     FString ToString() const;
 	/** Compares this version with other version */
 	int Compare(const FVersion& other) const;
+	/** Returns true if all version fields are exactly the same, including type and build info */
+	bool operator==(const FVersion& Other) const;
 };
 
 /** A single version comparator of version range */
@@ -83,6 +85,7 @@ public:
 	
 	FString ToString() const;
 	bool Matches(const FVersion& version) const;
+	bool operator==(const FVersionComparator& Other) const;
 };
 
 /** Represents AND-joined version comparator collection. It evaluates to true if all comparators do */
@@ -106,19 +109,61 @@ public:
 	
 	FString ToString() const;
 	bool Matches(const FVersion& version) const;
+	bool operator==(const FVersionComparatorCollection& Other) const;
+};
+
+/**
+ * Version range compiled into the sorted set of inclusive intervals over packed version keys
+ * Versions with pre-release type or numbers not fitting into the key cannot be matched this way,
+ * and are matched against the comparators instead
+ */
+struct SML_API FCompiledVersionRange {
+	/** Sorted, non-overlapping inclusive intervals of packed version keys matched by the range */
+	TArray<TPair<uint64, uint64>> Intervals;
+
+	/** Packs version numbers into the single ordered key. Returns false if version has pre-release type or numbers out of range */
+	static bool PackVersion(const FVersion& Version, uint64& OutVersionKey);
+
+	/** Compiles provided range collections, or returns NULL if they use features which cannot be represented by intervals */
+	static TSharedPtr<const FCompiledVersionRange, ESPMode::ThreadSafe> Compile(const TArray<FVersionComparatorCollection>& Collections);
+
+	/** Returns true if packed version key is inside of any of the intervals */
+	FORCEINLINE bool Matches(uint64 VersionKey) const {
+		for (const TPair<uint64, uint64>& Interval : Intervals) {
+			if (VersionKey < Interval.Key) {
+				return false;
+			}
+			if (VersionKey <= Interval.Value) {
+				return true;
+			}
+		}
+		return false;
+	}
 };
 
 /* Represents version constraints that version can be matched against */
 USTRUCT(BlueprintType)
 struct SML_API FVersionRange {
 	GENERATED_USTRUCT_BODY()
-public:
+private:
 	/* List of collections to check for. Any of them can return true for range to succeed */
-	UPROPERTY(BlueprintReadWrite)
+	UPROPERTY(BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	TArray<FVersionComparatorCollection> Collections;
-
-	FVersionRange();
 public:
+	FVersionRange();
+
+	/* Returns list of collections to check for. Any of them can return true for range to succeed */
+	FORCEINLINE const TArray<FVersionComparatorCollection>& GetCollections() const { return Collections; }
+
+	/**
+	 * Returns list of collections for modification. Compiled form of the range is dropped, so range is matched
+	 * through the comparators until UpdateCompiledRange is called after modifications are done
+	 */
+	FORCEINLINE TArray<FVersionComparatorCollection>& GetMutableCollections() {
+		CompiledRange.Reset();
+		return Collections;
+	}
+
 	/** Creates version range that matches any version */
 	static FVersionRange CreateAnyVersionRange();
 
@@ -126,7 +171,9 @@ public:
 	static FVersionRange CreateRangeWithMinVersion(const FVersion& MinVersion);
 	
 	/**
-	 * Parses SemVer version range. It supports variety of syntactic sugar, including:
+	 * Parses SemVer version range. Results are interned by the range string, so parsing the same string again is cheap
+	 * Amount of interned strings is limited, once the limit is reached new strings are parsed without being interned
+	 * It supports variety of syntactic sugar, including:
 	 *  - Ability to abandon minor/patch versions in certain cases
 	 *  - Hyphen Version Ranges (X.Y.Z - A.B.C)
 	 *  - X-Ranges comparators (1.2.X, 1.*.*, 1.3.x)
@@ -150,5 +197,14 @@ public:
 	 *  For example, output string will never contain hyphen version ranges
 	 */
 	FString ToString() const;
+
+	/** Compiles current collections, so they can be matched through the intervals. Call it after modifying collections through GetMutableCollections */
+	void UpdateCompiledRange();
+private:
+	/**
+	 * Compiled form of the collections, set up by ParseVersionRange, factory methods and UpdateCompiledRange
+	 * Collections can only be modified through GetMutableCollections, which resets it, so it never goes out of date
+	 */
+	TSharedPtr<const FCompiledVersionRange, ESPMode::ThreadSafe> CompiledRange;
 };
 
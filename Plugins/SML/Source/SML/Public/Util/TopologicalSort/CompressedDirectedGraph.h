@@ -0,0 +1,73 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Util/TopologicalSort/DirectedGraph.h"
+
+/**
+ * Compressed sparse row snapshot of the directed graph
+ * Nodes are referred to by their index in the node order of the source graph,
+ * and edges of each node are stored contiguously, so traversing it does not involve any hashing
+ */
+template<typename T>
+struct TCompressedDirectedGraph {
+	/** Nodes of the graph, in the order they were added to the source graph */
+	TArray<T> Nodes;
+	/** Index of the first edge of each node in EdgeTargets. Has an extra trailing element equal to the total amount of edges */
+	TArray<int32> EdgeOffsets;
+	/** Indices of the edge target nodes, grouped by the source node */
+	TArray<int32> EdgeTargets;
+
+	/**
+	 * Builds snapshot of the provided graph. Edges of each node keep the order of the source graph
+	 * When bInverse is true, all edges are reversed, and edges of each node are ordered by the index of their source node,
+	 * which is the same order TDirectedGraph::InverseGraph would produce
+	 */
+	static TCompressedDirectedGraph Create(const TDirectedGraph<T>& Graph, bool bInverse = false) {
+		TCompressedDirectedGraph Result;
+		Result.Nodes = Graph.GetNodes();
+		const int32 NodeCount = Result.Nodes.Num();
+
+		TMap<T, int32> NodeIndices;
+		NodeIndices.Reserve(NodeCount);
+		for (int32 NodeIndex = 0; NodeIndex < NodeCount; NodeIndex++) {
+			NodeIndices.Add(Result.Nodes[NodeIndex], NodeIndex);
+		}
+
+		//Resolve edges into index pairs first, counting edges of each node along the way
+		TArray<TPair<int32, int32>> Edges;
+		Result.EdgeOffsets.SetNumZeroed(NodeCount + 1);
+		for (int32 NodeIndex = 0; NodeIndex < NodeCount; NodeIndex++) {
+			for (const T& EdgeTarget : Graph.EdgesFrom(Result.Nodes[NodeIndex])) {
+				const int32 TargetIndex = NodeIndices.FindChecked(EdgeTarget);
+				const int32 SourceIndex = bInverse ? TargetIndex : NodeIndex;
+				Edges.Add(TPair<int32, int32>(SourceIndex, bInverse ? NodeIndex : TargetIndex));
+				Result.EdgeOffsets[SourceIndex + 1]++;
+			}
+		}
+
+		//Turn edge counts into offsets and scatter edges into their slots, which keeps their relative order
+		for (int32 NodeIndex = 0; NodeIndex < NodeCount; NodeIndex++) {
+			Result.EdgeOffsets[NodeIndex + 1] += Result.EdgeOffsets[NodeIndex];
+		}
+		TArray<int32> EdgeCursors(Result.EdgeOffsets.GetData(), NodeCount);
+		Result.EdgeTargets.SetNumUninitialized(Edges.Num());
+		for (const TPair<int32, int32>& Edge : Edges) {
+			Result.EdgeTargets[EdgeCursors[Edge.Key]++] = Edge.Value;
+		}
+		return Result;
+	}
+
+	/** Returns amount of nodes in the graph */
+	FORCEINLINE int32 Num() const {
+		return Nodes.Num();
+	}
+
+	/** Returns index of the first edge of the node */
+	FORCEINLINE int32 GetFirstEdge(int32 NodeIndex) const {
+		return EdgeOffsets[NodeIndex];
+	}
+
+	/** Returns index past the last edge of the node */
+	FORCEINLINE int32 GetEndEdge(int32 NodeIndex) const {
+		return EdgeOffsets[NodeIndex + 1];
+	}
+};
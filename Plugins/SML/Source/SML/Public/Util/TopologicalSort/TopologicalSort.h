@@ -1,6 +1,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Util/TopologicalSort/DirectedGraph.h"
+#include "Util/TopologicalSort/CompressedDirectedGraph.h"
 
 /**
  * Handles topological sorting of the directed graph
@@ -42,23 +43,152 @@ public:
 
 	/**
 	 * Performs a topological dependency sorting on a provided directed graph
+	 * Sorting is done iteratively over the compressed snapshot of the inversed graph, so it is not limited by the stack depth,
+	 * and emits nodes in exactly the same order as the recursive ExploreNode based traversal would
 	 *
 	 * @param Graph graph to perform topological sort on
 	 * @param OutSortedNodes sorted nodes of the graph will be emitted into that array
 	 * @param OutCycleNodes pointer to the array in which cycle nodes will be reported
+	 * @param OutCyclePath pointer to the array receiving the first encountered cycle, with every node having an edge to the next one and the last node having an edge to the first one
 	 * @return true if sorting was successful (e.g no cycle nodes were encountered), false otherwise
 	 */
 	template<typename T>
-	static bool TopologicalSort(const TDirectedGraph<T>& Graph, TArray<T>& OutSortedNodes, TSet<T>* OutCycleNodes = NULL) {
-		TDirectedGraph<T> ReversedGraph = Graph.InverseGraph();
-		TSet<T> VisitedNodes;
-		// A list of "fully explored" nodes. Leftovers in here indicate cycles in the graph
-		TSet<T> ExpandedNodes;
+	static bool TopologicalSort(const TDirectedGraph<T>& Graph, TArray<T>& OutSortedNodes, TSet<T>* OutCycleNodes = NULL, TArray<T>* OutCyclePath = NULL) {
+		const TCompressedDirectedGraph<T> ReversedGraph = TCompressedDirectedGraph<T>::Create(Graph, true);
+		return TopologicalSortReversed(ReversedGraph, OutSortedNodes, OutCycleNodes, OutCyclePath);
+	}
+
+	/**
+	 * Performs a topological dependency sorting on the already inversed compressed graph
+	 * Useful when the same graph snapshot is reused for other purposes, see TopologicalSort for parameter description
+	 */
+	template<typename T>
+	static bool TopologicalSortReversed(const TCompressedDirectedGraph<T>& ReversedGraph, TArray<T>& OutSortedNodes, TSet<T>* OutCycleNodes = NULL, TArray<T>* OutCyclePath = NULL) {
+		enum class ENodeState : uint8 {
+			Unvisited,
+			Visited,
+			Expanded
+		};
+		const int32 NodeCount = ReversedGraph.Num();
+		TArray<ENodeState> NodeStates;
+		NodeStates.Init(ENodeState::Unvisited, NodeCount);
+
+		//Explicit traversal stack holding node index and index of the next edge to explore
+		TArray<TPair<int32, int32>> NodeStack;
+		NodeStack.Reserve(NodeCount);
+		OutSortedNodes.Reserve(OutSortedNodes.Num() + NodeCount);
 		bool bSortingSuccess = true;
-		
-		for (const T& Node : ReversedGraph.OrderedNodes) {
-			bSortingSuccess &= ExploreNode(Node, ReversedGraph, OutSortedNodes, VisitedNodes, ExpandedNodes, OutCycleNodes);
+		bool bCyclePathFound = false;
+
+		for (int32 RootNodeIndex = 0; RootNodeIndex < NodeCount; RootNodeIndex++) {
+			if (NodeStates[RootNodeIndex] != ENodeState::Unvisited) {
+				continue;
+			}
+			NodeStates[RootNodeIndex] = ENodeState::Visited;
+			NodeStack.Add(TPair<int32, int32>(RootNodeIndex, ReversedGraph.GetFirstEdge(RootNodeIndex)));
+
+			while (NodeStack.Num()) {
+				TPair<int32, int32>& StackTop = NodeStack.Last();
+				const int32 NodeIndex = StackTop.Key;
+
+				//All inbound edges have been explored, so we can add ourselves now and mark node as expanded
+				if (StackTop.Value == ReversedGraph.GetEndEdge(NodeIndex)) {
+					OutSortedNodes.Add(ReversedGraph.Nodes[NodeIndex]);
+					NodeStates[NodeIndex] = ENodeState::Expanded;
+					NodeStack.Pop(false);
+					continue;
+				}
+				const int32 InboundNodeIndex = ReversedGraph.EdgeTargets[StackTop.Value++];
+
+				if (NodeStates[InboundNodeIndex] == ENodeState::Unvisited) {
+					NodeStates[InboundNodeIndex] = ENodeState::Visited;
+					NodeStack.Add(TPair<int32, int32>(InboundNodeIndex, ReversedGraph.GetFirstEdge(InboundNodeIndex)));
+				} else if (NodeStates[InboundNodeIndex] == ENodeState::Visited) {
+					//It's a cycle in the input graph, faulty nodes are visited but not yet expanded ones, which are exactly the nodes on the stack
+					bSortingSuccess = false;
+					if (OutCycleNodes) {
+						for (const TPair<int32, int32>& StackEntry : NodeStack) {
+							OutCycleNodes->Add(ReversedGraph.Nodes[StackEntry.Key]);
+						}
+					}
+					//Cycle itself is the part of the stack starting at the inbound node, walked backwards to follow the edges of the original graph
+					if (OutCyclePath && !bCyclePathFound) {
+						bCyclePathFound = true;
+						for (int32 StackIndex = NodeStack.Num() - 1; StackIndex >= 0; StackIndex--) {
+							const int32 CycleNodeIndex = NodeStack[StackIndex].Key;
+							OutCyclePath->Add(ReversedGraph.Nodes[CycleNodeIndex]);
+							if (CycleNodeIndex == InboundNodeIndex) {
+								break;
+							}
+						}
+					}
+				}
+			}
 		}
 		return bSortingSuccess;
 	}
+
+	/**
+	 * Splits nodes of the provided graph into dependency levels, where edge From -> To means From has to come before To
+	 * Nodes of each level only depend on the nodes from the previous levels, so nodes inside of the single level can be processed concurrently
+	 * Nodes inside of each level are ordered by their order in the graph, so result is deterministic
+	 *
+	 * @param Graph graph to split into levels
+	 * @param OutSortedNodes nodes of the graph sorted by their level will be emitted into that array
+	 * @param OutLevelOffsets index of the first node of each level in OutSortedNodes will be emitted into that array
+	 * @return true if all nodes have been assigned to levels, false if graph contains cycles. Nodes which could not be leveled are put into the last level
+	 */
+	template<typename T>
+	static bool ComputeDependencyLevels(const TDirectedGraph<T>& Graph, TArray<T>& OutSortedNodes, TArray<int32>& OutLevelOffsets) {
+		const TCompressedDirectedGraph<T> CompressedGraph = TCompressedDirectedGraph<T>::Create(Graph);
+		const int32 NodeCount = CompressedGraph.Num();
+
+		TArray<int32> InboundEdgeCounts;
+		InboundEdgeCounts.SetNumZeroed(NodeCount);
+		for (const int32 EdgeTarget : CompressedGraph.EdgeTargets) {
+			InboundEdgeCounts[EdgeTarget]++;
+		}
+
+		TArray<int32> CurrentLevel;
+		for (int32 NodeIndex = 0; NodeIndex < NodeCount; NodeIndex++) {
+			if (InboundEdgeCounts[NodeIndex] == 0) {
+				CurrentLevel.Add(NodeIndex);
+			}
+		}
+
+		OutSortedNodes.Reserve(OutSortedNodes.Num() + NodeCount);
+		TArray<int32> NextLevel;
+		int32 NodesLeveled = 0;
+
+		while (CurrentLevel.Num()) {
+			OutLevelOffsets.Add(OutSortedNodes.Num());
+			for (const int32 NodeIndex : CurrentLevel) {
+				OutSortedNodes.Add(CompressedGraph.Nodes[NodeIndex]);
+				for (int32 EdgeIndex = CompressedGraph.GetFirstEdge(NodeIndex); EdgeIndex < CompressedGraph.GetEndEdge(NodeIndex); EdgeIndex++) {
+					const int32 EdgeTarget = CompressedGraph.EdgeTargets[EdgeIndex];
+					if (--InboundEdgeCounts[EdgeTarget] == 0) {
+						NextLevel.Add(EdgeTarget);
+					}
+				}
+			}
+			NodesLeveled += CurrentLevel.Num();
+
+			//Keep nodes in the graph order regardless of the order in which they became ready
+			NextLevel.Sort();
+			Swap(CurrentLevel, NextLevel);
+			NextLevel.Reset();
+		}
+
+		if (NodesLeveled == NodeCount) {
+			return true;
+		}
+		//Nodes that still have inbound edges are either part of the cycle or depend on one, so put them into the last level
+		OutLevelOffsets.Add(OutSortedNodes.Num());
+		for (int32 NodeIndex = 0; NodeIndex < NodeCount; NodeIndex++) {
+			if (InboundEdgeCounts[NodeIndex] != 0) {
+				OutSortedNodes.Add(CompressedGraph.Nodes[NodeIndex]);
+			}
+		}
+		return false;
+	}
 };
@@ -16,29 +16,63 @@ struct FZipFileStat {
 	uint32 FileCrc32;
 };
 
+/** Describes a single entry that failed to be extracted from the zip file */
+struct FZipExtractionError {
+	/** Path of the entry inside of the zip file */
+	FString FilePath;
+
+	/** Human readable description of the error */
+	FString ErrorMessage;
+};
+
 /**
  * A Handle that manages the lifetime of the zip archive and file handle bound to it
  * Archive will be automatically closed upon destructor call, same goes for file handle
  * Primary usage is wrapping it into TSharedPtr
  */
-class FZipFile {
+class FZipFile : public TSharedFromThis<FZipFile> {
 private:
 	void* ZipArchiveHandle;
 	TUniquePtr<class IFileHandle> FileHandle;
+	/** Mapped file handle and region covering the whole archive, set when archive is read from the memory mapped file */
+	TUniquePtr<class IMappedFileHandle> MappedFileHandle;
+	TUniquePtr<class IMappedFileRegion> MappedFileRegion;
 	bool InitSuccess;
+	/** Index of the central directory built when archive is opened, maps file names to their indices */
 	TMap<FString, uint32> FileNameToIndex;
+	/** Path to the archive file on disk, used to open additional file handles for worker threads */
+	FString ArchiveFilePath;
 public:
 	explicit FZipFile(TUniquePtr<IFileHandle> Handle);
+	FZipFile(TUniquePtr<IMappedFileHandle> MappedHandle, TUniquePtr<IMappedFileRegion> MappedRegion);
 	~FZipFile();
 	bool InitArchive();
 private:
 	//Special file index indicating absence of file in ZIP
     static constexpr uint32 ZIP_NO_FILE_INDEX = (MAX_uint32 - 1);
-	uint32 ComputeFileIndex(const ANSICHAR* FileName) const;
-	uint32 LocateFileIndex(const FString& FilePath);
+	void AllocateZipArchive();
+	void BuildCentralDirectoryIndex();
+	uint32 LocateFileIndex(const FString& FilePath) const;
+	
+	/** Returns true if independent archive readers can be opened for worker threads */
+	bool CanOpenWorkerArchives() const;
+	/** Initializes independent reader for this archive into the provided zip archive struct, opening new file handle if archive is not mapped */
+	bool OpenWorkerArchive(void* OutWorkerArchive, TUniquePtr<IFileHandle>& OutWorkerFileHandle) const;
+
+	friend class FZipFileEntryReader;
 public:
 	/** Checks if file exists with given path */
-	bool FileExists(const FString& FilePath);
+	bool FileExists(const FString& FilePath) const;
+
+	/** Returns true if archive is read directly from the memory mapped file */
+	FORCEINLINE bool IsMemoryMapped() const { return MappedFileRegion.IsValid(); }
+
+	/**
+	 * Retrieves view of the contents of the stored (uncompressed) file directly in the mapped archive memory, without copying it
+	 * View is valid as long as this zip file object is alive. Fails for compressed and encrypted files,
+	 * and when archive is not memory mapped, so callers should fall back to ReadFileToBuffer in that case
+	 */
+	bool GetStoredFileView(const FString& FilePath, TArrayView<const uint8>& OutFileData) const;
 
 	/** Retrieves information about file */
 	FZipFileStat StatFile(const FString& FilePath);
@@ -50,6 +84,27 @@ public:
 	/** Reads entire file into the string */
 	bool ReadFileToString(const FString& FilePath, FString& OutString);
 
+	/**
+	 * Extracts all entries of the archive into the provided directory
+	 * Directories are created upfront in the archive order, then files are partitioned across worker threads,
+	 * each one of them using it's own archive reader and output file handles
+	 * Entries with paths escaping the output directory are not extracted and are reported as errors
+	 * Only the first one of the file entries resolving to the same output path is extracted, the rest are reported as errors
+	 *
+	 * @param OutputDirectory directory to extract archive into
+	 * @param OutErrors errors of the entries that failed to be extracted, in the archive order
+	 * @param bForceSingleThread whenever to extract all entries on the calling thread
+	 * @return true if all entries have been extracted successfully
+	 */
+	bool ExtractAll(const FString& OutputDirectory, TArray<FZipExtractionError>& OutErrors, bool bForceSingleThread = false);
+
+	/**
+	 * Creates archive streaming contents of the file, inflating it through the fixed size window instead of the whole file at once
+	 * Returned reader has it's own archive reader and keeps this zip file alive, so it can outlive it and be used on any thread
+	 * Will return null pointer if file does not exist or cannot be read
+	 */
+	TUniquePtr<FArchive> CreateFileReader(const FString& FilePath);
+
 	/** Returns last error encountered while reading this zip archive */
 	FString GetLastZipError() const;
 
@@ -59,4 +114,41 @@ public:
 	* file is missing, corrupted or cannot be opened
 	*/
 	static TSharedPtr<FZipFile> CreateZipArchiveReader(const FString& FilePath, FString& OutErrorMessage);
+};
+
+/**
+ * Archive streaming contents of a single zip file entry
+ * Entry is inflated incrementally, so memory usage does not depend on the size of the entry
+ * Seeking forward skips decompressed data, and seeking backward restarts decompression from the start of the entry
+ */
+class FZipFileEntryReader : public FArchive {
+private:
+	/** Zip file entry is read from, kept alive for the memory mapped region the archive reader can point into */
+	TSharedRef<FZipFile> ZipFile;
+	/** Archive reader owned by this entry reader, independent from the one of the zip file */
+	void* ZipArchiveHandle;
+	TUniquePtr<class IFileHandle> FileHandle;
+	bool bArchiveOpened;
+	void* ExtractIterator;
+	uint32 FileIndex;
+	int64 Position;
+	int64 EntrySize;
+	FString EntryName;
+public:
+	FZipFileEntryReader(TSharedRef<FZipFile> InZipFile, uint32 InFileIndex, int64 InEntrySize, const FString& InEntryName);
+	virtual ~FZipFileEntryReader() override;
+
+	/** Opens iterator over the entry contents. Has to be called before the reader is used */
+	bool Open();
+
+	//Begin FArchive interface
+	virtual void Serialize(void* Data, int64 Length) override;
+	virtual void Seek(int64 InPos) override;
+	virtual int64 Tell() override { return Position; }
+	virtual int64 TotalSize() override { return EntrySize; }
+	virtual bool Close() override;
+	virtual FString GetArchiveName() const override { return EntryName; }
+	//End FArchive interface
+private:
+	void ReleaseIterator();
 };
\ No newline at end of file